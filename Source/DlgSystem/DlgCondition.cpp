@@ -13,13 +13,20 @@
 
 bool FDlgCondition::EvaluateArray(const UDlgContext& Context, const TArray<FDlgCondition>& ConditionsArray, const FGameplayTag& DefaultParticipantTag)
 {
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgCondition_EvaluateArray);
+
 	bool bHasAnyWeak = false;
 	bool bHasSuccessfulWeak = false;
 
 	for (const FDlgCondition& Condition : ConditionsArray)
 	{
 		const FGameplayTag ParticipantTag = UBSDlgFunctions::IsValidParticipantTag(Condition.ParticipantTag)? Condition.ParticipantTag : DefaultParticipantTag;
-		const bool bSatisfied = Condition.IsConditionMet(Context, Context.GetParticipant(ParticipantTag));
+		bool bSatisfied = false;
+		if (!Context.GetMutableRecorder().ReplayConditionResult(bSatisfied))
+		{
+			bSatisfied = Condition.IsConditionMet(Context, Context.GetParticipant(ParticipantTag));
+			Context.GetMutableRecorder().RecordConditionResult(bSatisfied);
+		}
 		if (Condition.Strength == EDlgConditionStrength::Weak)
 		{
 			bHasAnyWeak = true;
@@ -37,6 +44,8 @@ bool FDlgCondition::EvaluateArray(const UDlgContext& Context, const TArray<FDlgC
 
 bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Participant) const
 {
+	Context.GetMutableMetrics().OnConditionEvaluated();
+
 	bool bHasParticipant = true;
 	if (IsParticipantInvolved())
 	{
@@ -48,10 +57,13 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 	{
 		if (CustomCondition == nullptr)
 		{
-			FDlgLogger::Get().Errorf(
-				TEXT("Custom Condition is empty (not valid). IsConditionMet returning false.\nContext:\n\t%s, Participant = %s"),
-				*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
-			);
+			FDlgLogger::Get().ErrorLazy(&Context, [&]()
+			{
+				return FString::Printf(
+					TEXT("Custom Condition is empty (not valid). IsConditionMet returning false.\nContext:\n\t%s, Participant = %s"),
+					*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
+				);
+			});
 			return false;
 		}
 
@@ -152,10 +164,13 @@ bool FDlgCondition::CheckFloat(const UDlgContext& Context, double Value) const
 			return !FMath::IsNearlyEqual(Value, ValueToCheckAgainst);
 
 		default:
-			FDlgLogger::Get().Errorf(
-				TEXT("Invalid Operation in float based condition.\nContext:\n\t%s"),
-				*Context.GetContextString()
-			);
+			FDlgLogger::Get().ErrorLazy(&Context, [&]()
+			{
+				return FString::Printf(
+					TEXT("Invalid Operation in float based condition.\nContext:\n\t%s"),
+					*Context.GetContextString()
+				);
+			});
 			return false;
 	}
 }
@@ -202,10 +217,13 @@ bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
 			return Value != ValueToCheckAgainst;
 
 		default:
-			FDlgLogger::Get().Errorf(
-				TEXT("Invalid Operation in int based condition.\nContext:\n\t%s"),
-				*Context.GetContextString()
-			);
+			FDlgLogger::Get().ErrorLazy(&Context, [&]()
+			{
+				return FString::Printf(
+					TEXT("Invalid Operation in int based condition.\nContext:\n\t%s"),
+					*Context.GetContextString()
+				);
+			});
 			return false;
 	}
 }
@@ -270,10 +288,15 @@ bool FDlgCondition::ValidateIsParticipantValid(const UDlgContext& Context, const
 		return true;
 	}
 
-	FDlgLogger::Get().Errorf(
-		TEXT("%s FAILED because the PARTICIPANT is INVALID.\nContext:\n\t%s, ConditionType = %s"),
-		*ContextString, *Context.GetContextString(), *ConditionTypeToString(ConditionType)
-	);
+	// Per caller and participant, the same lambda reports all of them
+	const uint32 MessageKey = HashCombine(GetTypeHash(ContextString), GetTypeHash(ParticipantTag));
+	FDlgLogger::Get().LogLazy(ENYLoggerLogLevel::Error, &Context, MessageKey, [&]()
+	{
+		return FString::Printf(
+			TEXT("%s FAILED because the PARTICIPANT is INVALID.\nContext:\n\t%s, ConditionType = %s"),
+			*ContextString, *Context.GetContextString(), *ConditionTypeToString(ConditionType)
+		);
+	});
 	return false;
 }
 
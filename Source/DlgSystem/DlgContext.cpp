@@ -4,20 +4,63 @@
 #include "Net/UnrealNetwork.h"
 #include "Engine/Texture2D.h"
 #include "Engine/Blueprint.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/StreamableManager.h"
+#include "Sound/DialogueWave.h"
+#include "Sound/SoundBase.h"
 
 #include "DlgConstants.h"
 #include "Nodes/DlgNode.h"
 #include "Nodes/DlgNode_End.h"
 #include "Nodes/DlgNode_SpeechSequence.h"
+#include "Nodes/DlgNode_Proxy.h"
+#include "Nodes/DlgNode_Selector.h"
 #include "DlgDialogueParticipant.h"
 #include "DlgMemory.h"
+#include "DlgManager.h"
+#include "DlgHelper.h"
 #include "Logging/DlgLogger.h"
+#include "DlgSystemSettings.h"
 
 
+void FDlgContextMetrics::BeginStep()
+{
+	if (StepDepth++ > 0)
+	{
+		return;
+	}
+
+	StepStartCycles = FPlatformTime::Cycles64();
+	LastStepNumConditionsEvaluated = 0;
+	LastStepNumEventsFired = 0;
+	LastStepNumNodesEntered = 0;
+	LastStepNumTextsFormatted = 0;
+}
+
+void FDlgContextMetrics::EndStep()
+{
+	if (--StepDepth > 0)
+	{
+		return;
+	}
+
+	LastStepMilliseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StepStartCycles);
+	MaxStepMilliseconds = FMath::Max(MaxStepMilliseconds, LastStepMilliseconds);
+	TotalStepMilliseconds += LastStepMilliseconds;
+	NumSteps++;
+}
+
 UDlgContext::UDlgContext(const FObjectInitializer& ObjectInitializer)
 	: UDlgObject(ObjectInitializer)
 {
 	//UObject.bReplicates = true;
+	RandomStream.GenerateNewSeed();
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
+		bTimeSliceOptionsEvaluation = Settings->bTimeSliceOptionsEvaluation;
+		bPrefetchReachableNodes = Settings->ShouldPrefetchReachableNodes();
+	}
 }
 
 void UDlgContext::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -27,6 +70,23 @@ void UDlgContext::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifet
 	DOREPLIFETIME(ThisClass, SerializedParticipants);
 }
 
+void UDlgContext::BeginDestroy()
+{
+	// The rate limited messages are keyed by the address of the context, a new context can get the same address
+	FDlgLogger::Get().ForgetRateLimits(this);
+	Super::BeginDestroy();
+}
+
+template <typename MessageFunctionType>
+void UDlgContext::LogErrorWithContextLazy(MessageFunctionType&& MakeErrorMessage) const
+{
+	// Each instantiation has its own lambda type, so the messages are keyed by the call site
+	FDlgLogger::Get().ErrorLazy(this, [this, &MakeErrorMessage]()
+	{
+		return GetErrorMessageWithContext(MakeErrorMessage());
+	});
+}
+
 void UDlgContext::SerializeParticipants()
 {
 	SerializedParticipants.Empty(Participants.Num());
@@ -50,7 +110,21 @@ void UDlgContext::OnRep_SerializedParticipants()
 
 bool UDlgContext::ChooseOption(int32 OptionIndex)
 {
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgContext_ChooseOption);
+	FDlgContextMetrics::FScopedStep Step(Metrics);
 	check(Dialogue);
+	FinishOptionsEvaluationNow();
+	if (!AvailableChildren.IsValidIndex(OptionIndex))
+	{
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("ChooseOption - INVALID given OptionIndex = %d"), OptionIndex);
+		});
+		bDialogueEnded = true;
+		return false;
+	}
+
+	Recorder.RecordChoice(OptionIndex, false);
 	if (UDlgNode* Node = GetMutableActiveNode())
 	{
 		if (Node->OptionSelected(OptionIndex, false, *this))
@@ -65,6 +139,8 @@ bool UDlgContext::ChooseOption(int32 OptionIndex)
 
 bool UDlgContext::ChooseSpeechSequenceOptionFromReplicated(int32 OptionIndex)
 {
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgContext_ChooseOption);
+	FDlgContextMetrics::FScopedStep Step(Metrics);
 	check(Dialogue);
 	if (UDlgNode_SpeechSequence* Node = GetMutableActiveNodeAsSpeechSequence())
 	{
@@ -80,13 +156,20 @@ bool UDlgContext::ChooseSpeechSequenceOptionFromReplicated(int32 OptionIndex)
 
 bool UDlgContext::ChooseOptionFromAll(int32 Index)
 {
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgContext_ChooseOption);
+	FDlgContextMetrics::FScopedStep Step(Metrics);
+	FinishOptionsEvaluationNow();
 	if (!AllChildren.IsValidIndex(Index))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("ChooseOptionFromAll - INVALID given Index = %d"), Index));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("ChooseOptionFromAll - INVALID given Index = %d"), Index);
+		});
 		bDialogueEnded = true;
 		return false;
 	}
 
+	Recorder.RecordChoice(Index, true);
 	if (UDlgNode* Node = GetMutableActiveNode())
 	{
 		if (Node->OptionSelected(Index, true, *this))
@@ -99,8 +182,149 @@ bool UDlgContext::ChooseOptionFromAll(int32 Index)
 	return false;
 }
 
+void UDlgContext::StartRecording()
+{
+	// Reseed so that the trace does not depend on how much of the stream was used before
+	const int32 Seed = RandomStream.GetCurrentSeed();
+	RandomStream.Initialize(Seed);
+	Recorder.StartRecording(Seed);
+}
+
+void UDlgContext::StartReplay(const FDlgContextTrace& Trace)
+{
+	RandomStream.Initialize(Trace.Seed);
+	Recorder.StartReplay(Trace);
+}
+
+bool UDlgContext::ReplayChoices()
+{
+	int32 OptionIndex = INDEX_NONE;
+	bool bFromAll = false;
+	while (!bDialogueEnded && Recorder.ReplayChoice(OptionIndex, bFromAll))
+	{
+		if (!(bFromAll ? ChooseOptionFromAll(OptionIndex) : ChooseOption(OptionIndex)))
+		{
+			return false;
+		}
+	}
+
+	return !bDialogueEnded;
+}
+
+bool UDlgContext::StartTimeSlicedOptionsEvaluation(const UDlgNode& Node)
+{
+	GetMutableOptionsArray().Empty();
+	GetAllMutableOptionsArray().Empty();
+	TimeSlicedNode = &Node;
+	TimeSlicedNextEdgeIndex = 0;
+	TimeSlicedOptions.Reset();
+	TimeSlicedAllOptions.Reset();
+
+	// Small nodes fit in the budget and finish right away
+	const bool bDialogueActive = EvaluateOptionsSlice(GetDefault<UDlgSystemSettings>()->OptionsEvaluationBudgetMilliseconds / 1000.0);
+	if (IsEvaluatingOptions() && !TimeSlicedTickerHandle.IsValid())
+	{
+		// Not CreateWeakLambda, the ticker executes the delegate without checking if it is still bound
+		TWeakObjectPtr<UDlgContext> WeakThis(this);
+		const FTickerDelegate TickerDelegate = FTickerDelegate::CreateLambda([WeakThis](float DeltaTime)
+		{
+			UDlgContext* Context = WeakThis.Get();
+			return Context != nullptr && Context->TickOptionsEvaluation();
+		});
+
+#if NY_ENGINE_VERSION >= 500
+		TimeSlicedTickerHandle = FTSTicker::GetCoreTicker().AddTicker(TickerDelegate);
+#else
+		TimeSlicedTickerHandle = FTicker::GetCoreTicker().AddTicker(TickerDelegate);
+#endif
+	}
+
+	return bDialogueActive;
+}
+
+void UDlgContext::FinishOptionsEvaluationNow()
+{
+	if (IsEvaluatingOptions())
+	{
+		EvaluateOptionsSlice(TNumericLimits<double>::Max());
+	}
+}
+
+bool UDlgContext::TickOptionsEvaluation()
+{
+	if (IsEvaluatingOptions())
+	{
+		EvaluateOptionsSlice(GetDefault<UDlgSystemSettings>()->OptionsEvaluationBudgetMilliseconds / 1000.0);
+	}
+
+	// Unregistered once done, the next evaluation registers again
+	if (!IsEvaluatingOptions())
+	{
+		TimeSlicedTickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool UDlgContext::EvaluateOptionsSlice(double BudgetSeconds)
+{
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgContext_ReevaluateOptions);
+	FDlgContextMetrics::FScopedStep Step(Metrics);
+	const UDlgNode* Node = TimeSlicedNode.Get();
+	if (Node == nullptr)
+	{
+		return !bDialogueEnded;
+	}
+
+	const TArray<FDlgEdge>& Children = Node->GetNodeChildren();
+	const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+	while (TimeSlicedNextEdgeIndex < Children.Num())
+	{
+		const FDlgEdge& Edge = Children[TimeSlicedNextEdgeIndex++];
+		const bool bSatisfied = Edge.Evaluate(*this, { Node });
+		if (bSatisfied || Edge.bIncludeInAllOptionListIfUnsatisfied)
+		{
+			TimeSlicedAllOptions.Add(FDlgEdgeData{ bSatisfied, Edge });
+		}
+		if (bSatisfied)
+		{
+			TimeSlicedOptions.Add(Edge);
+		}
+
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+
+	if (TimeSlicedNextEdgeIndex < Children.Num())
+	{
+		return true;
+	}
+
+	// Done
+	TimeSlicedNode.Reset();
+	GetMutableOptionsArray() = MoveTemp(TimeSlicedOptions);
+	GetAllMutableOptionsArray() = MoveTemp(TimeSlicedAllOptions);
+	const bool bDialogueActive = AvailableChildren.Num() > 0 || Node->HandleNoSatisfiedChild(*this);
+	if (!bDialogueActive)
+	{
+		bDialogueEnded = true;
+	}
+	else if (ShouldPrefetchReachableNodes() && GetActiveNode() == Node)
+	{
+		PrefetchReachableNodeAssets();
+	}
+
+	OnOptionsEvaluated.Broadcast(this, bDialogueActive);
+	return bDialogueActive;
+}
+
 bool UDlgContext::ReevaluateOptions()
 {
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgContext_ReevaluateOptions);
+	FDlgContextMetrics::FScopedStep Step(Metrics);
 	check(Dialogue);
 	UDlgNode* Node = GetMutableActiveNode();
 	if (!IsValid(Node))
@@ -117,7 +341,10 @@ const FText& UDlgContext::GetOptionText(int32 OptionIndex) const
 	check(Dialogue);
 	if (!AvailableChildren.IsValidIndex(OptionIndex))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("GetOptionText - INVALID given OptionIndex = %d"), OptionIndex));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("GetOptionText - INVALID given OptionIndex = %d"), OptionIndex);
+		});
 		return FText::GetEmpty();
 	}
 
@@ -129,7 +356,10 @@ FName UDlgContext::GetOptionSpeakerState(int32 OptionIndex) const
 	check(Dialogue);
 	if (!AvailableChildren.IsValidIndex(OptionIndex))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("GetOptionSpeakerState - INVALID given OptionIndex = %d"), OptionIndex));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("GetOptionSpeakerState - INVALID given OptionIndex = %d"), OptionIndex);
+		});
 		return NAME_None;
 	}
 
@@ -141,7 +371,10 @@ const TArray<FDlgCondition>& UDlgContext::GetOptionEnterConditions(int32 OptionI
 	check(Dialogue);
 	if (!AvailableChildren.IsValidIndex(OptionIndex))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("GetOptionEnterConditions - INVALID given OptionIndex = %d"), OptionIndex));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("GetOptionEnterConditions - INVALID given OptionIndex = %d"), OptionIndex);
+		});
 		static TArray<FDlgCondition> EmptyArray;
 		return EmptyArray;
 	}
@@ -154,7 +387,10 @@ const FDlgEdge& UDlgContext::GetOption(int32 OptionIndex) const
 	check(Dialogue);
 	if (!AvailableChildren.IsValidIndex(OptionIndex))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("GetOption - INVALID given OptionIndex = %d"), OptionIndex));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("GetOption - INVALID given OptionIndex = %d"), OptionIndex);
+		});
 		return FDlgEdge::GetInvalidEdge();
 	}
 
@@ -166,7 +402,10 @@ const FText& UDlgContext::GetOptionTextFromAll(int32 Index) const
 	check(Dialogue);
 	if (!AllChildren.IsValidIndex(Index))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("GetOptionTextFromAll - INVALID given Index = %d"), Index));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("GetOptionTextFromAll - INVALID given Index = %d"), Index);
+		});
 		return FText::GetEmpty();
 	}
 
@@ -178,7 +417,10 @@ bool UDlgContext::IsOptionSatisfied(int32 Index) const
 	check(Dialogue);
 	if (!AllChildren.IsValidIndex(Index))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("IsOptionSatisfied - INVALID given Index = %d"), Index));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("IsOptionSatisfied - INVALID given Index = %d"), Index);
+		});
 		return false;
 	}
 
@@ -190,7 +432,10 @@ FName UDlgContext::GetOptionSpeakerStateFromAll(int32 Index) const
 	check(Dialogue);
 	if (!AllChildren.IsValidIndex(Index))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("GetOptionSpeakerStateFromAll - INVALID given Index = %d"), Index));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("GetOptionSpeakerStateFromAll - INVALID given Index = %d"), Index);
+		});
 		return NAME_None;
 	}
 
@@ -202,7 +447,10 @@ const FDlgEdgeData& UDlgContext::GetOptionFromAll(int32 Index) const
 	check(Dialogue);
 	if (!AllChildren.IsValidIndex(Index))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("GetOptionFromAll - INVALID given Index = %d"), Index));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("GetOptionFromAll - INVALID given Index = %d"), Index);
+		});
 		return FDlgEdgeData::GetInvalidEdge();
 	}
 
@@ -306,10 +554,13 @@ UTexture2D* UDlgContext::GetActiveNodeParticipantIcon() const
 	auto* ObjectPtr = Participants.Find(SpeakerTag);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
-		LogErrorWithContext(FString::Printf(
-			TEXT("GetActiveNodeParticipantIcon - The ParticipantTag = `%s` from the Active Node does NOT exist in the current Participants"),
-			*SpeakerTag.ToString()
-		));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("GetActiveNodeParticipantIcon - The ParticipantTag = `%s` from the Active Node does NOT exist in the current Participants"),
+				*SpeakerTag.ToString()
+			);
+		});
 		return nullptr;
 	}
 
@@ -329,10 +580,13 @@ UObject* UDlgContext::GetActiveNodeParticipant() const
 	auto* ObjectPtr = Participants.Find(Node->GetNodeParticipantTag());
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
-		LogErrorWithContext(FString::Printf(
-			TEXT("GetActiveNodeParticipant - The ParticipantTag = `%s` from the Active Node does NOT exist in the current Participants"),
-			*SpeakerTag.ToString()
-		));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("GetActiveNodeParticipant - The ParticipantTag = `%s` from the Active Node does NOT exist in the current Participants"),
+				*SpeakerTag.ToString()
+			);
+		});
 		return nullptr;
 	}
 
@@ -364,10 +618,13 @@ FText UDlgContext::GetActiveNodeParticipantDisplayName() const
 	auto* ObjectPtr = Participants.Find(SpeakerTag);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
-		LogErrorWithContext(FString::Printf(
-			TEXT("GetActiveNodeParticipantDisplayName - The ParticipantTag = `%s` from the Active Node does NOT exist in the current Participants"),
-			*SpeakerTag.ToString()
-		));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("GetActiveNodeParticipantDisplayName - The ParticipantTag = `%s` from the Active Node does NOT exist in the current Participants"),
+				*SpeakerTag.ToString()
+			);
+		});
 		return FText::GetEmpty();
 	}
 
@@ -428,90 +685,273 @@ int32 UDlgContext::GetNodeIndexForGUID(const FGuid& NodeGUID) const
 
 bool UDlgContext::IsOptionConnectedToVisitedNode(int32 Index, bool bLocalHistory, bool bIndexSkipsUnsatisfiedEdges) const
 {
-	int32 TargetIndex = INDEX_NONE;
-
-	if (bIndexSkipsUnsatisfiedEdges)
+	const FDlgOptionCache* OptionCache = GetOptionCache(TEXT("IsOptionConnectedToVisitedNode"), Index, bIndexSkipsUnsatisfiedEdges);
+	if (OptionCache == nullptr)
 	{
-		if (!AvailableChildren.IsValidIndex(Index))
-		{
-			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToVisitedNode - INVALID Index = %d for AvailableChildren"), Index));
-			return false;
-		}
-		TargetIndex = AvailableChildren[Index].TargetIndex;
+		return false;
 	}
-	else
+	if (bLocalHistory)
 	{
-		if (!AllChildren.IsValidIndex(Index))
-		{
-			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToVisitedNode - INVALID Index = %d for AllChildren"), Index));
-			return false;
-		}
-		TargetIndex = AllChildren[Index].GetEdge().TargetIndex;
+		return OptionCache->bVisitedInThisContext;
 	}
 
-	const FGuid TargetGUID = GetNodeGUIDForIndex(TargetIndex);
-	if (!bLocalHistory && Dialogue == nullptr)
+	if (Dialogue == nullptr)
 	{
 		LogErrorWithContext(TEXT("IsOptionConnectedToVisitedNode - This Context does not have a valid Dialogue"));
 		return false;
 	}
 
-	return IsNodeVisited(TargetIndex, TargetGUID, bLocalHistory);
+	return IsNodeVisited(OptionCache->TargetIndex, OptionCache->TargetGUID, bLocalHistory);
 }
 
 bool UDlgContext::IsOptionConnectedToEndNode(int32 Index, bool bIndexSkipsUnsatisfiedEdges) const
 {
-	int32 TargetIndex = INDEX_NONE;
+	const FDlgOptionCache* OptionCache = GetOptionCache(TEXT("IsOptionConnectedToEndNode"), Index, bIndexSkipsUnsatisfiedEdges);
+	if (OptionCache == nullptr)
+	{
+		return false;
+	}
 
-	if (bIndexSkipsUnsatisfiedEdges)
+	if (Dialogue == nullptr)
 	{
-		if (!AvailableChildren.IsValidIndex(Index))
-		{
-			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToEndNode - INVALID Index = %d for AvailableChildren"), Index));
-			return false;
-		}
-		TargetIndex = AvailableChildren[Index].TargetIndex;
+		LogErrorWithContext(TEXT("IsOptionConnectedToEndNode - This Context does not have a valid Dialogue"));
+		return false;
 	}
-	else
+
+	if (OptionCache->TargetIndex == INDEX_NONE)
 	{
-		if (!AllChildren.IsValidIndex(Index))
+		LogErrorWithContextLazy([&]()
 		{
-			LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToEndNode - INVALID Index = %d for AllChildren"), Index));
-			return false;
-		}
-		TargetIndex = AllChildren[Index].GetEdge().TargetIndex;
+			return FString::Printf(TEXT("IsOptionConnectedToEndNode - The examined Edge/Option at Index = %d does not point to a valid node"), Index);
+		});
+		return false;
 	}
 
-	if (Dialogue == nullptr)
+	return OptionCache->bLeadsToEndNode;
+}
+
+const FDlgOptionCache* UDlgContext::GetOptionCache(const TCHAR* ContextMessage, int32 Index, bool bIndexSkipsUnsatisfiedEdges) const
+{
+	if (bOptionsCacheDirty)
 	{
-		LogErrorWithContext(TEXT("IsOptionConnectedToEndNode - This Context does not have a valid Dialogue"));
-		return false;
+		bOptionsCacheDirty = false;
+
+		const auto MakeOptionCache = [this](int32 TargetIndex)
+		{
+			FDlgOptionCache OptionCache;
+			OptionCache.TargetIndex = Dialogue ? Dialogue->GetResolvedNodeIndex(TargetIndex) : TargetIndex;
+			OptionCache.TargetGUID = GetNodeGUIDForIndex(OptionCache.TargetIndex);
+			OptionCache.bLeadsToEndNode = Dialogue ? Dialogue->LeadsToEndNode(TargetIndex) : false;
+			OptionCache.bVisitedInThisContext = History.Contains(OptionCache.TargetIndex, OptionCache.TargetGUID);
+			return OptionCache;
+		};
+
+		OptionsCache.Reset(AvailableChildren.Num());
+		for (const FDlgEdge& Edge : AvailableChildren)
+		{
+			OptionsCache.Add(MakeOptionCache(Edge.TargetIndex));
+		}
+		AllOptionsCache.Reset(AllChildren.Num());
+		for (const FDlgEdgeData& EdgeData : AllChildren)
+		{
+			AllOptionsCache.Add(MakeOptionCache(EdgeData.GetEdge().TargetIndex));
+		}
 	}
 
-	const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
-	if (Nodes.IsValidIndex(TargetIndex))
+	const TArray<FDlgOptionCache>& Caches = bIndexSkipsUnsatisfiedEdges ? OptionsCache : AllOptionsCache;
+	if (!Caches.IsValidIndex(Index))
 	{
-		return Nodes[TargetIndex]->IsA<UDlgNode_End>();
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("%s - INVALID Index = %d for %s"),
+				ContextMessage, Index, bIndexSkipsUnsatisfiedEdges ? TEXT("AvailableChildren") : TEXT("AllChildren")
+			);
+		});
+		return nullptr;
 	}
 
-	LogErrorWithContext(FString::Printf(TEXT("IsOptionConnectedToEndNode - The examined Edge/Option at Index = %d does not point to a valid node"), Index));
-	return false;
+	return &Caches[Index];
 }
 
 bool UDlgContext::EnterNode(int32 NodeIndex, bool bFireEnterEvents, TSet<const UDlgNode*> NodesEnteredWithThisStep)
 {
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgContext_EnterNode);
 	check(Dialogue);
 	UDlgNode* Node = GetMutableNodeFromIndex(NodeIndex);
 	if (!IsValid(Node))
 	{
-		LogErrorWithContext(FString::Printf(TEXT("EnterNode - FAILED because of INVALID NodeIndex = %d"), NodeIndex));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(TEXT("EnterNode - FAILED because of INVALID NodeIndex = %d"), NodeIndex);
+		});
 		return false;
 	}
 
+	Metrics.OnNodeEntered();
 	ActiveNodeIndex = NodeIndex;
 	SetNodeVisited(NodeIndex, Node->GetGUID());
 
-	return Node->HandleNodeEnter(*this, bFireEnterEvents, NodesEnteredWithThisStep);
+	const bool bEntered = Node->HandleNodeEnter(*this, bFireEnterEvents, NodesEnteredWithThisStep);
+
+	// Only for the node the step stopped on (not the proxies/selectors before it), with time slicing once the options are known
+	if (bEntered && ActiveNodeIndex == NodeIndex && !IsEvaluatingOptions() && ShouldPrefetchReachableNodes())
+	{
+		PrefetchReachableNodeAssets();
+	}
+
+	return bEntered;
+}
+
+void UDlgContext::GetReachableNodeIndices(int32 Depth, TArray<int32>& OutNodeIndices) const
+{
+	OutNodeIndices.Reset();
+	if (!IsValid(Dialogue))
+	{
+		return;
+	}
+
+	TSet<int32> VisitedNodeIndices{ ActiveNodeIndex };
+
+	// Breadth first so that the nearest nodes come first, the first step only through the satisfied options
+	TArray<int32> StepNodeIndices;
+	TArray<int32> NextStepNodeIndices;
+	for (const FDlgEdge& Edge : AvailableChildren)
+	{
+		StepNodeIndices.Add(Edge.TargetIndex);
+	}
+
+	for (int32 Step = 0; Step < Depth && StepNodeIndices.Num() > 0; Step++)
+	{
+		NextStepNodeIndices.Reset();
+
+		// Grows while iterating, the proxies and selectors are passed through in the same step
+		for (int32 Index = 0; Index < StepNodeIndices.Num(); Index++)
+		{
+			const int32 NodeIndex = StepNodeIndices[Index];
+			const UDlgNode* Node = GetNodeFromIndex(NodeIndex);
+			if (Node == nullptr || VisitedNodeIndices.Contains(NodeIndex))
+			{
+				continue;
+			}
+			VisitedNodeIndices.Add(NodeIndex);
+
+			if (Node->IsA<UDlgNode_Proxy>())
+			{
+				StepNodeIndices.Add(Dialogue->GetResolvedNodeIndex(NodeIndex));
+				continue;
+			}
+
+			const bool bIsSelector = Node->IsA<UDlgNode_Selector>();
+			if (!bIsSelector)
+			{
+				OutNodeIndices.Add(NodeIndex);
+			}
+
+			for (const FDlgEdge& Edge : Node->GetNodeChildren())
+			{
+				(bIsSelector ? StepNodeIndices : NextStepNodeIndices).Add(Edge.TargetIndex);
+			}
+		}
+
+		Swap(StepNodeIndices, NextStepNodeIndices);
+	}
+}
+
+void UDlgContext::PrefetchReachableNodeAssets()
+{
+	// PrimeSound starts the audio decompression and the streamable manager is not thread safe, only from the game thread
+	const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
+	if (!IsValid(Dialogue) || Settings->VoicePrefetchDepth <= 0 || !IsInGameThread())
+	{
+		return;
+	}
+
+	const bool bPrimeVoices = Settings->bPrefetchVoices;
+	const bool bLoadSoftAssets = Settings->bCookNodeAssetsAsSoftReferences;
+	int64 BudgetBytes = bPrimeVoices ? static_cast<int64>(Settings->VoicePrefetchTotalSizeCapKB) * 1024 : 0;
+	TSet<TWeakObjectPtr<USoundBase>> Prefetched;
+
+	// The active node first so that its assets stay loaded while it is active
+	TArray<FSoftObjectPath> SoftAssetPaths;
+	if (const UDlgNode* ActiveNode = GetActiveNode())
+	{
+		ActiveNode->GetNodeSoftAssetPaths(SoftAssetPaths);
+	}
+
+	TArray<int32> ReachableNodeIndices;
+	GetReachableNodeIndices(Settings->VoicePrefetchDepth, ReachableNodeIndices);
+
+	// The budget only limits the priming, the soft assets are loaded up to the depth
+	for (int32 Index = 0; Index < ReachableNodeIndices.Num() && (BudgetBytes > 0 || bLoadSoftAssets); Index++)
+	{
+		const UDlgNode* Node = GetNodeFromIndex(ReachableNodeIndices[Index]);
+
+		// The getters would load the soft assets synchronously, those are primed by a later pass once loaded
+		const int32 NumPathsBefore = SoftAssetPaths.Num();
+		Node->GetNodeSoftAssetPaths(SoftAssetPaths);
+		bool bSoftAssetsLoaded = true;
+		for (int32 PathIndex = NumPathsBefore; PathIndex < SoftAssetPaths.Num() && bSoftAssetsLoaded; PathIndex++)
+		{
+			bSoftAssetsLoaded = SoftAssetPaths[PathIndex].ResolveObject() != nullptr;
+		}
+
+		if (bPrimeVoices && bSoftAssetsLoaded && BudgetBytes > 0)
+		{
+			PrefetchVoice(Node->GetNodeVoiceSoundBase(), BudgetBytes, Prefetched);
+
+			// Only the first wave of the dialogue wave is used
+			const UDialogueWave* DialogueWave = Node->GetNodeVoiceDialogueWave();
+			if (DialogueWave != nullptr && DialogueWave->ContextMappings.Num() > 0)
+			{
+				PrefetchVoice(DialogueWave->ContextMappings[0].SoundWave, BudgetBytes, Prefetched);
+			}
+		}
+	}
+
+	PrefetchedVoices = MoveTemp(Prefetched);
+
+	// Requested before the previous handle is released so the assets still reachable are not unloaded in between
+	TSharedPtr<FStreamableHandle> PreviousHandle = MoveTemp(NodeAssetsHandle);
+	if (SoftAssetPaths.Num() > 0)
+	{
+		NodeAssetsHandle = FDlgHelper::GetStreamableManager().RequestAsyncLoad(
+			MoveTemp(SoftAssetPaths),
+			FStreamableDelegate(),
+			FStreamableManager::AsyncLoadHighPriority
+		);
+	}
+	if (PreviousHandle.IsValid())
+	{
+		PreviousHandle->ReleaseHandle();
+	}
+}
+
+void UDlgContext::PrefetchVoice(USoundBase* Sound, int64& InOutBudgetBytes, TSet<TWeakObjectPtr<USoundBase>>& OutPrefetched)
+{
+	if (Sound == nullptr || OutPrefetched.Contains(Sound))
+	{
+		return;
+	}
+
+	const int64 SizeBytes = static_cast<int64>(Sound->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal));
+	if (SizeBytes > InOutBudgetBytes)
+	{
+		return;
+	}
+
+	InOutBudgetBytes -= SizeBytes;
+	OutPrefetched.Add(Sound);
+
+	// Still counted against the budget, the cap is about the voices and not about their memory
+	if (PrefetchedVoices.Contains(Sound))
+	{
+		return;
+	}
+
+#if NY_ENGINE_VERSION >= 425
+	UGameplayStatics::PrimeSound(Sound);
+#endif
 }
 
 UDlgContext* UDlgContext::CreateCopy() const
@@ -546,6 +986,7 @@ void UDlgContext::SetNodeVisited(int32 NodeIndex, const FGuid& NodeGUID)
 {
 	FDlgMemory::Get().SetNodeVisited(Dialogue->GetGUID(), NodeIndex, NodeGUID);
 	History.Add(NodeIndex, NodeGUID);
+	bOptionsCacheDirty = true;
 }
 
 bool UDlgContext::IsNodeVisited(int32 NodeIndex, const FGuid& NodeGUID, bool bLocalHistory) const
@@ -674,6 +1115,8 @@ bool UDlgContext::CanBeStarted(UDlgDialogue* InDialogue, const TMap<FGameplayTag
 
 bool UDlgContext::StartWithContext(const FString& ContextString, UDlgDialogue* InDialogue, const TMap<FGameplayTag, UObject*>& InParticipants)
 {
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgContext_Start);
+	FDlgContextMetrics::FScopedStep Step(Metrics);
 	const FString ContextMessage = ContextString.IsEmpty()
 		? TEXT("Start")
 		: FString::Printf(TEXT("%s - Start"), *ContextString);
@@ -684,6 +1127,7 @@ bool UDlgContext::StartWithContext(const FString& ContextString, UDlgDialogue* I
 	{
 		return false;
 	}
+	NotifyParticipantsChanged();
 
 	// Evaluate edges/children of the start node
 
@@ -701,10 +1145,13 @@ bool UDlgContext::StartWithContext(const FString& ContextString, UDlgDialogue* I
 		}
 	}
 
-	LogErrorWithContext(FString::Printf(
-		TEXT("%s - FAILED because all possible start node condition failed. Edge conditions and children enter conditions from the start nodes are not satisfied"),
-		*ContextMessage
-	));
+	LogErrorWithContextLazy([&]()
+	{
+		return FString::Printf(
+			TEXT("%s - FAILED because all possible start node condition failed. Edge conditions and children enter conditions from the start nodes are not satisfied"),
+			*ContextMessage
+		);
+	});
 	return false;
 }
 
@@ -719,6 +1166,8 @@ bool UDlgContext::StartWithContextFromNode(
 	bool bFireEnterEvents
 )
 {
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgContext_Start);
+	FDlgContextMetrics::FScopedStep Step(Metrics);
 	const FString ContextMessage = ContextString.IsEmpty()
 		? TEXT("StartFromNode")
 		: FString::Printf(TEXT("%s - StartFromNode"), *ContextString);
@@ -726,10 +1175,12 @@ bool UDlgContext::StartWithContextFromNode(
 	Dialogue = InDialogue;
 	SetParticipants(InParticipants);
 	History = StartHistory;
+	bOptionsCacheDirty = true;
 	if (!ValidateParticipantsMapForDialogue(ContextMessage, Dialogue, Participants))
 	{
 		return false;
 	}
+	NotifyParticipantsChanged();
 
 	// Get the StartNodeIndex from the GUID
 	if (StartNodeGUID.IsValid())
@@ -740,10 +1191,13 @@ bool UDlgContext::StartWithContextFromNode(
 	UDlgNode* Node = GetMutableNodeFromIndex(StartNodeIndex);
 	if (!IsValid(Node))
 	{
-		LogErrorWithContext(FString::Printf(
-			TEXT("%s - FAILED because StartNodeIndex = %d  is INVALID. For StartNodeGUID = %s"),
-			*ContextMessage, StartNodeIndex, *StartNodeGUID.ToString()
-		));
+		LogErrorWithContextLazy([&]()
+		{
+			return FString::Printf(
+				TEXT("%s - FAILED because StartNodeIndex = %d  is INVALID. For StartNodeGUID = %s"),
+				*ContextMessage, StartNodeIndex, *StartNodeGUID.ToString()
+			);
+		});
 		return false;
 	}
 
@@ -758,10 +1212,23 @@ bool UDlgContext::StartWithContextFromNode(
 	return Node->ReevaluateChildren(*this, {});
 }
 
+SIZE_T UDlgContext::GetAllocatedSize() const
+{
+	return AvailableChildren.GetAllocatedSize()
+		+ AllChildren.GetAllocatedSize()
+		+ History.VisitedNodeIndices.GetAllocatedSize()
+		+ History.VisitedNodeGUIDs.GetAllocatedSize()
+		+ Participants.GetAllocatedSize()
+		+ SerializedParticipants.GetAllocatedSize()
+		+ OptionsCache.GetAllocatedSize()
+		+ AllOptionsCache.GetAllocatedSize();
+}
+
 FString UDlgContext::GetContextString() const
 {
-	FString ContextParticipants;
-	TSet<FString> ParticipantsNames;
+	// The map keys are already unique
+	TArray<FString> ParticipantsNames;
+	ParticipantsNames.Reserve(Participants.Num());
 	for (const auto& KeyValue : Participants)
 	{
 		ParticipantsNames.Add(KeyValue.Key.ToString());
@@ -775,9 +1242,27 @@ FString UDlgContext::GetContextString() const
 	);
 }
 
-void UDlgContext::LogErrorWithContext(const FString& ErrorMessage) const
+void UDlgContext::NotifyParticipantsChanged() const
+{
+	// The simulations run contexts on worker threads, the listeners are game thread only
+	if (!IsInGameThread() || !UDlgManager::OnParticipantChanged().IsBound())
+	{
+		return;
+	}
+
+	for (const auto& KeyValue : Participants)
+	{
+		UDlgManager::NotifyParticipantChanged(KeyValue.Value);
+	}
+}
+
+void UDlgContext::LogErrorWithContext(const TCHAR* ErrorMessage) const
 {
-	FDlgLogger::Get().Error(GetErrorMessageWithContext(ErrorMessage));
+	// Keyed by the message as all the callers share this lambda, the literals do not move
+	FDlgLogger::Get().LogLazy(ENYLoggerLogLevel::Error, this, PointerHash(ErrorMessage), [this, ErrorMessage]()
+	{
+		return GetErrorMessageWithContext(ErrorMessage);
+	});
 }
 
 FString UDlgContext::GetErrorMessageWithContext(const FString& ErrorMessage) const
@@ -7,6 +7,10 @@
 #include "DlgMemory.h"
 #include "DlgParticipantTag.h"
 #include "GameplayTagContainer.h"
+#include "DlgStats.h"
+#include "DlgContextTrace.h"
+#include "Math/RandomStream.h"
+#include "Containers/Ticker.h"
 
 #include "DlgContext.generated.h"
 
@@ -17,6 +21,7 @@ class UTexture2D;
 class UDlgNodeData;
 class UDlgNode;
 class UDlgNode_SpeechSequence;
+struct FStreamableHandle;
 
 // Used to store temporary state of edges
 // This represents a const version of an Edge
@@ -68,6 +73,91 @@ enum class EDlgValidateStatus : uint8
 	// DialogueDoesNotContainParticipant
 };
 
+// Cheap runtime counters of a context, shown by the Dialogue gameplay debugger category
+struct DLGSYSTEM_API FDlgContextMetrics
+{
+public:
+	// Measures one step, nested steps (e.g. a start that enters a node) are part of the outermost one
+	struct FScopedStep
+	{
+		FScopedStep(FDlgContextMetrics& InMetrics) : Metrics(InMetrics) { Metrics.BeginStep(); }
+		~FScopedStep() { Metrics.EndStep(); }
+
+	private:
+		FDlgContextMetrics& Metrics;
+	};
+
+	double GetAverageStepMilliseconds() const { return NumSteps > 0 ? TotalStepMilliseconds / NumSteps : 0.0; }
+
+	void OnConditionEvaluated()
+	{
+		NumConditionsEvaluated++;
+		LastStepNumConditionsEvaluated++;
+		DLG_INC_COUNTER(STAT_DlgConditionsEvaluated);
+	}
+	void OnEventFired()
+	{
+		NumEventsFired++;
+		LastStepNumEventsFired++;
+		DLG_INC_COUNTER(STAT_DlgEventsFired);
+	}
+	void OnNodeEntered()
+	{
+		NumNodesEntered++;
+		LastStepNumNodesEntered++;
+		DLG_INC_COUNTER(STAT_DlgNodesEntered);
+	}
+	void OnTextFormatted()
+	{
+		NumTextsFormatted++;
+		LastStepNumTextsFormatted++;
+		DLG_INC_COUNTER(STAT_DlgTextsFormatted);
+	}
+
+private:
+	void BeginStep();
+	void EndStep();
+
+public:
+	// A step is a call that advances or reevaluates the dialogue: Start*, ChooseOption*, ReevaluateOptions
+	int32 NumSteps = 0;
+	double LastStepMilliseconds = 0.0;
+	double MaxStepMilliseconds = 0.0;
+	double TotalStepMilliseconds = 0.0;
+
+	// Over the lifetime of the context
+	int32 NumConditionsEvaluated = 0;
+	int32 NumEventsFired = 0;
+	int32 NumNodesEntered = 0;
+	int32 NumTextsFormatted = 0;
+
+	// Since the start of the last step
+	int32 LastStepNumConditionsEvaluated = 0;
+	int32 LastStepNumEventsFired = 0;
+	int32 LastStepNumNodesEntered = 0;
+	int32 LastStepNumTextsFormatted = 0;
+
+private:
+	int32 StepDepth = 0;
+	uint64 StepStartCycles = 0;
+};
+
+// What the option styling queries (IsOptionConnectedToEndNode, IsOptionConnectedToVisitedNode) need to know about one option
+struct FDlgOptionCache
+{
+	// The node the option enters, the proxies are followed
+	int32 TargetIndex = INDEX_NONE;
+	FGuid TargetGUID;
+
+	bool bLeadsToEndNode = false;
+	bool bVisitedInThisContext = false;
+};
+
+class UDlgContext;
+
+// Time sliced option evaluation finished, bDialogueActive is false if the dialogue ended because no option was satisfied
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FDlgOnOptionsEvaluated, UDlgContext*, Context, bool, bDialogueActive);
+
 /**
  *  Class representing an active dialogue, can be used to gain information and to control it
  *  Should be controlled from Player Character/Player controller
@@ -95,6 +185,8 @@ public:
 	bool IsSupportedForNetworking() const override { return true; };
 	void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	void BeginDestroy() override;
+
 	//
 	// Own methods
 	//
@@ -181,7 +273,11 @@ public:
 	// Gets all satisfied edges
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|Satisfied")
 	const TArray<FDlgEdge>& GetOptionsArray() const { return AvailableChildren; }
-	TArray<FDlgEdge>& GetMutableOptionsArray() { return AvailableChildren; }
+	TArray<FDlgEdge>& GetMutableOptionsArray()
+	{
+		bOptionsCacheDirty = true;
+		return AvailableChildren;
+	}
 
 	//
 	//  Use these functions bellow if you don't care about unsatisfied player options:
@@ -215,12 +311,17 @@ public:
 	// Gets all edges (both satisfied and unsatisfied)
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Options|All")
 	const TArray<FDlgEdgeData>& GetAllOptionsArray() const { return AllChildren; }
-	TArray<FDlgEdgeData>& GetAllMutableOptionsArray() { return AllChildren; }
+	TArray<FDlgEdgeData>& GetAllMutableOptionsArray()
+	{
+		bOptionsCacheDirty = true;
+		return AllChildren;
+	}
 
 	/**
 	*  Checks if the node connected directly to one of the active player choices was already visited or not
-	*  Does not handle complicated logic - if the said node is a logical one it will still check that node, and not one
-	*  of its options
+	*  Proxies are followed to their target, otherwise does not handle complicated logic - if the said node is a logical one
+	*  it will still check that node, and not one of its options
+	*  Constant time, the targets are resolved once per step (see FDlgOptionCache)
 	*
 	* @param Index  Index of the edge/player option to test
 	* @param bLocalHistory If true, only the history of this dialogue context is checked. If false, it is a global check
@@ -232,8 +333,9 @@ public:
 
 	/**
 	*  Checks if the node is connected directly to an end node or not
-	*  Does not handle complicated logic - if the said node is a logical one it will still check that node, and not one
-	*  of its option
+	*  Proxies are followed to their target, otherwise does not handle complicated logic - if the said node is a logical one
+	*  it will still check that node, and not one of its option
+	*  Constant time, precomputed by the dialogue (see UDlgDialogue::LeadsToEndNode)
 	*
 	* @param Index  Index of the edge/player option to test
 	* @param bIndexSkipsUnsatisfiedEdges  Decides if the index is in the [0, GetOptionsNum()[ interval (if true), or in the [0, GetAllOptionsNum()[ (if false)
@@ -344,6 +446,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Context|History")
 	const TSet<FGuid>& GetVisitedNodeGUIDs() const { return History.VisitedNodeGUIDs; }
 
+	// Forgets the nodes visited inside this context, so that it can be started again as if it was new. DlgMemory is not touched
+	void ClearHistoryOfThisContext()
+	{
+		History = {};
+		bOptionsCacheDirty = true;
+	}
+
 	// Helper methods to get some Dialogue properties
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	UDlgDialogue* GetDialogue() const { return Dialogue; }
@@ -584,9 +693,105 @@ public:
 		bool bLog = true
 	);
 
+	// Runtime counters of this context, the conditions are evaluated on a const context so the mutable version is const too
+	const FDlgContextMetrics& GetMetrics() const { return Metrics; }
+	FDlgContextMetrics& GetMutableMetrics() const { return Metrics; }
+
+	// Bytes allocated by the containers of this context (options, options caches, history, participants)
+	SIZE_T GetAllocatedSize() const;
+
+	// Seeds the random stream used by the random selector nodes, call it before Start* to get the same random selections
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Context|Random")
+	void SetRandomSeed(int32 Seed) { RandomStream.Initialize(Seed); }
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Context|Random")
+	int32 GetRandomSeed() const { return RandomStream.GetInitialSeed(); }
+
+	FRandomStream& GetRandomStream() { return RandomStream; }
+
+	// Records every option choice, random selection and condition result of this context from now on, call it before Start*
+	void StartRecording();
+	void StopRecording() { Recorder.Stop(); }
+	const FDlgContextTrace& GetRecordedTrace() const { return Recorder.GetTrace(); }
+
+	// Replays a recorded trace: reseeds the random stream and the conditions return the recorded results instead of asking the participants.
+	// Call it before the same Start* as when recording, then ReplayChoices
+	void StartReplay(const FDlgContextTrace& Trace);
+
+	// Chooses the recorded options until the trace or the dialogue ends
+	// @return false if the dialogue ended
+	bool ReplayChoices();
+
+	// The conditions are evaluated on a const context so the mutable version is const too
+	FDlgContextRecorder& GetMutableRecorder() const { return Recorder; }
+
+	// Overrides UDlgSystemSettings::bTimeSliceOptionsEvaluation for this context
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Control")
+	void SetTimeSliceOptionsEvaluation(bool bInTimeSliceOptionsEvaluation) { bTimeSliceOptionsEvaluation = bInTimeSliceOptionsEvaluation; }
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Control")
+	bool ShouldTimeSliceOptionsEvaluation() const { return bTimeSliceOptionsEvaluation; }
+
+	// True while the options of the active node are evaluated over the next frames, the options are empty meanwhile
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Control")
+	bool IsEvaluatingOptions() const { return TimeSlicedNode.IsValid(); }
+
+	// Called by UDlgNode::ReevaluateChildren with time slicing, evaluates what fits in the budget now and the rest on the next frames
+	// @return false if the dialogue ended (everything was evaluated now and no option is satisfied)
+	bool StartTimeSlicedOptionsEvaluation(const UDlgNode& Node);
+
+	// Evaluates the remaining options now, called before an option is chosen
+	void FinishOptionsEvaluationNow();
+
+	// Overrides UDlgSystemSettings::ShouldPrefetchReachableNodes for this context, turn it off for the contexts that are not played
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|ActiveNode")
+	void SetPrefetchReachableNodes(bool bInPrefetchReachableNodes) { bPrefetchReachableNodes = bInPrefetchReachableNodes; }
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|ActiveNode")
+	bool ShouldPrefetchReachableNodes() const { return bPrefetchReachableNodes; }
+
+	// Primes the voices of the nodes reachable from the active node (UDlgSystemSettings::bPrefetchVoices)
+	// and starts loading their soft referenced assets (UDlgSystemSettings::bCookNodeAssetsAsSoftReferences).
+	// Called when a node is entered (and its options are evaluated) if ShouldPrefetchReachableNodes.
+	// Does nothing outside of the game thread.
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|ActiveNode")
+	void PrefetchReachableNodeAssets();
+
+	// The nodes PrefetchReachableNodeAssets goes through: reachable from the active node in at most Depth steps, nearest first.
+	// The first step only goes through the satisfied options, the deeper ones through all the edges.
+	// The proxies and selectors are passed through in the same step and are not in the result.
+	void GetReachableNodeIndices(int32 Depth, TArray<int32>& OutNodeIndices) const;
+
+	// Broadcast when a time sliced evaluation of the options finished, also if it finished right away
+	UPROPERTY(BlueprintAssignable, Category = "Dialogue|Control")
+	FDlgOnOptionsEvaluated OnOptionsEvaluated;
+
 protected:
 	// bool StartInternal(UDlgDialogue* InDialogue, const TMap<FGameplayTag, UObject*>& InParticipants, bool bLog, FString& OutErrorMessage);
-	void LogErrorWithContext(const FString& ErrorMessage) const;
+	// See UDlgManager::NotifyParticipantChanged
+	void NotifyParticipantsChanged() const;
+
+	// For the constant messages, rate limited by the message
+	void LogErrorWithContext(const TCHAR* ErrorMessage) const;
+
+	// MakeErrorMessage is only called if the error is logged, rate limited by the call site (see INYLogger::LogLazy).
+	// Defined in DlgContext.cpp, the only place it is used
+	template <typename MessageFunctionType>
+	void LogErrorWithContextLazy(MessageFunctionType&& MakeErrorMessage) const;
+
+	// Primes the Sound unless it was already primed by this pass or the last one, if its full estimated size fits in InOutBudgetBytes
+	// (see UDlgSystemSettings::VoicePrefetchTotalSizeCapKB)
+	void PrefetchVoice(USoundBase* Sound, int64& InOutBudgetBytes, TSet<TWeakObjectPtr<USoundBase>>& OutPrefetched);
+
+	// Evaluates options of TimeSlicedNode until the budget is spent (at least one), finishes the evaluation if none is left
+	// @return false if the dialogue ended
+	bool EvaluateOptionsSlice(double BudgetSeconds);
+
+	// Called by the core ticker while evaluating, returns false to unregister
+	bool TickOptionsEvaluation();
+
+	// The cache of the option at Index, rebuilds the caches if they are dirty. Logs and returns nullptr if the Index is invalid
+	const FDlgOptionCache* GetOptionCache(const TCHAR* ContextMessage, int32 Index, bool bIndexSkipsUnsatisfiedEdges) const;
 	FString GetErrorMessageWithContext(const FString& ErrorMessage) const;
 
 	void SetParticipants(const TMap<FGameplayTag, UObject*>& InParticipants)
@@ -628,4 +833,42 @@ protected:
 
 	// cache the result of the last ChooseOption call
 	bool bDialogueEnded = false;
+
+	// FDlgOptionCache of AvailableChildren and AllChildren, rebuilt by the first query after the options or the History change
+	mutable TArray<FDlgOptionCache> OptionsCache;
+	mutable TArray<FDlgOptionCache> AllOptionsCache;
+	mutable bool bOptionsCacheDirty = true;
+
+	// Not serialized or replicated, only valid where the dialogue runs
+	mutable FDlgContextMetrics Metrics;
+
+	// Used by the random selector nodes, seeded randomly unless SetRandomSeed is called
+	FRandomStream RandomStream;
+
+	// Not serialized or replicated
+	mutable FDlgContextRecorder Recorder;
+
+	// See UDlgSystemSettings::bTimeSliceOptionsEvaluation
+	bool bTimeSliceOptionsEvaluation = false;
+
+	// See UDlgSystemSettings::ShouldPrefetchReachableNodes
+	bool bPrefetchReachableNodes = false;
+
+	// The node whose options are evaluated over the next frames, the next edge to evaluate and the results so far
+	TWeakObjectPtr<const UDlgNode> TimeSlicedNode;
+	int32 TimeSlicedNextEdgeIndex = 0;
+	TArray<FDlgEdge> TimeSlicedOptions;
+	TArray<FDlgEdgeData> TimeSlicedAllOptions;
+
+	// Voices primed by the last PrefetchReachableNodeAssets, not primed again while they stay reachable
+	TSet<TWeakObjectPtr<USoundBase>> PrefetchedVoices;
+
+	// Keeps the soft referenced assets of the active node and of the reachable nodes loaded, replaced by each PrefetchReachableNodeAssets
+	TSharedPtr<FStreamableHandle> NodeAssetsHandle;
+
+#if NY_ENGINE_VERSION >= 500
+	FTSTicker::FDelegateHandle TimeSlicedTickerHandle;
+#else
+	FDelegateHandle TimeSlicedTickerHandle;
+#endif
 };
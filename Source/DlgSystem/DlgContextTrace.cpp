@@ -0,0 +1,279 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgContextTrace.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "Logging/DlgLogger.h"
+
+void FDlgContextTrace::Empty()
+{
+	Seed = 0;
+	Choices.Empty();
+	Selections.Empty();
+	ConditionResults.Empty();
+}
+
+namespace DlgContextTrace
+{
+	// Guards the allocations against corrupt counts, at most ElementsPerByte elements fit in each byte
+	static bool ReadNum(FArchive& Ar, uint32& OutNum, int64 ElementsPerByte = 1)
+	{
+		Ar.SerializeIntPacked(OutNum);
+		if (Ar.IsError() || FMath::DivideAndRoundUp(static_cast<int64>(OutNum), ElementsPerByte) > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return false;
+		}
+
+		return true;
+	}
+}
+
+void FDlgContextTrace::Save(FArchive& Ar) const
+{
+	check(Ar.IsSaving());
+	uint8 Version = FormatVersion;
+	Ar << Version;
+
+	int32 SavedSeed = Seed;
+	Ar << SavedSeed;
+
+	uint32 NumChoices = Choices.Num();
+	Ar.SerializeIntPacked(NumChoices);
+	for (uint32 Choice : Choices)
+	{
+		Ar.SerializeIntPacked(Choice);
+	}
+
+	uint32 NumSelections = Selections.Num();
+	Ar.SerializeIntPacked(NumSelections);
+	for (const int32 Selection : Selections)
+	{
+		uint32 PackedSelection = static_cast<uint32>(Selection);
+		Ar.SerializeIntPacked(PackedSelection);
+	}
+
+	// One bit each, eight to a byte
+	uint32 NumConditionResults = ConditionResults.Num();
+	Ar.SerializeIntPacked(NumConditionResults);
+	for (int32 ByteStart = 0; ByteStart < ConditionResults.Num(); ByteStart += 8)
+	{
+		uint8 Byte = 0;
+		for (int32 Bit = 0; Bit < 8 && ByteStart + Bit < ConditionResults.Num(); Bit++)
+		{
+			Byte |= ConditionResults[ByteStart + Bit] ? 1 << Bit : 0;
+		}
+		Ar << Byte;
+	}
+}
+
+bool FDlgContextTrace::Load(FArchive& Ar)
+{
+	check(Ar.IsLoading());
+	Empty();
+
+	uint8 Version = 0;
+	Ar << Version;
+	if (Version != FormatVersion)
+	{
+		Ar.SetError();
+		return false;
+	}
+
+	Ar << Seed;
+
+	uint32 NumChoices = 0;
+	if (!DlgContextTrace::ReadNum(Ar, NumChoices))
+	{
+		return false;
+	}
+	Choices.SetNumUninitialized(NumChoices);
+	for (uint32& Choice : Choices)
+	{
+		Ar.SerializeIntPacked(Choice);
+	}
+
+	uint32 NumSelections = 0;
+	if (!DlgContextTrace::ReadNum(Ar, NumSelections))
+	{
+		return false;
+	}
+	Selections.SetNumUninitialized(NumSelections);
+	for (int32& Selection : Selections)
+	{
+		uint32 PackedSelection = 0;
+		Ar.SerializeIntPacked(PackedSelection);
+		Selection = static_cast<int32>(PackedSelection);
+	}
+
+	uint32 NumConditionResults = 0;
+	if (!DlgContextTrace::ReadNum(Ar, NumConditionResults, 8))
+	{
+		return false;
+	}
+	ConditionResults.Init(false, NumConditionResults);
+	for (uint32 ByteStart = 0; ByteStart < NumConditionResults; ByteStart += 8)
+	{
+		uint8 Byte = 0;
+		Ar << Byte;
+		for (uint32 Bit = 0; Bit < 8 && ByteStart + Bit < NumConditionResults; Bit++)
+		{
+			ConditionResults[ByteStart + Bit] = (Byte & (1 << Bit)) != 0;
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+TArray<uint8> FDlgContextTrace::ToBytes() const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Save(Writer);
+	return Bytes;
+}
+
+bool FDlgContextTrace::FromBytes(const TArray<uint8>& Bytes)
+{
+	FMemoryReader Reader(Bytes);
+	if (!Load(Reader))
+	{
+		Empty();
+		return false;
+	}
+
+	return true;
+}
+
+bool FDlgContextTrace::SaveToFile(const FString& FilePath) const
+{
+	return FFileHelper::SaveArrayToFile(ToBytes(), *FilePath);
+}
+
+bool FDlgContextTrace::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		FDlgLogger::Get().Errorf(TEXT("Can't read the dialogue trace file = `%s`"), *FilePath);
+		return false;
+	}
+
+	if (!FromBytes(Bytes))
+	{
+		FDlgLogger::Get().Errorf(TEXT("The dialogue trace file = `%s` is corrupt or has a different format version"), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
+void FDlgContextRecorder::StartRecording(int32 Seed)
+{
+	Mode = EDlgContextTraceMode::Record;
+	Trace.Empty();
+	Trace.Seed = Seed;
+}
+
+void FDlgContextRecorder::StartReplay(const FDlgContextTrace& InTrace)
+{
+	Mode = EDlgContextTraceMode::Replay;
+	Trace = InTrace;
+	NextChoice = 0;
+	NextSelection = 0;
+	NextConditionResult = 0;
+}
+
+void FDlgContextRecorder::Stop()
+{
+	Mode = EDlgContextTraceMode::None;
+}
+
+void FDlgContextRecorder::RecordChoice(int32 OptionIndex, bool bFromAll)
+{
+	if (IsRecording())
+	{
+		Trace.Choices.Add(FDlgContextTrace::EncodeChoice(OptionIndex, bFromAll));
+	}
+}
+
+void FDlgContextRecorder::RecordSelection(int32 EdgeIndex)
+{
+	if (IsRecording())
+	{
+		Trace.Selections.Add(EdgeIndex);
+	}
+}
+
+void FDlgContextRecorder::RecordConditionResult(bool bSatisfied)
+{
+	if (IsRecording())
+	{
+		Trace.ConditionResults.Add(bSatisfied);
+	}
+}
+
+bool FDlgContextRecorder::ReplayChoice(int32& OutOptionIndex, bool& bOutFromAll)
+{
+	if (!IsReplaying())
+	{
+		return false;
+	}
+
+	// All the recorded choices were made, nothing left to reproduce
+	if (!Trace.Choices.IsValidIndex(NextChoice))
+	{
+		Stop();
+		return false;
+	}
+
+	const uint32 Choice = Trace.Choices[NextChoice++];
+	OutOptionIndex = static_cast<int32>(Choice >> 1);
+	bOutFromAll = (Choice & 1u) != 0;
+	return true;
+}
+
+bool FDlgContextRecorder::ReplaySelection(int32& OutEdgeIndex)
+{
+	if (!IsReplaying())
+	{
+		return false;
+	}
+
+	if (!Trace.Selections.IsValidIndex(NextSelection))
+	{
+		OnReplayExhausted(TEXT("selections"));
+		return false;
+	}
+
+	OutEdgeIndex = Trace.Selections[NextSelection++];
+	return true;
+}
+
+bool FDlgContextRecorder::ReplayConditionResult(bool& bOutSatisfied)
+{
+	if (!IsReplaying())
+	{
+		return false;
+	}
+
+	if (!Trace.ConditionResults.IsValidIndex(NextConditionResult))
+	{
+		OnReplayExhausted(TEXT("condition results"));
+		return false;
+	}
+
+	bOutSatisfied = Trace.ConditionResults[NextConditionResult++];
+	return true;
+}
+
+void FDlgContextRecorder::OnReplayExhausted(const TCHAR* What)
+{
+	FDlgLogger::Get().Warningf(
+		TEXT("Dialogue trace replay ran out of recorded %s (the context was queried differently than when recording), continuing without the trace"),
+		What
+	);
+	Stop();
+}
@@ -0,0 +1,85 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Everything a UDlgContext decided, in order, so that the same traversal can be reproduced for bug repros and benchmarks
+struct DLGSYSTEM_API FDlgContextTrace
+{
+public:
+	// Increase if the binary format changes, old traces are rejected
+	static constexpr uint8 FormatVersion = 2;
+
+	bool IsEmpty() const { return Choices.Num() == 0 && Selections.Num() == 0 && ConditionResults.Num() == 0; }
+	void Empty();
+
+	// Compact binary format: the indices are packed and the condition results take one bit each
+	void Save(FArchive& Ar) const;
+
+	// Fails (and sets the archive error) on a different version or on counts that do not fit in the rest of the archive
+	bool Load(FArchive& Ar);
+	TArray<uint8> ToBytes() const;
+	bool FromBytes(const TArray<uint8>& Bytes);
+
+	bool SaveToFile(const FString& FilePath) const;
+	bool LoadFromFile(const FString& FilePath);
+
+	static uint32 EncodeChoice(int32 OptionIndex, bool bFromAll) { return static_cast<uint32>(OptionIndex) << 1 | (bFromAll ? 1u : 0u); }
+
+public:
+	// The seed of the random stream of the context when the recording started
+	int32 Seed = 0;
+
+	// The option index of each ChooseOption/ChooseOptionFromAll call, see EncodeChoice
+	TArray<uint32> Choices;
+
+	// The child edge index picked by each random selector node
+	TArray<int32> Selections;
+
+	// The result of each condition evaluation
+	TBitArray<> ConditionResults;
+};
+
+enum class EDlgContextTraceMode : uint8
+{
+	None = 0,
+	Record,
+	Replay
+};
+
+// Records the decisions of a context into a FDlgContextTrace or feeds them back from one
+class DLGSYSTEM_API FDlgContextRecorder
+{
+public:
+	void StartRecording(int32 Seed);
+	void StartReplay(const FDlgContextTrace& InTrace);
+
+	// Keeps the trace
+	void Stop();
+
+	bool IsRecording() const { return Mode == EDlgContextTraceMode::Record; }
+	bool IsReplaying() const { return Mode == EDlgContextTraceMode::Replay; }
+	const FDlgContextTrace& GetTrace() const { return Trace; }
+
+	void RecordChoice(int32 OptionIndex, bool bFromAll);
+	void RecordSelection(int32 EdgeIndex);
+	void RecordConditionResult(bool bSatisfied);
+
+	// While replaying, the next recorded value. Returns false if not replaying or if the trace has no more values of that kind,
+	// in which case the replay is stopped and the context runs normally from there on
+	bool ReplayChoice(int32& OutOptionIndex, bool& bOutFromAll);
+	bool ReplaySelection(int32& OutEdgeIndex);
+	bool ReplayConditionResult(bool& bOutSatisfied);
+
+protected:
+	void OnReplayExhausted(const TCHAR* What);
+
+protected:
+	EDlgContextTraceMode Mode = EDlgContextTraceMode::None;
+	FDlgContextTrace Trace;
+
+	// Next values to replay
+	int32 NextChoice = 0;
+	int32 NextSelection = 0;
+	int32 NextConditionResult = 0;
+};
@@ -0,0 +1,106 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgCookStripping.h"
+
+#include "Misc/ScopeExit.h"
+#include "Serialization/ObjectWriter.h"
+#include "UObject/UnrealType.h"
+
+#include "NYReflectionHelper.h"
+#include "DlgSystemSettings.h"
+
+// Set by GetStrippedBytes to strip outside of a cook
+static bool bForceStripping = false;
+
+FDlgCookStripScope::FDlgCookStripScope(UObject& InObject, const FArchive& Ar)
+{
+	bStripping = ShouldStrip(Ar);
+	if (bStripping)
+	{
+		StripDeprecatedProperties(InObject.GetClass(), &InObject);
+	}
+}
+
+FDlgCookStripScope::~FDlgCookStripScope()
+{
+	for (const FStrippedValue& Stripped : StrippedValues)
+	{
+		Stripped.Property->CopyCompleteValue(Stripped.Value, Stripped.SavedValue);
+		Stripped.Property->DestroyValue(Stripped.SavedValue);
+		FMemory::Free(Stripped.SavedValue);
+	}
+}
+
+bool FDlgCookStripScope::ShouldStrip(const FArchive& Ar)
+{
+#if WITH_EDITOR
+	if (!Ar.IsSaving() || Ar.IsTransacting())
+	{
+		return false;
+	}
+
+	return bForceStripping || (Ar.IsCooking() && GetDefault<UDlgSystemSettings>()->bStripDialoguesOnCook);
+#else
+	return false;
+#endif
+}
+
+int64 FDlgCookStripScope::GetStrippedBytes(UObject& Object)
+{
+	check(IsInGameThread());
+
+	TArray<uint8> Bytes;
+	FObjectWriter FullWriter(&Object, Bytes);
+	const int64 FullBytes = Bytes.Num();
+
+	Bytes.Reset();
+	bForceStripping = true;
+	ON_SCOPE_EXIT
+	{
+		bForceStripping = false;
+	};
+	FObjectWriter StrippedWriter(&Object, Bytes);
+
+	return FullBytes - Bytes.Num();
+}
+
+void FDlgCookStripScope::StripDeprecatedProperties(const UStruct* Struct, void* Container)
+{
+#if WITH_EDITOR
+	// Does not follow the object references, the nodes and the instanced objects strip themselves when they are serialized
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (Property->HasMetaData(TEXT("DeprecatedProperty")))
+		{
+			FStrippedValue& Stripped = StrippedValues.AddDefaulted_GetRef();
+			Stripped.Property = Property;
+			Stripped.Value = Property->ContainerPtrToValuePtr<void>(Container);
+			Stripped.SavedValue = FMemory::Malloc(Property->GetSize() * Property->ArrayDim, Property->GetMinAlignment());
+			Property->InitializeValue(Stripped.SavedValue);
+			Property->CopyCompleteValue(Stripped.SavedValue, Stripped.Value);
+			Property->ClearValue(Stripped.Value);
+			continue;
+		}
+
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++)
+		{
+			void* Value = Property->ContainerPtrToValuePtr<void>(Container, ArrayIndex);
+			if (const auto* StructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(Property))
+			{
+				StripDeprecatedProperties(StructProperty->Struct, Value);
+			}
+			else if (const auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(Property))
+			{
+				if (const auto* InnerStructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(ArrayProperty->Inner))
+				{
+					FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+					for (int32 Index = 0; Index < ArrayHelper.Num(); Index++)
+					{
+						StripDeprecatedProperties(InnerStructProperty->Struct, ArrayHelper.GetRawPtr(Index));
+					}
+				}
+			}
+		}
+	}
+#endif // WITH_EDITOR
+}
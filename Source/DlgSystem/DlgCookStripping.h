@@ -0,0 +1,47 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UObject;
+class UStruct;
+class FProperty;
+
+/**
+ * Removes what the runtime does not need from a dialogue or a node while it is serialized for the cooked build
+ * and puts everything back once the scope ends, so the editor objects are not changed. See UDlgSystemSettings::bStripDialoguesOnCook.
+ *
+ * Strips the deprecated properties (already migrated by PostLoad), the owners add their own data with IsStripping.
+ */
+class DLGSYSTEM_API FDlgCookStripScope
+{
+public:
+	FDlgCookStripScope(UObject& InObject, const FArchive& Ar);
+	~FDlgCookStripScope();
+
+	FDlgCookStripScope(const FDlgCookStripScope&) = delete;
+	FDlgCookStripScope& operator=(const FDlgCookStripScope&) = delete;
+
+	bool IsStripping() const { return bStripping; }
+
+	static bool ShouldStrip(const FArchive& Ar);
+
+	// Serialized size of Object minus its stripped serialized size, game thread only
+	static int64 GetStrippedBytes(UObject& Object);
+
+protected:
+	void StripDeprecatedProperties(const UStruct* Struct, void* Container);
+
+protected:
+	struct FStrippedValue
+	{
+		const FProperty* Property = nullptr;
+		void* Value = nullptr;
+
+		// Copy of the value while it is cleared
+		void* SavedValue = nullptr;
+	};
+
+	bool bStripping = false;
+	TArray<FStrippedValue> StrippedValues;
+};
@@ -15,13 +15,18 @@
 #include "IO/DlgConfigWriter.h"
 #include "IO/DlgJsonWriter.h"
 #include "IO/DlgJsonParser.h"
+#include "IO/DlgBinaryWriter.h"
+#include "IO/DlgBinaryParser.h"
+#include "IO/DlgBatchIO.h"
 #include "Nodes/DlgNode_Speech.h"
 #include "Nodes/DlgNode_SpeechSequence.h"
 #include "Nodes/DlgNode_End.h"
 #include "Nodes/DlgNode_Start.h"
+#include "Nodes/DlgNode_Proxy.h"
 #include "DlgManager.h"
 #include "Logging/DlgLogger.h"
 #include "DlgHelper.h"
+#include "DlgCookStripping.h"
 
 #define LOCTEXT_NAMESPACE "DlgDialogue"
 
@@ -72,7 +77,30 @@ void UDlgDialogue::PreSave(const class ITargetPlatform* TargetPlatform)
 void UDlgDialogue::Serialize(FArchive& Ar)
 {
 	Ar.UsingCustomVersion(FDlgDialogueObjectVersion::GUID);
-	Super::Serialize(Ar);
+	{
+		FDlgCookStripScope StripScope(*this, Ar);
+
+		// The runtime only checks which participants there are, the GUID map is rebuilt in PostLoad
+		TMap<FGameplayTag, FDlgParticipantData> UnstrippedParticipantsData;
+		TMap<FGuid, int32> UnstrippedNodesGUIDToIndexMap;
+		if (StripScope.IsStripping())
+		{
+			UnstrippedParticipantsData = ParticipantsData;
+			for (auto& KeyValue : ParticipantsData)
+			{
+				KeyValue.Value = FDlgParticipantData{};
+			}
+			UnstrippedNodesGUIDToIndexMap = MoveTemp(NodesGUIDToIndexMap);
+		}
+
+		Super::Serialize(Ar);
+
+		if (StripScope.IsStripping())
+		{
+			ParticipantsData = MoveTemp(UnstrippedParticipantsData);
+			NodesGUIDToIndexMap = MoveTemp(UnstrippedNodesGUIDToIndexMap);
+		}
+	}
 	const int32 DialogueVersion = Ar.CustomVer(FDlgDialogueObjectVersion::GUID);
 	if (DialogueVersion < FDlgDialogueObjectVersion::ConvertedNodesToUObject)
 	{
@@ -128,6 +156,24 @@ void UDlgDialogue::PostLoad()
 		);
 	}
 
+	// Stripped from the cooked dialogues, see UDlgSystemSettings::bStripDialoguesOnCook
+	if (NodesGUIDToIndexMap.Num() == 0 && Nodes.Num() > 0)
+	{
+		NodesGUIDToIndexMap.Reserve(Nodes.Num());
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+		{
+			UpdateGUIDToIndexMap(Nodes[NodeIndex], NodeIndex);
+		}
+	}
+
+	RebuildResolvedNodeIndices();
+
+	// The Dialogue Data Display adds the participants of the dialogues loaded after it was opened
+	if (IsInGameThread() && UDlgManager::OnDialogueLoaded().IsBound())
+	{
+		UDlgManager::OnDialogueLoaded().Broadcast(this);
+	}
+
 #if WITH_EDITOR
 	const bool bHasDialogueEditorModule = GetDialogueEditorAccess().IsValid();
 	// If this is false it means the graph nodes are not even created? Check for old files that were saved
@@ -473,37 +519,30 @@ void UDlgDialogue::ImportFromFileFormat(EDlgDialogueTextFormat TextFormat)
 		return;
 	}
 
-	// Clear data first
-	StartNode_DEPRECATED = nullptr;
-	Nodes.Empty();
-	StartNodes.Empty();
-
 	// TODO handle Name == NAME_None or invalid filename
 	FDlgLogger::Get().Infof(TEXT("Reloading data for Dialogue = `%s` FROM file = `%s`"), *GetPathName(), *TextFileName);
 
 	// TODO(vampy): Check for errors
-	check(TextFormat != EDlgDialogueTextFormat::None);
-	switch (TextFormat)
+	const TUniquePtr<IDlgParser> Parser = MakeTextFileParser(TextFormat);
+	if (!Parser.IsValid())
 	{
-		case EDlgDialogueTextFormat::JSON:
-		{
-			FDlgJsonParser JsonParser;
-			JsonParser.InitializeParser(TextFileName);
-			JsonParser.ReadAllProperty(GetClass(), this, this);
-			break;
-		}
-		case EDlgDialogueTextFormat::DialogueDEPRECATED:
-		{
-			FDlgConfigParser Parser(TEXT("Dlg"));
-			Parser.InitializeParser(TextFileName);
-			Parser.ReadAllProperty(GetClass(), this, this);
-			break;
-		}
-		default:
-			checkNoEntry();
-			break;
+		checkNoEntry();
+		return;
 	}
 
+	Parser->InitializeParser(TextFileName);
+	ImportFromParser(*Parser);
+}
+
+void UDlgDialogue::ImportFromParser(IDlgParser& Parser, bool bCheckDuplicateGUIDs)
+{
+	// Clear data first
+	StartNode_DEPRECATED = nullptr;
+	Nodes.Empty();
+	StartNodes.Empty();
+
+	Parser.ReadAllProperty(GetClass(), this, this);
+
 	if (IsValid(StartNode_DEPRECATED))
 	{
 		StartNodes.Add(StartNode_DEPRECATED);
@@ -517,7 +556,7 @@ void UDlgDialogue::ImportFromFileFormat(EDlgDialogueTextFormat TextFormat)
 
 	// TODO(vampy): validate if data is legit, indicies exist and that sort.
 	// Check if Guid is not a duplicate
-	const TArray<UDlgDialogue*> DuplicateDialogues = UDlgManager::GetDialoguesWithDuplicateGUIDs();
+	const TArray<UDlgDialogue*> DuplicateDialogues = bCheckDuplicateGUIDs ? UDlgManager::GetDialoguesWithDuplicateGUIDs() : TArray<UDlgDialogue*>();
 	if (DuplicateDialogues.Num() > 0)
 	{
 		if (DuplicateDialogues.Contains(this))
@@ -557,6 +596,12 @@ void UDlgDialogue::OnPreAssetSaved()
 
 void UDlgDialogue::ExportToFile() const
 {
+	// A batch export will write all the text files at once after the packages are saved
+	if (FDlgBatchIO::IsExportDeferred())
+	{
+		return;
+	}
+
 	const EDlgDialogueTextFormat TextFormat = GetDefault<UDlgSystemSettings>()->DialogueTextFormat;
 	if (TextFormat == EDlgDialogueTextFormat::None)
 	{
@@ -569,47 +614,142 @@ void UDlgDialogue::ExportToFile() const
 
 void UDlgDialogue::ExportToFileFormat(EDlgDialogueTextFormat TextFormat) const
 {
-	// TODO(vampy): Check for errors
-	const bool bHasExtension = UDlgSystemSettings::HasTextFileExtension(TextFormat);
-	const FString& TextFileName = GetTextFilePathName(TextFormat);
-	if (bHasExtension)
+	// Useful for debugging
+	if (TextFormat == EDlgDialogueTextFormat::All)
 	{
-		FDlgLogger::Get().Infof(TEXT("Exporting data for Dialogue = `%s` TO file = `%s`"), *GetPathName(), *TextFileName);
+		// Export to all  formats
+		const int32 TextFormatsNum = static_cast<int32>(EDlgDialogueTextFormat::NumTextFormats);
+		for (int32 TextFormatIndex = static_cast<int32>(EDlgDialogueTextFormat::StartTextFormats);
+				   TextFormatIndex < TextFormatsNum; TextFormatIndex++)
+		{
+			const EDlgDialogueTextFormat CurrentTextFormat = static_cast<EDlgDialogueTextFormat>(TextFormatIndex);
+			ExportToFileFormat(CurrentTextFormat);
+		}
+		return;
 	}
 
-	switch (TextFormat)
+	// It Should not have any extension
+	if (!UDlgSystemSettings::HasTextFileExtension(TextFormat))
 	{
-		case EDlgDialogueTextFormat::JSON:
+		return;
+	}
+
+	const FString TextFileName = GetTextFilePathName(TextFormat);
+	bool bWasUnchanged = false;
+	FDlgTextFileContentHash NewContentHash;
+	if (!ExportToTextFile(TextFormat, &bWasUnchanged, &NewContentHash))
+	{
+		FDlgLogger::Get().Errorf(TEXT("Exporting data for Dialogue = `%s` TO file = `%s` FAILED"), *GetPathName(), *TextFileName);
+	}
+	else if (bWasUnchanged)
+	{
+		FDlgLogger::Get().Infof(TEXT("Skipped exporting data for Dialogue = `%s` TO file = `%s`, the content did not change"), *GetPathName(), *TextFileName);
+	}
+	else
+	{
+		SetTextFileContentHash(TextFormat, NewContentHash);
+		FDlgLogger::Get().Infof(TEXT("Exported data for Dialogue = `%s` TO file = `%s`"), *GetPathName(), *TextFileName);
+	}
+}
+
+bool UDlgDialogue::ExportToTextFile(EDlgDialogueTextFormat TextFormat, bool* bOutWasUnchanged, FDlgTextFileContentHash* OutNewContentHash) const
+{
+	if (bOutWasUnchanged)
+	{
+		*bOutWasUnchanged = false;
+	}
+
+	const TUniquePtr<IDlgWriter> Writer = MakeTextFileWriter(TextFormat);
+	if (!Writer.IsValid())
+	{
+		return false;
+	}
+
+	// The previous export is the best estimate for the size of this one
+	const FString TextFileName = GetTextFilePathName(TextFormat);
+	const FFileStatData PreviousFileStat = IFileManager::Get().GetStatData(*TextFileName);
+	const int64 PreviousFileSize = PreviousFileStat.bIsValid ? PreviousFileStat.FileSize : INDEX_NONE;
+	const int32 OutputSizeHint = PreviousFileSize > 0 ? static_cast<int32>(FMath::Min<int64>(PreviousFileSize, MAX_int32)) : 0;
+
+	Writer->SetOutputSizeHint(OutputSizeHint);
+	Writer->Write(GetClass(), this);
+
+#if WITH_EDITORONLY_DATA
+	// Same content as the last export and the file was not touched since, nothing to write.
+	// An edit that keeps the size still changes the modification time
+	const FString FileExtension = UDlgSystemSettings::GetTextFileExtension(TextFormat);
+	const uint64 ContentHash = Writer->GetContentHash();
+	const FDlgTextFileContentHash* LastContentHash = TextFileContentHashes.Find(FileExtension);
+	if (LastContentHash && LastContentHash->Hash == ContentHash && PreviousFileStat.bIsValid
+		&& LastContentHash->FileSize == PreviousFileSize && LastContentHash->FileModificationTime == PreviousFileStat.ModificationTime)
+	{
+		if (bOutWasUnchanged)
 		{
-			FDlgJsonWriter JsonWriter;
-			JsonWriter.Write(GetClass(), this);
-			JsonWriter.ExportToFile(TextFileName);
-			break;
+			*bOutWasUnchanged = true;
 		}
+		return true;
+	}
+#endif
+
+	if (!Writer->ExportToFile(TextFileName))
+	{
+		return false;
+	}
+
+#if WITH_EDITORONLY_DATA
+	if (OutNewContentHash)
+	{
+		const FFileStatData FileStat = IFileManager::Get().GetStatData(*TextFileName);
+		OutNewContentHash->Hash = ContentHash;
+		OutNewContentHash->FileSize = FileStat.bIsValid ? FileStat.FileSize : INDEX_NONE;
+		OutNewContentHash->FileModificationTime = FileStat.ModificationTime;
+	}
+#endif
+
+	return true;
+}
+
+void UDlgDialogue::SetTextFileContentHash(EDlgDialogueTextFormat TextFormat, const FDlgTextFileContentHash& ContentHash) const
+{
+	check(IsInGameThread());
+#if WITH_EDITORONLY_DATA
+	TextFileContentHashes.Add(UDlgSystemSettings::GetTextFileExtension(TextFormat), ContentHash);
+#endif
+}
+
+TUniquePtr<IDlgWriter> UDlgDialogue::MakeTextFileWriter(EDlgDialogueTextFormat TextFormat)
+{
+	switch (TextFormat)
+	{
+		case EDlgDialogueTextFormat::JSON:
+			return MakeUnique<FDlgJsonWriter>();
+
 		case EDlgDialogueTextFormat::DialogueDEPRECATED:
-		{
-			FDlgConfigWriter DlgWriter(TEXT("Dlg"));
-			DlgWriter.Write(GetClass(), this);
-			DlgWriter.ExportToFile(TextFileName);
-			break;
-		}
-		case EDlgDialogueTextFormat::All:
-		{
-			// Useful for debugging
-			// Export to all  formats
-			const int32 TextFormatsNum = static_cast<int32>(EDlgDialogueTextFormat::NumTextFormats);
-			for (int32 TextFormatIndex = static_cast<int32>(EDlgDialogueTextFormat::StartTextFormats);
-					   TextFormatIndex < TextFormatsNum; TextFormatIndex++)
-			{
-				const EDlgDialogueTextFormat CurrentTextFormat = static_cast<EDlgDialogueTextFormat>(TextFormatIndex);
-				ExportToFileFormat(CurrentTextFormat);
-			}
-			break;
-		}
+			return MakeUnique<FDlgConfigWriter>(TEXT("Dlg"));
+
+		case EDlgDialogueTextFormat::Binary:
+			return MakeUnique<FDlgBinaryWriter>();
+
 		default:
-			// It Should not have any extension
-			check(!bHasExtension);
-			break;
+			return nullptr;
+	}
+}
+
+TUniquePtr<IDlgParser> UDlgDialogue::MakeTextFileParser(EDlgDialogueTextFormat TextFormat)
+{
+	switch (TextFormat)
+	{
+		case EDlgDialogueTextFormat::JSON:
+			return MakeUnique<FDlgJsonParser>();
+
+		case EDlgDialogueTextFormat::DialogueDEPRECATED:
+			return MakeUnique<FDlgConfigParser>(TEXT("Dlg"));
+
+		case EDlgDialogueTextFormat::Binary:
+			return MakeUnique<FDlgBinaryParser>();
+
+		default:
+			return nullptr;
 	}
 }
 
@@ -686,6 +826,7 @@ void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
 	const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
 	ParticipantsData.Empty();
 	AllSpeakerStates.Empty();
+	RebuildResolvedNodeIndices();
 
 	// do not forget about the edges of the Root/Start Node
 	for (UDlgNode* StartNode : StartNodes)
@@ -901,6 +1042,7 @@ void UDlgDialogue::SetNodes(const TArray<UDlgNode*>& InNodes)
 	{
 		UpdateGUIDToIndexMap(Nodes[NodeIndex], NodeIndex);
 	}
+	RebuildResolvedNodeIndices();
 }
 
 void UDlgDialogue::SetNode(int32 NodeIndex, UDlgNode* InNode)
@@ -912,6 +1054,7 @@ void UDlgDialogue::SetNode(int32 NodeIndex, UDlgNode* InNode)
 
 	Nodes[NodeIndex] = InNode;
 	UpdateGUIDToIndexMap(InNode, NodeIndex);
+	RebuildResolvedNodeIndices();
 }
 
 void UDlgDialogue::UpdateGUIDToIndexMap(const UDlgNode* Node, int32 NodeIndex)
@@ -934,6 +1077,73 @@ bool UDlgDialogue::IsEndNode(int32 NodeIndex) const
 	return Nodes[NodeIndex]->IsA<UDlgNode_End>();
 }
 
+int32 UDlgDialogue::ResolveNodeIndex(int32 NodeIndex) const
+{
+	// A chain of more proxies than nodes can only be a loop
+	for (int32 Hop = 0; Hop <= Nodes.Num() && IsValidNodeIndex(NodeIndex); Hop++)
+	{
+		const UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Nodes[NodeIndex]);
+		if (Proxy == nullptr)
+		{
+			return NodeIndex;
+		}
+		NodeIndex = Proxy->GetTargetNodeIndex();
+	}
+
+	return INDEX_NONE;
+}
+
+void UDlgDialogue::RebuildResolvedNodeIndices()
+{
+	// Kept for the lifetime of the dialogue, without the slack of growing (the bit array is already allocated to fit)
+	ResolvedNodeIndices.SetNumUninitialized(Nodes.Num());
+	ResolvedNodeIndices.Shrink();
+	LeadsToEndNodes.Init(false, Nodes.Num());
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		ResolvedNodeIndices[NodeIndex] = ResolveNodeIndex(NodeIndex);
+		LeadsToEndNodes[NodeIndex] = IsEndNode(ResolvedNodeIndices[NodeIndex]);
+	}
+
+	CollapseProxyChains();
+}
+
+void UDlgDialogue::CollapseProxyChains()
+{
+	const auto IsSkippableProxy = [this](int32 NodeIndex)
+	{
+		const UDlgNode_Proxy* Proxy = IsValidNodeIndex(NodeIndex) ? Cast<UDlgNode_Proxy>(Nodes[NodeIndex]) : nullptr;
+		return Proxy != nullptr && Proxy->CanBeSkipped();
+	};
+
+	for (UDlgNode* Node : Nodes)
+	{
+		UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Node);
+		if (Proxy == nullptr)
+		{
+			continue;
+		}
+
+		// A chain of more proxies than nodes can only be a loop
+		int32 JumpNodeIndex = Proxy->GetTargetNodeIndex();
+		TArray<int32> SkippedNodeIndices;
+		while (SkippedNodeIndices.Num() <= Nodes.Num() && IsSkippableProxy(JumpNodeIndex))
+		{
+			SkippedNodeIndices.Add(JumpNodeIndex);
+			JumpNodeIndex = CastChecked<UDlgNode_Proxy>(Nodes[JumpNodeIndex])->GetTargetNodeIndex();
+		}
+
+		if (SkippedNodeIndices.Num() > Nodes.Num())
+		{
+			Proxy->SetJumpNodeIndex(Proxy->GetTargetNodeIndex(), {});
+		}
+		else
+		{
+			Proxy->SetJumpNodeIndex(JumpNodeIndex, MoveTemp(SkippedNodeIndices));
+		}
+	}
+}
+
 FString UDlgDialogue::GetTextFilePathName(bool bAddExtension/* = true*/) const
 {
 	return GetTextFilePathName(GetDefault<UDlgSystemSettings>()->DialogueTextFormat, bAddExtension);
@@ -18,6 +18,8 @@
 #include "DlgDialogue.generated.h"
 
 class UDlgNode;
+class IDlgParser;
+class IDlgWriter;
 
 // Custom serialization version for changes made in Dev-Dialogues stream
 struct DLGSYSTEM_API FDlgDialogueObjectVersion
@@ -68,6 +70,26 @@ public:
 	UClass* ParticipantClass = nullptr;
 };
 
+// Identifies the content of an exported text file, used to skip rewriting it when nothing changed
+USTRUCT()
+struct DLGSYSTEM_API FDlgTextFileContentHash
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	// IDlgWriter::GetContentHash of the written content
+	UPROPERTY()
+	uint64 Hash = 0;
+
+	// Size and modification time of the file right after it was written,
+	// a different one on disk means the file was modified by someone else
+	UPROPERTY()
+	int64 FileSize = INDEX_NONE;
+
+	UPROPERTY()
+	FDateTime FileModificationTime;
+};
+
 /**
  *  Dialogue asset containing the static data of a dialogue
  *  Instances can be created in content browser
@@ -235,6 +257,7 @@ public:
 	// Enables/disables the compilation of the dialogues in the editor, use with care. Mainly used for optimization.
 	void EnableCompileDialogue() { bCompileDialogue = true; }
 	void DisableCompileDialogue() { bCompileDialogue = false; }
+	bool IsCompileDialogueEnabled() const { return bCompileDialogue; }
 #endif
 
 	// Construct and initialize a node within this Dialogue.
@@ -644,6 +667,22 @@ public:
 	// Is the Node at NodeIndex (if it exists) an end node?
 	bool IsEndNode(int32 NodeIndex) const;
 
+	// The node index that entering NodeIndex ends up on, the proxies are followed. INDEX_NONE if invalid or if the proxies loop
+	int32 GetResolvedNodeIndex(int32 NodeIndex) const
+	{
+		return ResolvedNodeIndices.Num() == Nodes.Num() && ResolvedNodeIndices.IsValidIndex(NodeIndex)
+			? ResolvedNodeIndices[NodeIndex]
+			: ResolveNodeIndex(NodeIndex);
+	}
+
+	// Does entering the Node at NodeIndex end up on an end node, the proxies are followed
+	bool LeadsToEndNode(int32 NodeIndex) const
+	{
+		return LeadsToEndNodes.Num() == Nodes.Num() && LeadsToEndNodes.IsValidIndex(NodeIndex)
+			? LeadsToEndNodes[NodeIndex]
+			: IsEndNode(ResolveNodeIndex(NodeIndex));
+	}
+
 	// Check if a text file in the same folder with the same name (Name) exists and loads the data from that file.
 	void ImportFromFile();
 
@@ -663,8 +702,44 @@ public:
 	}
 
 	// Exports this dialogue data into it's corresponding ".dlg" text file with the same name as this (Name).
+	// The file is not rewritten if its content did not change since the last export.
 	void ExportToFile() const;
 
+	/**
+	 * Writes the text file of a single TextFormat, without logging or modifying any object.
+	 * Safe to call from worker threads as long as the game thread does not modify this dialogue meanwhile (see FDlgBatchIO).
+	 * In the editor the content hash of the last written file is kept in TextFileContentHashes, if the new content has the
+	 * same hash and the file on disk has the same size and modification time as after that export, the write is skipped.
+	 * @param bOutWasUnchanged		Optional, set to true if the write was skipped because the content did not change
+	 * @param OutNewContentHash		Optional, set if the file was written. Pass it to SetTextFileContentHash on the game thread
+	 * @return False on failure to write or if the TextFormat has no text file
+	 */
+	bool ExportToTextFile(
+		EDlgDialogueTextFormat TextFormat,
+		bool* bOutWasUnchanged = nullptr,
+		FDlgTextFileContentHash* OutNewContentHash = nullptr
+	) const;
+
+	// Remembers the content hash of the text file just written by ExportToTextFile, game thread only
+	void SetTextFileContentHash(EDlgDialogueTextFormat TextFormat, const FDlgTextFileContentHash& ContentHash) const;
+
+#if WITH_EDITOR
+	// Forgets the content hashes of the text files, the next export rewrites all of them
+	void ClearTextFileContentHashes() { TextFileContentHashes.Empty(); }
+#endif
+
+	/**
+	 * Reads the dialogue data from an already initialized parser and refreshes the dialogue.
+	 * @param bCheckDuplicateGUIDs	Regenerate the GUID if it is a duplicate of another dialogue, batch imports do this once at the end
+	 */
+	void ImportFromParser(IDlgParser& Parser, bool bCheckDuplicateGUIDs = true);
+
+	// Creates the parser for the TextFormat, nullptr if the TextFormat has no text file
+	static TUniquePtr<IDlgParser> MakeTextFileParser(EDlgDialogueTextFormat TextFormat);
+
+	// Creates the writer for the TextFormat, nullptr if the TextFormat has no text file
+	static TUniquePtr<IDlgWriter> MakeTextFileWriter(EDlgDialogueTextFormat TextFormat);
+
 	// Updates the data of some nodes
 	// Fills the DlgData with the updated data
 	// NOTE: this can do a dialogue data -> graph node data update
@@ -676,10 +751,15 @@ public:
 	// Adds a new start node to this dialogue, returns the index location of the added node in the Nodes array.
 	int32 AddStartNode(UDlgNode* NodeToAdd) { return StartNodes.Add(NodeToAdd); }
 
+	// Precomputes ResolvedNodeIndices and LeadsToEndNodes and collapses the proxy chains.
+	// SetNodes, SetNode, UpdateAndRefreshData and PostLoad call it, call it after changing the proxy targets or the edges of the nodes in place
+	// (e.g. UDlgNode_Proxy::SetTargetNodeIndex, FDlgEditorUtilities::RemapOldIndicesWithNewAndUpdateGUID)
+	void RebuildResolvedNodeIndices();
+
 
 
 	/**
-	 * @param	bAddExtension	If this adds the .dlg or .dlg.json extension depending on the TextFormat.
+	 * @param	bAddExtension	If this adds the .dlg, .dlg.json or .dlg.bin extension depending on the TextFormat.
 	 * @return The path (as a relative path) and name of the text file, or empty string if something is wrong.
 	 */
 	FString GetTextFilePathName(bool bAddExtension = true) const;
@@ -715,6 +795,15 @@ private:
 	// Updates NodesGUIDToIndexMap with Node
 	void UpdateGUIDToIndexMap(const UDlgNode* Node, int32 NodeIndex);
 
+	// Follows the proxies starting from NodeIndex, see GetResolvedNodeIndex
+	int32 ResolveNodeIndex(int32 NodeIndex) const;
+
+	// Points every proxy directly to the first node of its chain that does something when entered, so the runtime
+	// does not enter the proxies that only forward. A proxy is kept in the chain if it has enter conditions/events/restriction.
+	// The skipped proxies are still marked as visited when the chain is jumped through, so the history and FDlgMemory do not change.
+	// Chains that loop keep their target so the runtime reports them.
+	void CollapseProxyChains();
+
 protected:
 	// Used to keep track of the version in text  file too, besides being written in the .uasset file.
 	UPROPERTY()
@@ -760,6 +849,12 @@ protected:
 	UPROPERTY(VisibleAnywhere, AdvancedDisplay, Category = "Dialogue", DisplayName = "Nodes GUID To Index Map")
 	TMap<FGuid, int32> NodesGUIDToIndexMap;
 
+	// Node Index => GetResolvedNodeIndex, so that the option queries of the contexts do not walk the proxies
+	TArray<int32> ResolvedNodeIndices;
+
+	// Node Index => LeadsToEndNode
+	TBitArray<> LeadsToEndNodes;
+
 	// Useful for syncing on the first run with the text file.
 	bool bIsSyncedWithTextFile = false;
 
@@ -768,6 +863,11 @@ protected:
 	UPROPERTY(Meta = (DlgNoExport))
 	TObjectPtr<UEdGraph> DlgGraph;
 
+	// Text file extension => content hash of the last text file exported for it, see ExportToTextFile
+	// Only a cache of what is on disk, exporting is const
+	UPROPERTY(Meta = (DlgNoExport))
+	mutable TMap<FString, FDlgTextFileContentHash> TextFileContentHashes;
+
 	// Ptr to interface to dialogue editor operations. See function SetDialogueEditorAccess for more details.
 	static TSharedPtr<IDlgEditorAccess> DialogueEditorAccess;
 
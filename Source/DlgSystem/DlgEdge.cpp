@@ -105,6 +105,9 @@ void FDlgEdge::RebuildConstructedText(const UDlgContext& Context, const FGamepla
 		return;
 	}
 
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgText_Construct);
+	Context.GetMutableMetrics().OnTextFormatted();
+
 	FFormatNamedArguments OrderedArguments;
 	for (const FDlgTextArgument& DlgArgument : TextArguments)
 	{
@@ -10,6 +10,9 @@
 
 void FDlgEvent::Call(UDlgContext& Context, const FString& ContextString, UObject* Participant) const
 {
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgEvent_Call);
+	Context.GetMutableMetrics().OnEventFired();
+
 	const bool bHasParticipant = ValidateIsParticipantValid(
 		Context,
 		FString::Printf(TEXT("%s::Call"), *ContextString),
@@ -21,10 +24,13 @@ void FDlgEvent::Call(UDlgContext& Context, const FString& ContextString, UObject
 	{
 		if (CustomEvent == nullptr)
 		{
-			FDlgLogger::Get().Warningf(
-				TEXT("Custom Event is empty (not valid). Ignoring. Context:\n\t%s, Participant = %s"),
-				*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
-			);
+			FDlgLogger::Get().WarningLazy(&Context, [&]()
+			{
+				return FString::Printf(
+					TEXT("Custom Event is empty (not valid). Ignoring. Context:\n\t%s, Participant = %s"),
+					*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
+				);
+			});
 			return;
 		}
 
@@ -149,19 +155,27 @@ bool FDlgEvent::ValidateIsParticipantValid(const UDlgContext& Context, const FSt
 		return true;
 	}
 
+	// Per caller and participant, the same lambda reports all of them
+	const uint32 MessageKey = HashCombine(GetTypeHash(ContextString), GetTypeHash(ParticipantTag));
 	if (MustHaveParticipant())
 	{
-		FDlgLogger::Get().Errorf(
-			TEXT("%s - Event FAILED because the PARTICIPANT is INVALID. \nContext:\n\t%s, \n\tParticipantTag = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
-			*ContextString, *Context.GetContextString(), *ParticipantTag.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
-		);
+		FDlgLogger::Get().LogLazy(ENYLoggerLogLevel::Error, &Context, MessageKey, [&]()
+		{
+			return FString::Printf(
+				TEXT("%s - Event FAILED because the PARTICIPANT is INVALID. \nContext:\n\t%s, \n\tParticipantTag = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
+				*ContextString, *Context.GetContextString(), *ParticipantTag.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
+			);
+		});
 	}
 	else
 	{
-		FDlgLogger::Get().Warningf(
-			TEXT("%s - Event WARNING because the PARTICIPANT is INVALID. The call will NOT FAIL, but the participant is not present. \nContext:\n\t%s, \n\tParticipantTag = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
-			*ContextString, *Context.GetContextString(), *ParticipantTag.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
-		);
+		FDlgLogger::Get().LogLazy(ENYLoggerLogLevel::Warning, &Context, MessageKey, [&]()
+		{
+			return FString::Printf(
+				TEXT("%s - Event WARNING because the PARTICIPANT is INVALID. The call will NOT FAIL, but the participant is not present. \nContext:\n\t%s, \n\tParticipantTag = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
+				*ContextString, *Context.GetContextString(), *ParticipantTag.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
+			);
+		});
 	}
 
 	return false;
@@ -187,9 +201,12 @@ void FDlgEvent::CallUnrealFunction(UDlgContext& Context, const FString& ContextS
 	}
 	else
 	{
-		FDlgLogger::Get().Warningf(
-			TEXT("Unreal Function %s Not Found. Ignoring. Context:\n\t%s, Participant = %s"),
-			*EventName.ToString(), *Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
-		);
+		FDlgLogger::Get().WarningLazy(&Context, [&]()
+		{
+			return FString::Printf(
+				TEXT("Unreal Function %s Not Found. Ignoring. Context:\n\t%s, Participant = %s"),
+				*EventName.ToString(), *Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
+			);
+		});
 	}
 }
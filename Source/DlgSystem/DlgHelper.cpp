@@ -4,6 +4,8 @@
 #include "DlgDialogueParticipant.h"
 #include "HAL/FileManager.h"
 #include "Engine/Blueprint.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Logging/DlgLogger.h"
 #include "DlgSystemSettings.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -102,6 +104,17 @@ TSharedPtr<SDockTab> FDlgHelper::InvokeTab(TSharedPtr<FTabManager> TabManager, c
 #endif
 }
 
+FStreamableManager& FDlgHelper::GetStreamableManager()
+{
+	if (UAssetManager::IsValid())
+	{
+		return UAssetManager::GetStreamableManager();
+	}
+
+	static FStreamableManager StreamableManager;
+	return StreamableManager;
+}
+
 FString FDlgHelper::CleanObjectName(FString Name)
 {
 	Name.RemoveFromEnd(TEXT("_C"));
@@ -18,6 +18,7 @@
 class SDockTab;
 class FTabManager;
 struct FTabId;
+struct FStreamableManager;
 class UDlgSystemSettings;
 
 USTRUCT()
@@ -245,6 +246,9 @@ public:
 	 */
 	static TSharedPtr<SDockTab> InvokeTab(TSharedPtr<FTabManager> TabManager, const FTabId& TabID);
 
+	// The one of the asset manager if the project has one
+	static FStreamableManager& GetStreamableManager();
+
 	// Removes _C from the end of the Name
 	// And removes the .extension from the path names
 	static FString CleanObjectName(FString Name);
@@ -22,6 +22,18 @@ TWeakObjectPtr<const UObject> UDlgManager::UserWorldContextObjectPtr = nullptr;
 
 bool UDlgManager::bCalledLoadAllDialoguesIntoMemory = false;;
 
+FDlgOnParticipantChanged UDlgManager::ParticipantChangedEvent;
+FDlgOnDialogueLoaded UDlgManager::DialogueLoadedEvent;
+
+void UDlgManager::NotifyParticipantChanged(UObject* Participant)
+{
+	check(IsInGameThread());
+	if (IsValid(Participant) && ParticipantChangedEvent.IsBound())
+	{
+		ParticipantChangedEvent.Broadcast(Participant);
+	}
+}
+
 UDlgContext* UDlgManager::StartDialogueWithDefaultParticipants(UObject* WorldContextObject, UDlgDialogue* Dialogue)
 {
 	if (!IsValid(Dialogue))
@@ -408,6 +420,16 @@ void UDlgManager::ClearDialogueHistory()
 	FDlgMemory::Get().Empty();
 }
 
+void UDlgManager::SaveDialogueHistoryToBytes(bool bOnlyDirty, TArray<uint8>& OutBytes)
+{
+	FDlgMemory::Get().SaveToBytes(OutBytes, bOnlyDirty);
+}
+
+bool UDlgManager::LoadDialogueHistoryFromBytes(const TArray<uint8>& Bytes)
+{
+	return FDlgMemory::Get().LoadFromBytes(Bytes);
+}
+
 bool UDlgManager::DoesObjectImplementDialogueParticipantInterface(const UObject* Object)
 {
 	return FDlgHelper::IsObjectImplementingInterface(Object, UDlgDialogueParticipant::StaticClass());
@@ -12,6 +12,9 @@ class AActor;
 class UDlgContext;
 class UDlgDialogue;
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FDlgOnParticipantChanged, UObject* /* Participant */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FDlgOnDialogueLoaded, UDlgDialogue* /* Dialogue */);
+
 
 USTRUCT(BlueprintType)
 struct DLGSYSTEM_API FDlgObjectsArray
@@ -199,6 +202,15 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Memory")
 	static const TMap<FGuid, FDlgHistory>& GetDialogueHistory();
 
+	// Writes the FDlgMemory Dialogue history in a compact binary format, a lot smaller and faster than saving GetDialogueHistory.
+	// bOnlyDirty writes only the dialogues changed since the last save, load the last full save then these in order.
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	static void SaveDialogueHistoryToBytes(bool bOnlyDirty, TArray<uint8>& OutBytes);
+
+	// Loads what SaveDialogueHistoryToBytes wrote, returns false if the bytes are not a valid save.
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Memory")
+	static bool LoadDialogueHistoryFromBytes(const TArray<uint8>& Bytes);
+
 	// Does the Object implement the Dialogue Participant Interface?
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Helper")
 	static bool DoesObjectImplementDialogueParticipantInterface(const UObject* Object);
@@ -345,6 +357,17 @@ public:
 
 	static bool HasCalledLoadAllDialoguesIntoMemory() { return bCalledLoadAllDialoguesIntoMemory; }
 
+	// Tells the listeners (e.g. the Dialogue Data Display) that the Participant was spawned or changed its participant tag.
+	// Called for the participants of every started dialogue.
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Data")
+	static void NotifyParticipantChanged(UObject* Participant);
+
+	// Broadcast by NotifyParticipantChanged, game thread only
+	static FDlgOnParticipantChanged& OnParticipantChanged() { return ParticipantChangedEvent; }
+
+	// Broadcast by UDlgDialogue::PostLoad, game thread only
+	static FDlgOnDialogueLoaded& OnDialogueLoaded() { return DialogueLoadedEvent; }
+
 private:
 	static void GatherParticipantsRecursive(UObject* Object, TArray<UObject*>& Array, TSet<UObject*>& AlreadyVisited);
 
@@ -352,4 +375,7 @@ private:
 	static TWeakObjectPtr<const UObject> UserWorldContextObjectPtr;
 
 	static bool bCalledLoadAllDialoguesIntoMemory;
+
+	static FDlgOnParticipantChanged ParticipantChangedEvent;
+	static FDlgOnDialogueLoaded DialogueLoadedEvent;
 };
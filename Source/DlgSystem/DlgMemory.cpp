@@ -1,6 +1,12 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #include "DlgMemory.h"
+
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
 #include "DlgHelper.h"
+#include "Logging/DlgLogger.h"
 
 void FDlgHistory::Add(int32 NodeIndex, const FGuid& NodeGUID)
 {
@@ -37,3 +43,440 @@ FDlgNodeSavedData& FDlgHistory::GetNodeData(const FGuid& NodeGUID)
 	return NodeData.FindOrAdd(NodeGUID);
 }
 
+
+//
+// Binary save layout (FDlgMemory::SaveToBytes):
+//
+// Header, not compressed:
+//   uint32 Magic, uint8 Version, uint8 Flags (DlgMemorySave::EFlags), int32 PayloadSize, int32 CompressedPayloadSize (0 if stored as is)
+//
+// Payload, zlib compressed if that makes it smaller. All the counts, ordinals and indices are varints (FArchive::SerializeIntPacked):
+//   GUID table: Num, FGuid...
+//   Entries: Num, then for each dialogue:
+//     Dialogue GUID ordinal
+//     VisitedNodeIndices: Num, sorted and delta encoded (negative indices are not saved)
+//     VisitedNodeGUIDs: Num, ordinals sorted and delta encoded
+//     NodeData: Num, then for each node: Node GUID ordinal, NumEdges, EdgesHash (not a varint, since the AddedEdgesHash version),
+//               LastPickedEdgeIndex + 1, PickedEdgesMask (Num, words), GUIDList (Num, ordinals)
+//
+namespace DlgMemorySave
+{
+	static constexpr uint32 Magic = 0x4D474C44; // DLGM
+
+	enum EVersion : uint8
+	{
+		Initial = 1,
+
+		// FDlgNodeSavedData::EdgesHash after NumEdges
+		AddedEdgesHash,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	enum EFlags : uint8
+	{
+		None = 0,
+		OnlyDirty = 1 << 0
+	};
+
+	// The PayloadSize of the header is checked against these before it is allocated.
+	// zlib does not compress more than ~1032:1, and a save is nowhere near the hard cap
+	static constexpr int64 MaxCompressionRatio = 1032;
+	static constexpr int32 MaxPayloadSize = 256 * 1024 * 1024;
+
+	// Varints of the GUID ordinals, fills the GUID table while writing
+	struct FGUIDTable
+	{
+		uint32 GetOrdinal(const FGuid& GUID)
+		{
+			if (const uint32* Ordinal = Ordinals.Find(GUID))
+			{
+				return *Ordinal;
+			}
+
+			const uint32 Ordinal = GUIDs.Add(GUID);
+			Ordinals.Add(GUID, Ordinal);
+			return Ordinal;
+		}
+
+		TArray<FGuid> GUIDs;
+		TMap<FGuid, uint32> Ordinals;
+	};
+
+	// Sorted then delta encoded, the sorted values are small steps that fit in one or two bytes
+	static void WriteSorted(FArchive& Ar, TArray<uint32>& Values)
+	{
+		Values.Sort();
+		uint32 Num = Values.Num();
+		Ar.SerializeIntPacked(Num);
+
+		uint32 Previous = 0;
+		for (const uint32 Value : Values)
+		{
+			uint32 Delta = Value - Previous;
+			Ar.SerializeIntPacked(Delta);
+			Previous = Value;
+		}
+	}
+
+	// Guards the allocations against corrupt counts, every element takes at least one byte
+	static bool ReadNum(FArchive& Ar, uint32& OutNum)
+	{
+		Ar.SerializeIntPacked(OutNum);
+		if (Ar.IsError() || static_cast<int64>(OutNum) > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return false;
+		}
+
+		return true;
+	}
+
+	static bool ReadSorted(FArchive& Ar, TArray<uint32>& OutValues)
+	{
+		uint32 Num = 0;
+		if (!ReadNum(Ar, Num))
+		{
+			return false;
+		}
+
+		OutValues.SetNumUninitialized(Num);
+		uint32 Previous = 0;
+		for (uint32& Value : OutValues)
+		{
+			uint32 Delta = 0;
+			Ar.SerializeIntPacked(Delta);
+			Value = Previous + Delta;
+			Previous = Value;
+		}
+
+		return !Ar.IsError();
+	}
+
+	static bool ReadGUID(FArchive& Ar, const TArray<FGuid>& GUIDs, FGuid& OutGUID)
+	{
+		uint32 Ordinal = 0;
+		Ar.SerializeIntPacked(Ordinal);
+		if (Ar.IsError() || !GUIDs.IsValidIndex(Ordinal))
+		{
+			Ar.SetError();
+			return false;
+		}
+
+		OutGUID = GUIDs[Ordinal];
+		return true;
+	}
+
+	static void WriteHistory(FArchive& Ar, FGUIDTable& Table, const FGuid& DialogueGUID, const FDlgHistory& History)
+	{
+		uint32 DialogueOrdinal = Table.GetOrdinal(DialogueGUID);
+		Ar.SerializeIntPacked(DialogueOrdinal);
+
+		TArray<uint32> Values;
+		Values.Reserve(History.VisitedNodeIndices.Num());
+		for (const int32 NodeIndex : History.VisitedNodeIndices)
+		{
+			if (NodeIndex >= 0)
+			{
+				Values.Add(static_cast<uint32>(NodeIndex));
+			}
+		}
+		WriteSorted(Ar, Values);
+
+		Values.Reset();
+		for (const FGuid& NodeGUID : History.VisitedNodeGUIDs)
+		{
+			Values.Add(Table.GetOrdinal(NodeGUID));
+		}
+		WriteSorted(Ar, Values);
+
+		uint32 NumNodeData = History.NodeData.Num();
+		Ar.SerializeIntPacked(NumNodeData);
+		for (const auto& KeyValue : History.NodeData)
+		{
+			const FDlgNodeSavedData& Data = KeyValue.Value;
+			uint32 NodeOrdinal = Table.GetOrdinal(KeyValue.Key);
+			uint32 NumEdges = static_cast<uint32>(FMath::Max(Data.NumEdges, 0));
+			uint32 EdgesHash = Data.EdgesHash;
+			uint32 LastPickedEdge = static_cast<uint32>(FMath::Max(Data.LastPickedEdgeIndex + 1, 0));
+			uint32 NumWords = Data.PickedEdgesMask.Num();
+			Ar.SerializeIntPacked(NodeOrdinal);
+			Ar.SerializeIntPacked(NumEdges);
+			Ar << EdgesHash;
+			Ar.SerializeIntPacked(LastPickedEdge);
+			Ar.SerializeIntPacked(NumWords);
+			for (uint32 Word : Data.PickedEdgesMask)
+			{
+				Ar.SerializeIntPacked(Word);
+			}
+
+			uint32 NumGUIDs = Data.GUIDList.Num();
+			Ar.SerializeIntPacked(NumGUIDs);
+			for (const FGuid& GUID : Data.GUIDList)
+			{
+				uint32 Ordinal = Table.GetOrdinal(GUID);
+				Ar.SerializeIntPacked(Ordinal);
+			}
+		}
+	}
+
+	static bool ReadHistory(FArchive& Ar, uint8 Version, const TArray<FGuid>& GUIDs, FGuid& OutDialogueGUID, FDlgHistory& OutHistory)
+	{
+		if (!ReadGUID(Ar, GUIDs, OutDialogueGUID))
+		{
+			return false;
+		}
+
+		TArray<uint32> Values;
+		if (!ReadSorted(Ar, Values))
+		{
+			return false;
+		}
+		OutHistory.VisitedNodeIndices.Reserve(Values.Num());
+		for (const uint32 Value : Values)
+		{
+			OutHistory.VisitedNodeIndices.Add(static_cast<int32>(Value));
+		}
+
+		if (!ReadSorted(Ar, Values))
+		{
+			return false;
+		}
+		OutHistory.VisitedNodeGUIDs.Reserve(Values.Num());
+		for (const uint32 Ordinal : Values)
+		{
+			if (!GUIDs.IsValidIndex(Ordinal))
+			{
+				Ar.SetError();
+				return false;
+			}
+			OutHistory.VisitedNodeGUIDs.Add(GUIDs[Ordinal]);
+		}
+
+		uint32 NumNodeData = 0;
+		if (!ReadNum(Ar, NumNodeData))
+		{
+			return false;
+		}
+		OutHistory.NodeData.Reserve(NumNodeData);
+		for (uint32 Index = 0; Index < NumNodeData; Index++)
+		{
+			FGuid NodeGUID;
+			if (!ReadGUID(Ar, GUIDs, NodeGUID))
+			{
+				return false;
+			}
+
+			FDlgNodeSavedData& Data = OutHistory.NodeData.FindOrAdd(NodeGUID);
+			uint32 NumEdges = 0;
+			uint32 LastPickedEdge = 0;
+			uint32 NumWords = 0;
+			Ar.SerializeIntPacked(NumEdges);
+			if (Version >= AddedEdgesHash)
+			{
+				Ar << Data.EdgesHash;
+			}
+			Ar.SerializeIntPacked(LastPickedEdge);
+			if (!ReadNum(Ar, NumWords))
+			{
+				return false;
+			}
+			Data.NumEdges = static_cast<int32>(NumEdges);
+			Data.LastPickedEdgeIndex = static_cast<int32>(LastPickedEdge) - 1;
+			Data.PickedEdgesMask.SetNumUninitialized(NumWords);
+			for (uint32& Word : Data.PickedEdgesMask)
+			{
+				Ar.SerializeIntPacked(Word);
+			}
+
+			uint32 NumGUIDs = 0;
+			if (!ReadNum(Ar, NumGUIDs))
+			{
+				return false;
+			}
+			Data.GUIDList.SetNum(NumGUIDs);
+			for (FGuid& GUID : Data.GUIDList)
+			{
+				if (!ReadGUID(Ar, GUIDs, GUID))
+				{
+					return false;
+				}
+			}
+		}
+
+		return !Ar.IsError();
+	}
+}
+
+void FDlgMemory::SaveToBytes(TArray<uint8>& OutBytes, bool bOnlyDirty)
+{
+	FScopeLock Lock(&DirtyCriticalSection);
+	const bool bWriteOnlyDirty = bOnlyDirty && !bNeedsFullSave;
+
+	// The entries first as they fill the GUID table
+	DlgMemorySave::FGUIDTable Table;
+	TArray<uint8> EntriesBytes;
+	{
+		FMemoryWriter Writer(EntriesBytes);
+		uint32 NumEntries = 0;
+		for (const auto& KeyValue : HistoryMap)
+		{
+			NumEntries += !bWriteOnlyDirty || DirtyDialogueGUIDs.Contains(KeyValue.Key) ? 1 : 0;
+		}
+
+		Writer.SerializeIntPacked(NumEntries);
+		for (const auto& KeyValue : HistoryMap)
+		{
+			if (!bWriteOnlyDirty || DirtyDialogueGUIDs.Contains(KeyValue.Key))
+			{
+				DlgMemorySave::WriteHistory(Writer, Table, KeyValue.Key, KeyValue.Value);
+			}
+		}
+	}
+
+	TArray<uint8> Payload;
+	{
+		FMemoryWriter Writer(Payload);
+		uint32 NumGUIDs = Table.GUIDs.Num();
+		Writer.SerializeIntPacked(NumGUIDs);
+		for (FGuid& GUID : Table.GUIDs)
+		{
+			Writer << GUID;
+		}
+		Writer.Serialize(EntriesBytes.GetData(), EntriesBytes.Num());
+	}
+
+	// Compress, keep it as is if that does not help (small saves)
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Payload.Num());
+	TArray<uint8> CompressedPayload;
+	CompressedPayload.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Zlib, CompressedPayload.GetData(), CompressedSize, Payload.GetData(), Payload.Num())
+		|| CompressedSize >= Payload.Num())
+	{
+		CompressedSize = 0;
+	}
+
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+	uint32 Magic = DlgMemorySave::Magic;
+	uint8 Version = DlgMemorySave::LatestVersion;
+	uint8 Flags = bWriteOnlyDirty ? DlgMemorySave::OnlyDirty : DlgMemorySave::None;
+	int32 PayloadSize = Payload.Num();
+	Writer << Magic << Version << Flags << PayloadSize << CompressedSize;
+	if (CompressedSize > 0)
+	{
+		Writer.Serialize(CompressedPayload.GetData(), CompressedSize);
+	}
+	else
+	{
+		Writer.Serialize(Payload.GetData(), Payload.Num());
+	}
+
+	DirtyDialogueGUIDs.Empty();
+	bNeedsFullSave = false;
+}
+
+bool FDlgMemory::LoadFromBytes(const TArray<uint8>& Bytes)
+{
+	FMemoryReader HeaderReader(Bytes);
+	uint32 Magic = 0;
+	uint8 Version = 0;
+	uint8 Flags = 0;
+	int32 PayloadSize = 0;
+	int32 CompressedSize = 0;
+	HeaderReader << Magic << Version << Flags << PayloadSize << CompressedSize;
+	if (HeaderReader.IsError() || Magic != DlgMemorySave::Magic || Version > DlgMemorySave::LatestVersion
+		|| PayloadSize < 0 || CompressedSize < 0)
+	{
+		FDlgLogger::Get().Errorf(TEXT("FDlgMemory::LoadFromBytes - not a dialogue memory save or from a newer version = %d"), Version);
+		return false;
+	}
+
+	const int64 HeaderSize = HeaderReader.Tell();
+	const int32 StoredSize = CompressedSize > 0 ? CompressedSize : PayloadSize;
+	if (HeaderSize + StoredSize > Bytes.Num())
+	{
+		FDlgLogger::Get().Errorf(TEXT("FDlgMemory::LoadFromBytes - the save is truncated"));
+		return false;
+	}
+	if (PayloadSize > DlgMemorySave::MaxPayloadSize
+		|| (CompressedSize > 0 && PayloadSize > CompressedSize * DlgMemorySave::MaxCompressionRatio))
+	{
+		FDlgLogger::Get().Errorf(
+			TEXT("FDlgMemory::LoadFromBytes - the payload size is corrupt = %d (compressed size = %d)"),
+			PayloadSize, CompressedSize
+		);
+		return false;
+	}
+
+	TArray<uint8> Payload;
+	Payload.SetNumUninitialized(PayloadSize);
+	if (CompressedSize > 0)
+	{
+		if (!FCompression::UncompressMemory(NAME_Zlib, Payload.GetData(), PayloadSize, Bytes.GetData() + HeaderSize, CompressedSize))
+		{
+			FDlgLogger::Get().Errorf(TEXT("FDlgMemory::LoadFromBytes - can't decompress the save"));
+			return false;
+		}
+	}
+	else
+	{
+		FMemory::Memcpy(Payload.GetData(), Bytes.GetData() + HeaderSize, PayloadSize);
+	}
+
+	// Read everything before touching the memory
+	FMemoryReader Reader(Payload);
+	TArray<FGuid> GUIDs;
+	uint32 NumGUIDs = 0;
+	if (DlgMemorySave::ReadNum(Reader, NumGUIDs))
+	{
+		GUIDs.SetNum(NumGUIDs);
+		for (FGuid& GUID : GUIDs)
+		{
+			Reader << GUID;
+		}
+	}
+
+	TMap<FGuid, FDlgHistory> LoadedMap;
+	uint32 NumEntries = 0;
+	if (DlgMemorySave::ReadNum(Reader, NumEntries))
+	{
+		LoadedMap.Reserve(NumEntries);
+		for (uint32 Index = 0; Index < NumEntries; Index++)
+		{
+			FGuid DialogueGUID;
+			FDlgHistory History;
+			if (!DlgMemorySave::ReadHistory(Reader, Version, GUIDs, DialogueGUID, History))
+			{
+				break;
+			}
+			LoadedMap.Add(DialogueGUID, MoveTemp(History));
+		}
+	}
+
+	if (Reader.IsError())
+	{
+		FDlgLogger::Get().Errorf(TEXT("FDlgMemory::LoadFromBytes - the save is corrupt"));
+		return false;
+	}
+
+	if (Flags & DlgMemorySave::OnlyDirty)
+	{
+		for (auto& KeyValue : LoadedMap)
+		{
+			HistoryMap.Add(KeyValue.Key, MoveTemp(KeyValue.Value));
+		}
+	}
+	else
+	{
+		HistoryMap = MoveTemp(LoadedMap);
+	}
+
+	// Same as what was saved
+	FScopeLock Lock(&DirtyCriticalSection);
+	DirtyDialogueGUIDs.Empty();
+	bNeedsFullSave = false;
+	return true;
+}
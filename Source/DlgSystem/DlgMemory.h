@@ -2,6 +2,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
 
 #include "DlgMemory.generated.h"
 
@@ -12,11 +14,62 @@ struct DLGSYSTEM_API FDlgNodeSavedData
 {
 	GENERATED_USTRUCT_BODY()
 
+public:
+	// Used by the random selector node, bit N is set if the child edge N was picked in the current cycle
+	bool IsEdgePicked(int32 EdgeIndex) const
+	{
+		const int32 WordIndex = EdgeIndex / 32;
+		return PickedEdgesMask.IsValidIndex(WordIndex) && (PickedEdgesMask[WordIndex] & (1u << (EdgeIndex % 32))) != 0;
+	}
+
+	void SetEdgePicked(int32 EdgeIndex, bool bPicked)
+	{
+		const int32 WordIndex = EdgeIndex / 32;
+		if (WordIndex >= PickedEdgesMask.Num())
+		{
+			PickedEdgesMask.SetNumZeroed(WordIndex + 1);
+		}
+
+		if (bPicked)
+		{
+			PickedEdgesMask[WordIndex] |= 1u << (EdgeIndex % 32);
+		}
+		else
+		{
+			PickedEdgesMask[WordIndex] &= ~(1u << (EdgeIndex % 32));
+		}
+	}
+
+	// Forgets the picked edges but keeps the memory of the mask
+	void ClearPickedEdges()
+	{
+		for (uint32& Word : PickedEdgesMask)
+		{
+			Word = 0;
+		}
+	}
+
 public:
 
-	// used by random selector node to avoid repetition
+	// DEPRECATED: the GUIDs of the nodes picked by the random selector, only read to migrate old saves to PickedEdgesMask
 	UPROPERTY(SaveGame)
 	TArray<FGuid> GUIDList;
+
+	// Used by the random selector node to avoid repetition, one bit for each child edge, see IsEdgePicked
+	UPROPERTY(SaveGame)
+	TArray<uint32> PickedEdgesMask;
+
+	// The child edge picked last time by the random selector
+	UPROPERTY(SaveGame)
+	int32 LastPickedEdgeIndex = INDEX_NONE;
+
+	// Number of children the mask was made for, the mask is reset if the node children changed
+	UPROPERTY(SaveGame)
+	int32 NumEdges = 0;
+
+	// Hash of the GUIDs of the child nodes the mask was made for, the mask is also reset if the children were reordered or replaced
+	UPROPERTY(SaveGame)
+	uint32 EdgesHash = 0;
 };
 
 
@@ -112,12 +165,17 @@ public:
 	}
 
 	// Removes all entries
-	void Empty() { HistoryMap.Empty(); }
+	void Empty()
+	{
+		HistoryMap.Empty();
+		MarkAllDirty();
+	}
 
 	// Adds an entry to the map or overrides an existing one
 	void SetEntry(const FGuid& DialogueGUID, const FDlgHistory& History)
 	{
 		FDlgHistory* OldEntry = HistoryMap.Find(DialogueGUID);
+		MarkDirty(DialogueGUID);
 
 		if (OldEntry == nullptr)
 		{
@@ -130,15 +188,30 @@ public:
 	}
 
 	// Returns the entry for the given name, or nullptr if it does not exist */
-	FDlgHistory* GetEntry(const FGuid& DialogueGUID) { return HistoryMap.Find(DialogueGUID); }
+	// NOTE: call MarkDirty if the entry is modified, otherwise a dirty only save (SaveToBytes) does not have it
+	FDlgHistory* GetEntry(const FGuid& DialogueGUID)
+	{
+		return HistoryMap.Find(DialogueGUID);
+	}
 
-	FDlgHistory& FindOrAddEntry(const FGuid& DialogueGUID) { return HistoryMap.FindOrAdd(DialogueGUID); }
+	FDlgHistory& FindOrAddEntry(const FGuid& DialogueGUID)
+	{
+		MarkDirty(DialogueGUID);
+		return HistoryMap.FindOrAdd(DialogueGUID);
+	}
 
 	void SetNodeVisited(const FGuid& DialogueGUID, int32 NodeIndex, const FGuid& NodeGUID)
 	{
 		// Add it if it does not exist already
 		FDlgHistory& History = HistoryMap.FindOrAdd(DialogueGUID);
+		const int32 NumVisitedBefore = History.VisitedNodeIndices.Num() + History.VisitedNodeGUIDs.Num();
 		History.Add(NodeIndex, NodeGUID);
+
+		// Revisits do not change anything to save
+		if (History.VisitedNodeIndices.Num() + History.VisitedNodeGUIDs.Num() != NumVisitedBefore)
+		{
+			MarkDirty(DialogueGUID);
+		}
 	}
 
 	bool IsNodeVisited(const FGuid& DialogueGUID, int32 NodeIndex, const FGuid& NodeGUID) const
@@ -178,13 +251,66 @@ public:
 	}
 
 	const TMap<FGuid, FDlgHistory>& GetHistoryMaps() const { return HistoryMap; }
-	void SetHistoryMap(const TMap<FGuid, FDlgHistory>& Map) { HistoryMap = Map; }
+	void SetHistoryMap(const TMap<FGuid, FDlgHistory>& Map)
+	{
+		HistoryMap = Map;
+		MarkAllDirty();
+	}
+
+	//
+	// Compact binary save, see DlgMemory.cpp for the layout.
+	// A lot smaller and faster than serializing the HistoryMap with its properties: the GUIDs are written once in a table
+	// and referenced by their varint ordinal, the node indices are delta + varint encoded and everything is compressed.
+	//
+
+	// Writes the whole memory, or only the dialogues changed since the last save if bOnlyDirty is true.
+	// A dirty only save is still a full one if entries were removed or replaced (Empty, SetHistoryMap) since the last save.
+	void SaveToBytes(TArray<uint8>& OutBytes, bool bOnlyDirty = false);
+
+	// A full save replaces the memory, a dirty only save is merged into it, so load the last full save then the dirty only ones after it in order.
+	// Returns false and does not touch the memory if the bytes are not a valid save.
+	bool LoadFromBytes(const TArray<uint8>& Bytes);
+
+	// The dirty tracking is thread safe, the contexts of different dialogues can visit nodes from worker threads (see UDlgSimulateCommandlet)
+	bool HasDirtyDialogues() const
+	{
+		FScopeLock Lock(&DirtyCriticalSection);
+		return bNeedsFullSave || DirtyDialogueGUIDs.Num() > 0;
+	}
+	void MarkDirty(const FGuid& DialogueGUID)
+	{
+		FScopeLock Lock(&DirtyCriticalSection);
+		DirtyDialogueGUIDs.Add(DialogueGUID);
+	}
+
+protected:
+	void MarkAllDirty()
+	{
+		FScopeLock Lock(&DirtyCriticalSection);
+		DirtyDialogueGUIDs.Empty();
+		bNeedsFullSave = true;
+	}
 
 private:
 	 // Key: Dialogue unique identifier GUID
 	 // Value: set of already visited nodes
 	UPROPERTY()
 	TMap<FGuid, FDlgHistory> HistoryMap;
+
+	// Changed since the last SaveToBytes, guarded by DirtyCriticalSection
+	TSet<FGuid> DirtyDialogueGUIDs;
+	bool bNeedsFullSave = false;
+	mutable FCriticalSection DirtyCriticalSection;
+};
+
+template<>
+struct TStructOpsTypeTraits<FDlgMemory> : public TStructOpsTypeTraitsBase2<FDlgMemory>
+{
+	enum
+	{
+		// The singleton is never copied, the critical section can not be
+		WithCopy = false
+	};
 };
 
 template<>
@@ -0,0 +1,23 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgStats.h"
+
+#if DLG_STATS_ENABLED
+
+DEFINE_STAT(STAT_DlgContext_Start);
+DEFINE_STAT(STAT_DlgContext_ChooseOption);
+DEFINE_STAT(STAT_DlgContext_ReevaluateOptions);
+DEFINE_STAT(STAT_DlgContext_EnterNode);
+DEFINE_STAT(STAT_DlgCondition_EvaluateArray);
+DEFINE_STAT(STAT_DlgEvent_Call);
+DEFINE_STAT(STAT_DlgText_Construct);
+
+DEFINE_STAT(STAT_DlgConditionsEvaluated);
+DEFINE_STAT(STAT_DlgEventsFired);
+DEFINE_STAT(STAT_DlgTextsFormatted);
+DEFINE_STAT(STAT_DlgNodesEntered);
+
+#if NY_ENGINE_VERSION >= 426
+UE_TRACE_CHANNEL_DEFINE(DlgSystemChannel);
+#endif
+
+#endif // DLG_STATS_ENABLED
@@ -0,0 +1,59 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+#include "NYEngineVersionHelpers.h"
+
+// Profiling markers of the dialogue runtime hot path, shown with `stat DlgSystem` and in Unreal Insights (`-trace=cpu,DlgSystem`)
+// Compiled out in shipping, define DLG_STATS_ENABLED in the Build.cs to override
+#ifndef DLG_STATS_ENABLED
+	#define DLG_STATS_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+#if DLG_STATS_ENABLED
+
+// TRACE_CPUPROFILER_EVENT_SCOPE exists since 4.25, the trace channels since 4.26
+#if NY_ENGINE_VERSION >= 425
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#endif
+#if NY_ENGINE_VERSION >= 426
+#include "Trace/Trace.h"
+#endif
+
+DECLARE_STATS_GROUP(TEXT("Dialogue System"), STATGROUP_DlgSystem, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Context Start"), STAT_DlgContext_Start, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Context ChooseOption"), STAT_DlgContext_ChooseOption, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Context ReevaluateOptions"), STAT_DlgContext_ReevaluateOptions, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Context EnterNode"), STAT_DlgContext_EnterNode, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Condition EvaluateArray"), STAT_DlgCondition_EvaluateArray, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Event Call"), STAT_DlgEvent_Call, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Text Construct"), STAT_DlgText_Construct, STATGROUP_DlgSystem, DLGSYSTEM_API);
+
+// Per frame counters
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Conditions Evaluated"), STAT_DlgConditionsEvaluated, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Fired"), STAT_DlgEventsFired, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Texts Formatted"), STAT_DlgTextsFormatted, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes Entered"), STAT_DlgNodesEntered, STATGROUP_DlgSystem, DLGSYSTEM_API);
+
+#if NY_ENGINE_VERSION >= 426
+	UE_TRACE_CHANNEL_EXTERN(DlgSystemChannel, DLGSYSTEM_API);
+	#define DLG_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, DlgSystemChannel)
+#elif NY_ENGINE_VERSION >= 425
+	#define DLG_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE(Name)
+#else
+	#define DLG_TRACE_SCOPE(Name)
+#endif
+
+// Times the rest of the scope in the stat and in the trace
+#define DLG_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat); DLG_TRACE_SCOPE(Stat)
+#define DLG_INC_COUNTER(Stat) INC_DWORD_STAT(Stat)
+
+#else
+
+#define DLG_SCOPE_CYCLE_COUNTER(Stat)
+#define DLG_INC_COUNTER(Stat)
+
+#endif // DLG_STATS_ENABLED
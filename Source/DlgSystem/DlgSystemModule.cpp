@@ -26,6 +26,7 @@
 #include "GameplayDebugger/DlgGameplayDebuggerCategory.h"
 #include "GameplayDebugger/SDlgDataDisplay.h"
 #include "Logging/DlgLogger.h"
+#include "IO/DlgClassNameIndex.h"
 #include "DlgHelper.h"
 
 #define LOCTEXT_NAMESPACE "FDlgSystemModule"
@@ -37,6 +38,7 @@ DEFINE_LOG_CATEGORY(LogDlgSystem)
 void FDlgSystemModule::StartupModule()
 {
 	FDlgLogger::OnStart();
+	FDlgClassNameIndex::OnStart();
 
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 	FDlgLogger::Get().Info(TEXT("DlgSystemModule: StartupModule"));
@@ -139,6 +141,7 @@ void FDlgSystemModule::ShutdownModule()
 		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(OnPostLoadMapWithWorldHandle);
 	}
 
+	FDlgClassNameIndex::OnShutdown();
 	FDlgLogger::Get().Info(TEXT("DlgSystemModule: ShutdownModule"));
 	FDlgLogger::OnShutdown();
 }
@@ -144,6 +144,9 @@ FString UDlgSystemSettings::GetTextFileExtension(EDlgDialogueTextFormat TextForm
 		case EDlgDialogueTextFormat::DialogueDEPRECATED:
 			return TEXT(".dlg");
 
+		case EDlgDialogueTextFormat::Binary:
+			return TEXT(".dlg.bin");
+
 		// Empty
 		case EDlgDialogueTextFormat::None:
 		default:
@@ -40,6 +40,9 @@ enum class EDlgDialogueTextFormat : uint8
 	// The JSON format.
 	JSON				UMETA(DisplayName = "JSON"),
 
+	// Compact binary format, not human readable but a lot faster to read. Useful for build pipelines and tools.
+	Binary				UMETA(DisplayName = "Binary"),
+
 	// Hidden, represents the number of text formats */
 	NumTextFormats 		UMETA(Hidden),
 };
@@ -197,6 +200,10 @@ public:
 	FORCEINLINE const FText& GetTextRemappedText(const FText& Text) const { return GetSourceStringRemappedText(*FTextInspector::GetSourceString(Text)); }
 	FORCEINLINE const FText& GetSourceStringRemappedText(const FString& SourceString) const { return LocalizationRemapSourceStringsToTexts.FindChecked(SourceString); }
 
+	// Does the context walk the nodes reachable from the active one when a node is entered, see PrefetchReachableNodeAssets.
+	// The default of each context, UDlgContext::SetPrefetchReachableNodes overrides it
+	bool ShouldPrefetchReachableNodes() const { return bPrefetchVoices || bCookNodeAssetsAsSoftReferences; }
+
 	// Saves the settings to the config file depending on the settings of this class.
 	void SaveSettings()
 	{
@@ -261,6 +268,47 @@ public:
 	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
 	EDlgNoSatisfiedChildBehavior NoSatisfiedChildBehavior;
 
+	// Opt-in: the options of an entered node (and of ReevaluateOptions) are evaluated over the next frames under OptionsEvaluationBudgetMilliseconds
+	// instead of all at once, so that nodes with many heavy conditions do not spike the frame.
+	// The options are empty until the evaluation finishes, bind UDlgContext::OnOptionsEvaluated to know when they are ready.
+	// Choosing an option meanwhile finishes the evaluation first. Can be overridden per context.
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	bool bTimeSliceOptionsEvaluation = false;
+
+	// Time spent evaluating options per frame with bTimeSliceOptionsEvaluation, at least one option is evaluated each frame
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (EditCondition = "bTimeSliceOptionsEvaluation", ClampMin = "0.01", UIMin = "0.01", Units = "ms"))
+	float OptionsEvaluationBudgetMilliseconds = 1.f;
+
+	// Primes the first streamed chunk of the voices of the nodes reachable from the active node each time a node is entered,
+	// so that the next lines start playing without waiting for audio streaming
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	bool bPrefetchVoices = false;
+
+	// Cooks the voices and the generic data of the speech nodes as soft references, so loading a dialogue does not load all of them.
+	// The context loads them asynchronously (on the game thread) for the nodes up to VoicePrefetchDepth steps from the active node,
+	// a node entered before that finished loads them synchronously. The editor keeps the hard references.
+	// The node data is instanced inside the dialogue so it is not affected.
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	bool bCookNodeAssetsAsSoftReferences = false;
+
+	// Strips what the runtime does not need from the cooked dialogues: the deprecated properties, the variable/event/class names
+	// gathered per participant for the editor (the participants are kept) and the node GUID map, which is rebuilt on load.
+	// The participant name getters of the dialogue return empty sets in the cooked build then. The editor assets are not changed.
+	// Run the DlgStats commandlet to see how many bytes it saves per dialogue.
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	bool bStripDialoguesOnCook = false;
+
+	// How many steps from the active node are prefetched. The first step only goes through the satisfied options,
+	// the deeper ones through all the edges as their conditions depend on what happens until then
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (EditCondition = "bPrefetchVoices || bCookNodeAssetsAsSoftReferences", ClampMin = "1", UIMin = "1", UIMax = "5"))
+	int32 VoicePrefetchDepth = 2;
+
+	// Limits how many voices are primed each time a node is entered, the nearest nodes are primed first.
+	// Each voice counts with its full estimated size, not with the first chunk that priming actually loads,
+	// so this is not the streaming memory used: longer voices take more of the cap.
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (EditCondition = "bPrefetchVoices", ClampMin = "0", Units = "KB"))
+	int32 VoicePrefetchTotalSizeCapKB = 4096;
+
 
 	// The dialogue text format used for saving and reloading from text files.
 	UPROPERTY(Category = "Dialogue", Config, EditAnywhere, DisplayName = "Text Format")
@@ -398,11 +446,27 @@ public:
 	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay)
 	ENYLoggerLogLevel OpenMessageLogLevelsHigherThan = ENYLoggerLogLevel::NoLogging;
 
+	// The errors/warnings that broken content can trigger every frame (conditions, text arguments, events, context)
+	// are logged at most once per this many seconds for the same dialogue context, counting the skipped ones. 0 disables the limit.
+	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay, meta = (ClampMin = "0", Units = "s"))
+	float LogRateLimitSeconds = 1.f;
+
+	// Writes to the output log from a background task instead of the calling thread
+	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay)
+	bool bAsyncOutputLog = false;
+
 
 	// Should we hide the categories in the Dialogue browser that do not have any children?
 	UPROPERTY(Category = "Browser", Config, EditAnywhere)
 	bool bHideEmptyDialogueBrowserCategories = true;
 
+	// How often (in seconds) the Dialogue Data Display updates the property values from the actors and applies the
+	// changes notified since the last update (UDlgManager::NotifyParticipantChanged, the started dialogues and the loaded dialogues).
+	// Only the changed actors are rebuilt, the full rescan happens on Refresh or when the world changes.
+	// 0 disables the automatic updates, use the Refresh button instead.
+	UPROPERTY(Category = "Data Display", Config, EditAnywhere, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float DataDisplayRefreshIntervalSeconds = 1.f;
+
 
 	//
 	// External URLs
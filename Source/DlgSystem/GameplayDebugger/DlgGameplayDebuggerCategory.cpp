@@ -2,26 +2,165 @@
 #if WITH_GAMEPLAY_DEBUGGER
 #include "DlgGameplayDebuggerCategory.h"
 
-#include "DlgSystem/DlgManager.h"
+#include "UObject/UObjectHash.h"
+#include "GameFramework/Actor.h"
+
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/Nodes/DlgNode.h"
+
+void FDlgContextDataToPrint::Serialize(FArchive& Ar)
+{
+	Ar << DialogueName;
+	Ar << ActiveNode;
+	Ar << NumSteps;
+	Ar << LastStepMilliseconds;
+	Ar << MaxStepMilliseconds;
+	Ar << AverageStepMilliseconds;
+	Ar << NumConditionsEvaluated;
+	Ar << LastStepNumConditionsEvaluated;
+	Ar << NumEventsFired;
+	Ar << LastStepNumEventsFired;
+	Ar << NumNodesEntered;
+	Ar << LastStepNumNodesEntered;
+	Ar << NumTextsFormatted;
+	Ar << LastStepNumTextsFormatted;
+	Ar << AllocatedBytes;
+}
+
+void FDlgDataToPrint::Serialize(FArchive& Ar)
+{
+	Ar << NumLoadedDialogues;
+	Ar << NumActiveContexts;
+	Ar << DebugActorName;
+
+	int32 NumContexts = DebugActorContexts.Num();
+	Ar << NumContexts;
+	if (Ar.IsLoading())
+	{
+		DebugActorContexts.SetNum(NumContexts);
+	}
+	for (FDlgContextDataToPrint& ContextData : DebugActorContexts)
+	{
+		ContextData.Serialize(Ar);
+	}
+}
 
 FDlgGameplayDebuggerCategory::FDlgGameplayDebuggerCategory()
 {
 	bShowOnlyWithDebugActor = false;
+
+	// Only the data pack is replicated, and only when it changed
+	CollectDataInterval = 0.5f;
+	SetDataPackReplication<FDlgDataToPrint>(&Data);
 }
 
 void FDlgGameplayDebuggerCategory::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
 {
-	Data.NumLoadedDialogues = UDlgManager::GetAllDialoguesFromMemory().Num();
+	// Uses the object hash of the class instead of iterating all the objects
+	TArray<UObject*> Objects;
+	GetObjectsOfClass(UDlgDialogue::StaticClass(), Objects, true, RF_ClassDefaultObject);
+	Data.NumLoadedDialogues = Objects.Num();
+
+	Objects.Reset();
+	GetObjectsOfClass(UDlgContext::StaticClass(), Objects, true, RF_ClassDefaultObject);
 
-	if (DebugActor)
+	Data.NumActiveContexts = 0;
+	Data.DebugActorName = IsValid(DebugActor) ? DebugActor->GetName() : FString();
+	Data.DebugActorContexts.Reset();
+	for (const UObject* Object : Objects)
 	{
+		const UDlgContext* Context = Cast<UDlgContext>(Object);
+		if (!IsValid(Context) || Context->HasDialogueEnded() || !IsValid(Context->GetDialogue()))
+		{
+			continue;
+		}
+		Data.NumActiveContexts++;
+
+		if (!IsValid(DebugActor))
+		{
+			continue;
+		}
 
+		for (const auto& Elem : Context->GetParticipantsMap())
+		{
+			if (Elem.Value == DebugActor)
+			{
+				Data.DebugActorContexts.Add(CollectContextData(*Context));
+				break;
+			}
+		}
 	}
 }
 
+FDlgContextDataToPrint FDlgGameplayDebuggerCategory::CollectContextData(const UDlgContext& Context)
+{
+	FDlgContextDataToPrint ContextData;
+	ContextData.DialogueName = Context.GetDialogue()->GetName();
+
+	// Index, type and the start of the text
+	static constexpr int32 MaxTextLength = 40;
+	if (const UDlgNode* Node = Context.GetActiveNode())
+	{
+		FString Text = Node->GetNodeText().ToString().Replace(TEXT("\n"), TEXT(" "));
+		if (Text.Len() > MaxTextLength)
+		{
+			Text = Text.Left(MaxTextLength) + TEXT("...");
+		}
+		ContextData.ActiveNode = FString::Printf(TEXT("%d %s `%s`"), Context.GetActiveNodeIndex(), *Node->GetClass()->GetName(), *Text);
+	}
+	else
+	{
+		ContextData.ActiveNode = FString::Printf(TEXT("%d INVALID"), Context.GetActiveNodeIndex());
+	}
+
+	const FDlgContextMetrics& Metrics = Context.GetMetrics();
+	ContextData.NumSteps = Metrics.NumSteps;
+	ContextData.LastStepMilliseconds = Metrics.LastStepMilliseconds;
+	ContextData.MaxStepMilliseconds = Metrics.MaxStepMilliseconds;
+	ContextData.AverageStepMilliseconds = Metrics.GetAverageStepMilliseconds();
+	ContextData.NumConditionsEvaluated = Metrics.NumConditionsEvaluated;
+	ContextData.LastStepNumConditionsEvaluated = Metrics.LastStepNumConditionsEvaluated;
+	ContextData.NumEventsFired = Metrics.NumEventsFired;
+	ContextData.LastStepNumEventsFired = Metrics.LastStepNumEventsFired;
+	ContextData.NumNodesEntered = Metrics.NumNodesEntered;
+	ContextData.LastStepNumNodesEntered = Metrics.LastStepNumNodesEntered;
+	ContextData.NumTextsFormatted = Metrics.NumTextsFormatted;
+	ContextData.LastStepNumTextsFormatted = Metrics.LastStepNumTextsFormatted;
+	ContextData.AllocatedBytes = static_cast<int32>(Context.GetAllocatedSize());
+	return ContextData;
+}
+
 void FDlgGameplayDebuggerCategory::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
 {
 	CanvasContext.Printf(TEXT("{green}Number loaded Dialogues: %s"), *FString::FromInt(Data.NumLoadedDialogues));
+	CanvasContext.Printf(TEXT("{green}Number active Dialogue Contexts: %s"), *FString::FromInt(Data.NumActiveContexts));
+
+	if (Data.DebugActorName.IsEmpty())
+	{
+		return;
+	}
+
+	CanvasContext.Printf(TEXT("{white}Active Dialogue Contexts of {yellow}%s{white}: %d"), *Data.DebugActorName, Data.DebugActorContexts.Num());
+	for (const FDlgContextDataToPrint& ContextData : Data.DebugActorContexts)
+	{
+		CanvasContext.Printf(TEXT("{yellow}%s {white}Active Node: %s"), *ContextData.DialogueName, *ContextData.ActiveNode);
+		CanvasContext.Printf(
+			TEXT("\t{white}Steps: %d, Step Time: last {yellow}%.3f ms{white}, max %.3f ms, avg %.3f ms"),
+			ContextData.NumSteps, ContextData.LastStepMilliseconds, ContextData.MaxStepMilliseconds, ContextData.AverageStepMilliseconds
+		);
+		CanvasContext.Printf(
+			TEXT("\t{white}Conditions Evaluated: last step %d, total %d | Events Fired: last step %d, total %d"),
+			ContextData.LastStepNumConditionsEvaluated, ContextData.NumConditionsEvaluated,
+			ContextData.LastStepNumEventsFired, ContextData.NumEventsFired
+		);
+		CanvasContext.Printf(
+			TEXT("\t{white}Nodes Entered: last step %d, total %d | Texts Formatted: last step %d, total %d | Allocated: %d bytes"),
+			ContextData.LastStepNumNodesEntered, ContextData.NumNodesEntered,
+			ContextData.LastStepNumTextsFormatted, ContextData.NumTextsFormatted,
+			ContextData.AllocatedBytes
+		);
+	}
 }
 
 #endif // WITH_GAMEPLAY_DEBUGGER
@@ -8,11 +8,46 @@
 class AActor;
 class APlayerController;
 class FGameplayDebuggerCanvasContext;
+class UDlgContext;
 
-// The data we're going to print inside the viewport
+// The metrics of one active context of the debug actor, see FDlgContextMetrics
+struct DLGSYSTEM_API FDlgContextDataToPrint
+{
+	FString DialogueName;
+	FString ActiveNode;
+
+	int32 NumSteps = 0;
+	float LastStepMilliseconds = 0.f;
+	float MaxStepMilliseconds = 0.f;
+	float AverageStepMilliseconds = 0.f;
+
+	int32 NumConditionsEvaluated = 0;
+	int32 LastStepNumConditionsEvaluated = 0;
+	int32 NumEventsFired = 0;
+	int32 LastStepNumEventsFired = 0;
+	int32 NumNodesEntered = 0;
+	int32 LastStepNumNodesEntered = 0;
+	int32 NumTextsFormatted = 0;
+	int32 LastStepNumTextsFormatted = 0;
+
+	// See UDlgContext::GetAllocatedSize
+	int32 AllocatedBytes = 0;
+
+	void Serialize(FArchive& Ar);
+};
+
+// The data we're going to print inside the viewport, collected on the server and replicated as the category data pack
 struct DLGSYSTEM_API FDlgDataToPrint
 {
 	int32 NumLoadedDialogues = 0;
+
+	// All the contexts that did not end yet, not only the ones of the debug actor
+	int32 NumActiveContexts = 0;
+
+	FString DebugActorName;
+	TArray<FDlgContextDataToPrint> DebugActorContexts;
+
+	void Serialize(FArchive& Ar);
 };
 
 class DLGSYSTEM_API FDlgGameplayDebuggerCategory : public FGameplayDebuggerCategory
@@ -34,6 +69,9 @@ public:
 	/** Displays the data we collected in the CollectData function */
 	void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
 
+protected:
+	static FDlgContextDataToPrint CollectContextData(const UDlgContext& Context);
+
 protected:
 	// The data that we're going to print
 	FDlgDataToPrint Data;
@@ -14,6 +14,7 @@
 
 #include "DlgSystem/DlgManager.h"
 #include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgSystemSettings.h"
 #include "SDlgDataPropertyValues.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 
@@ -98,9 +99,33 @@ void SDlgDataDisplay::Construct(const FArguments& InArgs, const TWeakObjectPtr<c
 		]
 	];
 
+	ParticipantChangedHandle = UDlgManager::OnParticipantChanged().AddSP(this, &Self::HandleParticipantChanged);
+	DialogueLoadedHandle = UDlgManager::OnDialogueLoaded().AddSP(this, &Self::HandleDialogueLoaded);
 	RefreshTree(false);
 }
 
+SDlgDataDisplay::~SDlgDataDisplay()
+{
+	UDlgManager::OnParticipantChanged().Remove(ParticipantChangedHandle);
+	UDlgManager::OnDialogueLoaded().Remove(DialogueLoadedHandle);
+}
+
+void SDlgDataDisplay::Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// Only pick up the changes after the refresh interval has passed
+	const float RefreshIntervalSeconds = GetDefault<UDlgSystemSettings>()->DataDisplayRefreshIntervalSeconds;
+	TickPassedDeltaTimeSeconds += InDeltaTime;
+	if (RefreshIntervalSeconds <= 0.f || TickPassedDeltaTimeSeconds < RefreshIntervalSeconds)
+	{
+		return;
+	}
+
+	TickPassedDeltaTimeSeconds = 0.f;
+	RefreshChangedActors();
+}
+
 void SDlgDataDisplay::RefreshTree(bool bPreserveExpansion)
 {
 	// First, save off current expansion state
@@ -113,17 +138,14 @@ void SDlgDataDisplay::RefreshTree(bool bPreserveExpansion)
 	RootTreeItem->ClearChildren();
 	RootChildren.Empty();
 	ActorsProperties.Empty();
+	ActorsNodes.Empty();
+	ActorsParticipantTags.Empty();
+	ChangedParticipants.Empty();
+	LoadedDialogues.Empty();
+	TickPassedDeltaTimeSeconds = 0.f;
 
-	// Try the actor World
-	UWorld* World = WorldContextObjectPtr.IsValid() ? WorldContextObjectPtr->GetWorld() : nullptr;
-
-// 	// Try The Editor World
-// #if WITH_EDITOR
-// 	if (World == nullptr && GEditor)
-// 	{
-// 		World = GEditor->GetEditorWorldContext().World();
-// 	}
-// #endif
+	UWorld* World = GetWorld();
+	RefreshedWorld = World;
 
 	// Can't do anything without the world
 	if (!IsValid(World))
@@ -136,186 +158,321 @@ void SDlgDataDisplay::RefreshTree(bool bPreserveExpansion)
 		return;
 	}
 
-	const TArray<UDlgDialogue*> Dialogues = UDlgManager::GetAllDialoguesFromMemory();
+	// From now on only the notified participants and dialogues are updated, see RefreshChangedActors
+	BuildParticipantTagsDialoguesMap();
+
+	// Build the fast lookup structure for Actors (the ActorsProperties) and the Actors Tree View (aka the actual tree)
 	const TArray<TWeakObjectPtr<AActor>> Actors = UDlgManager::GetAllWeakActorsWithDialogueParticipantInterface(World);
+	for (const TWeakObjectPtr<AActor>& Actor : Actors)
+	{
+		if (!Actor.IsValid())
+		{
+			continue;
+		}
+
+		// Should never happen, the actor should always be unique in the Actors array.
+		ensure(ActorsProperties.Find(Actor) == nullptr);
+		AddActor(Actor.Get());
+	}
+	RootChildren = RootTreeItem->GetChildren();
 
-	// Build fast lookup for ParticipantNames
-	// Maps from ParticipantName => Array of Dialogues that have this Participant.
-	TMap<FGameplayTag, TSet<TWeakObjectPtr<const UDlgDialogue>>> ParticipantTagsDialoguesMap;
-	for (const UDlgDialogue* Dialogue : Dialogues)
+	// Clear Previous states
+	ActorsTreeView->ClearSelection();
+	// Triggers RequestTreeRefresh
+	ActorsTreeView->ClearExpandedItems();
+
+	// Restore old Expansion
+	if (bPreserveExpansion && OldExpansionState.Num() > 0)
 	{
-		const FGameplayTagContainer ParticipantsTags = Dialogue->GetParticipantTags();
+		// Flattened tree
+		TArray<TSharedPtr<FDlgDataDisplayTreeNode>> AllNodes;
+		RootTreeItem->GetAllNodes(AllNodes);
 
-		for (const FGameplayTag& ParticipantTag : ParticipantsTags)
+		// Expand to match the old state
+		FDlgTreeViewHelper::RestoreTreeExpansionState<TSharedPtr<FDlgDataDisplayTreeNode>>(ActorsTreeView,
+			AllNodes, OldExpansionState, Self::PredicateCompareDlgDataDisplayTreeNode);
+	}
+}
+
+void SDlgDataDisplay::RefreshChangedActors()
+{
+	// No world yet, only the Refresh button logs this as an error
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		return;
+	}
+
+	// New world (new PIE session, new map), everything is stale
+	if (World != RefreshedWorld.Get())
+	{
+		RefreshTree(true);
+		return;
+	}
+
+	// Remove the destroyed actors, only the weak pointers are checked, nothing is called on the participants
+	bool bChanged = false;
+	TArray<TWeakObjectPtr<AActor>> ActorsToRemove;
+	for (const auto& Elem : ActorsParticipantTags)
+	{
+		if (!Elem.Key.IsValid())
 		{
-			TSet<TWeakObjectPtr<const UDlgDialogue>>* ValuePtr = ParticipantTagsDialoguesMap.Find(ParticipantTag);
-			if (ValuePtr == nullptr)
+			ActorsToRemove.Add(Elem.Key);
+		}
+	}
+
+	// The dialogues loaded since the last refresh, the actors with their participants are rebuilt
+	TSet<FGameplayTag> ChangedParticipantTags;
+	for (const TWeakObjectPtr<const UDlgDialogue>& Dialogue : LoadedDialogues)
+	{
+		if (Dialogue.IsValid())
+		{
+			for (const FGameplayTag& ParticipantTag : Dialogue->GetParticipantTags())
 			{
-				// does not exist
-				TSet<TWeakObjectPtr<const UDlgDialogue>> ValueArray{Dialogue};
-				ParticipantTagsDialoguesMap.Add(ParticipantTag, ValueArray);
+				ParticipantTagsDialoguesMap.FindOrAdd(ParticipantTag).Add(Dialogue);
+				ChangedParticipantTags.Add(ParticipantTag);
 			}
-			else
+		}
+	}
+	LoadedDialogues.Empty();
+
+	TArray<TWeakObjectPtr<AActor>> ActorsToAdd;
+	if (ChangedParticipantTags.Num() > 0)
+	{
+		for (const auto& Elem : ActorsParticipantTags)
+		{
+			if (Elem.Key.IsValid() && ChangedParticipantTags.Contains(Elem.Value))
 			{
-				// exists, add the Dialogue
-				ValuePtr->Add(Dialogue);
+				ActorsToRemove.Add(Elem.Key);
+				ActorsToAdd.Add(Elem.Key);
 			}
 		}
 	}
 
-	// Build the fast lookup structure for Actors (the ActorsProperties)
-	for (TWeakObjectPtr<AActor> Actor : Actors)
+	// The notified participants, new ones are added and the ones whose participant tag changed are rebuilt
+	for (const TWeakObjectPtr<AActor>& Actor : ChangedParticipants)
 	{
 		if (!Actor.IsValid())
 		{
-			return;
+			continue;
 		}
 
-		// Should never happen, the actor should always be unique in the Actors array.
-		ensure(ActorsProperties.Find(Actor) == nullptr);
+		const FGameplayTag* ParticipantTag = ActorsParticipantTags.Find(Actor);
+		if (ParticipantTag == nullptr)
+		{
+			ActorsToAdd.Add(Actor);
+		}
+		else if (*ParticipantTag != IDlgDialogueParticipant::Execute_GetParticipantTag(Actor.Get()))
+		{
+			ActorsToRemove.Add(Actor);
+			ActorsToAdd.Add(Actor);
+		}
+	}
+	ChangedParticipants.Empty();
 
-		// Find out the Dialogues that have the ParticipantName of this Actor.
-		const FGameplayTag ParticipantTag = IDlgDialogueParticipant::Execute_GetParticipantTag(Actor.Get());
-		TSet<TWeakObjectPtr<const UDlgDialogue>> ActorDialogues;
-		TSet<TWeakObjectPtr<const UDlgDialogue>>* ActorDialoguesPtr = ParticipantTagsDialoguesMap.Find(ParticipantTag);
-		if (ActorDialoguesPtr != nullptr)
+	for (const TWeakObjectPtr<AActor>& Actor : ActorsToRemove)
+	{
+		RemoveActor(Actor);
+		bChanged = true;
+	}
+	for (const TWeakObjectPtr<AActor>& Actor : ActorsToAdd)
+	{
+		if (Actor.IsValid() && !ActorsProperties.Contains(Actor))
 		{
-			// Found some dialogue
-			ActorDialogues = *ActorDialoguesPtr;
+			AddActor(Actor.Get());
+			bChanged = true;
 		}
+	}
+
+	if (!bChanged)
+	{
+		return;
+	}
+
+	// Only the root children changed, the expansion of the existing nodes is kept
+	if (FilterString.IsEmpty())
+	{
+		RootChildren = RootTreeItem->GetChildren();
+		ActorsTreeView->RequestTreeRefresh();
+	}
+	else
+	{
+		GenerateFilteredItems();
+	}
+}
+
+UWorld* SDlgDataDisplay::GetWorld() const
+{
+	// Try the actor World
+	UWorld* World = WorldContextObjectPtr.IsValid() ? WorldContextObjectPtr->GetWorld() : nullptr;
 
-		// Create Key in the ActorsProperties for this Actor.
-		TSharedPtr<FDlgDataDisplayActorProperties> ActorsPropertiesValue =
-			MakeShared<FDlgDataDisplayActorProperties>(ActorDialogues);
-		ActorsProperties.Add(Actor, ActorsPropertiesValue);
+// 	// Try The Editor World
+// #if WITH_EDITOR
+// 	if (World == nullptr && GEditor)
+// 	{
+// 		World = GEditor->GetEditorWorldContext().World();
+// 	}
+// #endif
 
-		// Gather Data from the Dialogues
-		for (TWeakObjectPtr<const UDlgDialogue> Dialogue : ActorDialogues)
+	return World;
+}
+
+void SDlgDataDisplay::HandleParticipantChanged(UObject* Participant)
+{
+	// Only the actors of our world are displayed, the participant tag might not be set yet so it is read on the next RefreshChangedActors
+	AActor* Actor = Cast<AActor>(Participant);
+	if (IsValid(Actor) && Actor->GetWorld() == RefreshedWorld.Get()
+		&& Actor->GetClass()->ImplementsInterface(UDlgDialogueParticipant::StaticClass()))
+	{
+		ChangedParticipants.Add(Actor);
+	}
+}
+
+void SDlgDataDisplay::HandleDialogueLoaded(UDlgDialogue* Dialogue)
+{
+	LoadedDialogues.Add(Dialogue);
+}
+
+void SDlgDataDisplay::BuildParticipantTagsDialoguesMap()
+{
+	ParticipantTagsDialoguesMap.Empty();
+	for (const UDlgDialogue* Dialogue : UDlgManager::GetAllDialoguesFromMemory())
+	{
+		const FGameplayTagContainer ParticipantsTags = Dialogue->GetParticipantTags();
+		for (const FGameplayTag& ParticipantTag : ParticipantsTags)
 		{
-			if (!Dialogue.IsValid())
-			{
-				return;
-			}
+			ParticipantTagsDialoguesMap.FindOrAdd(ParticipantTag).Add(Dialogue);
+		}
+	}
+}
 
-			// Populate Event Names
-			const TSet<FName> EventsNames = Dialogue->GetParticipantEventNames(ParticipantTag);
-			for (const FName& EventName : EventsNames)
-			{
-				ActorsPropertiesValue->AddDialogueToEvent(EventName, Dialogue);
-			}
+void SDlgDataDisplay::AddActor(AActor* Actor)
+{
+	// Find out the Dialogues that have the ParticipantName of this Actor.
+	const FGameplayTag ParticipantTag = IDlgDialogueParticipant::Execute_GetParticipantTag(Actor);
+	TSet<TWeakObjectPtr<const UDlgDialogue>> ActorDialogues;
+	if (const TSet<TWeakObjectPtr<const UDlgDialogue>>* ActorDialoguesPtr = ParticipantTagsDialoguesMap.Find(ParticipantTag))
+	{
+		// Found some dialogue
+		ActorDialogues = *ActorDialoguesPtr;
+	}
 
-			// Populate Unreal Function Names
-			const TSet<FName> FunctionNames = Dialogue->GetParticipantFunctionNames(ParticipantTag);
-			for (const FName& FunctionName : FunctionNames)
-			{
-				ActorsPropertiesValue->AddDialogueToUnrealFunction(FunctionName, Dialogue);
-			}
+	// Create Key in the ActorsProperties for this Actor.
+	TSharedPtr<FDlgDataDisplayActorProperties> ActorsPropertiesValue =
+		MakeShared<FDlgDataDisplayActorProperties>(ActorDialogues);
+	ActorsProperties.Add(Actor, ActorsPropertiesValue);
+	ActorsParticipantTags.Add(Actor, ParticipantTag);
 
-			// Populate conditions
-			const TSet<FName> ConditionNames = Dialogue->GetParticipantConditionNames(ParticipantTag);
-			for (const FName& ConditionName : ConditionNames)
-			{
-				ActorsPropertiesValue->AddDialogueToCondition(ConditionName, Dialogue);
-			}
+	// Gather Data from the Dialogues
+	for (TWeakObjectPtr<const UDlgDialogue> Dialogue : ActorDialogues)
+	{
+		if (!Dialogue.IsValid())
+		{
+			continue;
+		}
 
-			// Populate int variable names
-			const TSet<FName> IntVariableNames = Dialogue->GetParticipantIntNames(ParticipantTag);
-			for (const FName& IntVariableName : IntVariableNames)
-			{
-				ActorsPropertiesValue->AddDialogueToIntVariable(IntVariableName, Dialogue);
-			}
+		// Populate Event Names
+		const TSet<FName> EventsNames = Dialogue->GetParticipantEventNames(ParticipantTag);
+		for (const FName& EventName : EventsNames)
+		{
+			ActorsPropertiesValue->AddDialogueToEvent(EventName, Dialogue);
+		}
 
-			// Populate float variable names
-			const TSet<FName> FloatVariableNames = Dialogue->GetParticipantFloatNames(ParticipantTag);
-			for (const FName& FloatVariableName : FloatVariableNames)
-			{
-				ActorsPropertiesValue->AddDialogueToFloatVariable(FloatVariableName, Dialogue);
-			}
+		// Populate Unreal Function Names
+		const TSet<FName> FunctionNames = Dialogue->GetParticipantFunctionNames(ParticipantTag);
+		for (const FName& FunctionName : FunctionNames)
+		{
+			ActorsPropertiesValue->AddDialogueToUnrealFunction(FunctionName, Dialogue);
+		}
 
-			// Populate bool variable names
-			const TSet<FName> BoolVariableNames = Dialogue->GetParticipantBoolNames(ParticipantTag);
-			for (const FName& BoolVariableName : BoolVariableNames)
-			{
-				ActorsPropertiesValue->AddDialogueToBoolVariable(BoolVariableName, Dialogue);
-			}
+		// Populate conditions
+		const TSet<FName> ConditionNames = Dialogue->GetParticipantConditionNames(ParticipantTag);
+		for (const FName& ConditionName : ConditionNames)
+		{
+			ActorsPropertiesValue->AddDialogueToCondition(ConditionName, Dialogue);
+		}
 
-			// Populate FName variable names
-			const TSet<FName> FNameVariableNames = Dialogue->GetParticipantFNameNames(ParticipantTag);
-			for (const FName& NameVariableName : FNameVariableNames)
-			{
-				ActorsPropertiesValue->AddDialogueToFNameVariable(NameVariableName, Dialogue);
-			}
+		// Populate int variable names
+		const TSet<FName> IntVariableNames = Dialogue->GetParticipantIntNames(ParticipantTag);
+		for (const FName& IntVariableName : IntVariableNames)
+		{
+			ActorsPropertiesValue->AddDialogueToIntVariable(IntVariableName, Dialogue);
+		}
 
-			// Populate UClass int variable names
-			const TSet<FName> ClassIntVariableNames = Dialogue->GetParticipantClassIntNames(ParticipantTag);
-			for (const FName& IntVariableName : ClassIntVariableNames)
-			{
-				ActorsPropertiesValue->AddDialogueToClassIntVariable(IntVariableName, Dialogue);
-			}
+		// Populate float variable names
+		const TSet<FName> FloatVariableNames = Dialogue->GetParticipantFloatNames(ParticipantTag);
+		for (const FName& FloatVariableName : FloatVariableNames)
+		{
+			ActorsPropertiesValue->AddDialogueToFloatVariable(FloatVariableName, Dialogue);
+		}
 
-			// Populate UClass float variable names
-			const TSet<FName> ClassFloatVariableNames = Dialogue->GetParticipantClassFloatNames(ParticipantTag);
-			for (const FName& FloatVariableName : ClassFloatVariableNames)
-			{
-				ActorsPropertiesValue->AddDialogueToClassFloatVariable(FloatVariableName, Dialogue);
-			}
+		// Populate bool variable names
+		const TSet<FName> BoolVariableNames = Dialogue->GetParticipantBoolNames(ParticipantTag);
+		for (const FName& BoolVariableName : BoolVariableNames)
+		{
+			ActorsPropertiesValue->AddDialogueToBoolVariable(BoolVariableName, Dialogue);
+		}
 
-			// Populate UClass bool variable names
-			const TSet<FName> ClassBoolVariableNames = Dialogue->GetParticipantClassBoolNames(ParticipantTag);
-			for (const FName& BoolVariableName : ClassBoolVariableNames)
-			{
-				ActorsPropertiesValue->AddDialogueToClassBoolVariable(BoolVariableName, Dialogue);
-			}
+		// Populate FName variable names
+		const TSet<FName> FNameVariableNames = Dialogue->GetParticipantFNameNames(ParticipantTag);
+		for (const FName& NameVariableName : FNameVariableNames)
+		{
+			ActorsPropertiesValue->AddDialogueToFNameVariable(NameVariableName, Dialogue);
+		}
 
-			// Populate UClass FName variable names
-			const TSet<FName> ClassFNameVariableNames = Dialogue->GetParticipantClassFNameNames(ParticipantTag);
-			for (const FName& NameVariableName : ClassFNameVariableNames)
-			{
-				ActorsPropertiesValue->AddDialogueToClassFNameVariable(NameVariableName, Dialogue);
-			}
+		// Populate UClass int variable names
+		const TSet<FName> ClassIntVariableNames = Dialogue->GetParticipantClassIntNames(ParticipantTag);
+		for (const FName& IntVariableName : ClassIntVariableNames)
+		{
+			ActorsPropertiesValue->AddDialogueToClassIntVariable(IntVariableName, Dialogue);
+		}
 
-			// Populate UClass FText variable names
-			const TSet<FName> ClassFTextVariableNames = Dialogue->GetParticipantClassFTextNames(ParticipantTag);
-			for (const FName& NameVariableName : ClassFTextVariableNames)
-			{
-				ActorsPropertiesValue->AddDialogueToClassFTextVariable(NameVariableName, Dialogue);
-			}
+		// Populate UClass float variable names
+		const TSet<FName> ClassFloatVariableNames = Dialogue->GetParticipantClassFloatNames(ParticipantTag);
+		for (const FName& FloatVariableName : ClassFloatVariableNames)
+		{
+			ActorsPropertiesValue->AddDialogueToClassFloatVariable(FloatVariableName, Dialogue);
 		}
-	}
 
-	// Build the Actors Tree View (aka the actual tree)
-	for (const auto& Elem : ActorsProperties)
-	{
-		// Key: AActor
-		if (!Elem.Key.IsValid())
+		// Populate UClass bool variable names
+		const TSet<FName> ClassBoolVariableNames = Dialogue->GetParticipantClassBoolNames(ParticipantTag);
+		for (const FName& BoolVariableName : ClassBoolVariableNames)
 		{
-			continue;
+			ActorsPropertiesValue->AddDialogueToClassBoolVariable(BoolVariableName, Dialogue);
+		}
+
+		// Populate UClass FName variable names
+		const TSet<FName> ClassFNameVariableNames = Dialogue->GetParticipantClassFNameNames(ParticipantTag);
+		for (const FName& NameVariableName : ClassFNameVariableNames)
+		{
+			ActorsPropertiesValue->AddDialogueToClassFNameVariable(NameVariableName, Dialogue);
 		}
 
-		AActor* Actor = Elem.Key.Get();
-		TSharedPtr<FDlgDataDisplayTreeNode> ActorItem =
-			MakeShared<FDlgDataDisplayTreeActorNode>(FText::FromString(Actor->GetName()), RootTreeItem, Actor);
-		BuildTreeViewItem(ActorItem);
-		RootTreeItem->AddChild(ActorItem);
+		// Populate UClass FText variable names
+		const TSet<FName> ClassFTextVariableNames = Dialogue->GetParticipantClassFTextNames(ParticipantTag);
+		for (const FName& NameVariableName : ClassFTextVariableNames)
+		{
+			ActorsPropertiesValue->AddDialogueToClassFTextVariable(NameVariableName, Dialogue);
+		}
 	}
-	RootChildren = RootTreeItem->GetChildren();
 
-	// Clear Previous states
-	ActorsTreeView->ClearSelection();
-	// Triggers RequestTreeRefresh
-	ActorsTreeView->ClearExpandedItems();
+	// Build the Actor tree node
+	TSharedPtr<FDlgDataDisplayTreeNode> ActorItem =
+		MakeShared<FDlgDataDisplayTreeActorNode>(FText::FromString(Actor->GetName()), RootTreeItem, Actor);
+	BuildTreeViewItem(ActorItem);
+	RootTreeItem->AddChild(ActorItem);
+	ActorsNodes.Add(Actor, ActorItem);
+}
 
-	// Restore old Expansion
-	if (bPreserveExpansion && OldExpansionState.Num() > 0)
+void SDlgDataDisplay::RemoveActor(const TWeakObjectPtr<AActor>& Actor)
+{
+	TSharedPtr<FDlgDataDisplayTreeNode> ActorItem;
+	if (ActorsNodes.RemoveAndCopyValue(Actor, ActorItem))
 	{
-		// Flattened tree
-		TArray<TSharedPtr<FDlgDataDisplayTreeNode>> AllNodes;
-		RootTreeItem->GetAllNodes(AllNodes);
-
-		// Expand to match the old state
-		FDlgTreeViewHelper::RestoreTreeExpansionState<TSharedPtr<FDlgDataDisplayTreeNode>>(ActorsTreeView,
-			AllNodes, OldExpansionState, Self::PredicateCompareDlgDataDisplayTreeNode);
+		RootTreeItem->RemoveChild(ActorItem);
 	}
+	ActorsProperties.Remove(Actor);
+	ActorsParticipantTags.Remove(Actor);
 }
 
 void SDlgDataDisplay::GenerateFilteredItems()
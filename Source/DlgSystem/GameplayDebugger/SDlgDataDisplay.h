@@ -20,15 +20,24 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const TWeakObjectPtr<const UObject>& InWorldContextObjectPtr);
+	~SDlgDataDisplay();
+
+	//~ SWidget interface
+	void Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float InDeltaTime) override;
 
 	void SetWorldContextObject(const TWeakObjectPtr<const UObject>& InWorldContextObjectPtr)
 	{
 		WorldContextObjectPtr = InWorldContextObjectPtr;
 	}
 
-	// Updates the actors tree.
+	// Updates the actors tree. Rescans all the dialogues and all the actors of the world.
 	void RefreshTree(bool bPreserveExpansion);
 
+	// Updates the actors tree only where it changed since the last refresh: removes the destroyed actors, adds the participants
+	// notified by UDlgManager::NotifyParticipantChanged and rebuilds the actors whose participant tag changed or that are
+	// participants of the dialogues loaded since. Does a full RefreshTree if the world changed.
+	void RefreshChangedActors();
+
 	// Get current filter text
 	FText GetFilterText() const { return FilterTextBoxWidget->GetText(); }
 
@@ -36,6 +45,22 @@ private:
 	// Handle filtering.
 	void GenerateFilteredItems();
 
+	// The world of the WorldContextObjectPtr
+	UWorld* GetWorld() const;
+
+	// Queue the notified participants and the loaded dialogues for the next RefreshChangedActors
+	void HandleParticipantChanged(UObject* Participant);
+	void HandleDialogueLoaded(UDlgDialogue* Dialogue);
+
+	// Builds the actor properties and the actor tree node, does not refresh the tree view
+	void AddActor(AActor* Actor);
+
+	// Removes the actor properties and the actor tree node, does not refresh the tree view
+	void RemoveActor(const TWeakObjectPtr<AActor>& Actor);
+
+	// Maps from ParticipantTag => Dialogues that have this Participant. Built from all the dialogues in memory.
+	void BuildParticipantTagsDialoguesMap();
+
 	// Getters for widgets.
 	TSharedRef<SWidget> GetFilterTextBoxWidget();
 
@@ -106,6 +131,26 @@ private:
 	// Value: Actor properties
 	TMap<TWeakObjectPtr<AActor>, TSharedPtr<FDlgDataDisplayActorProperties>> ActorsProperties;
 
+	// The tree node and the participant tag of each actor at the time it was added to the tree
+	TMap<TWeakObjectPtr<AActor>, TSharedPtr<FDlgDataDisplayTreeNode>> ActorsNodes;
+	TMap<TWeakObjectPtr<AActor>, FGameplayTag> ActorsParticipantTags;
+
+	// Fast lookup for the dialogues of a participant, rebuilt by RefreshTree and extended with the loaded dialogues
+	TMap<FGameplayTag, TSet<TWeakObjectPtr<const UDlgDialogue>>> ParticipantTagsDialoguesMap;
+
+	// Notified since the last RefreshChangedActors
+	TSet<TWeakObjectPtr<AActor>> ChangedParticipants;
+	TArray<TWeakObjectPtr<const UDlgDialogue>> LoadedDialogues;
+
+	// The world of the last RefreshTree
+	TWeakObjectPtr<UWorld> RefreshedWorld;
+
+	FDelegateHandle ParticipantChangedHandle;
+	FDelegateHandle DialogueLoadedHandle;
+
+	// Number of seconds passed in the Tick since the last RefreshChangedActors
+	float TickPassedDeltaTimeSeconds = 0.f;
+
 	// Reference Object used to get the World
 	TWeakObjectPtr<const UObject> WorldContextObjectPtr = nullptr;
 };
@@ -9,6 +9,7 @@
 #include "Widgets/Input/SEditableTextBox.h"
 
 #include "DlgSystem/NYReflectionHelper.h"
+#include "DlgSystem/DlgSystemSettings.h"
 #include "UObject/TextProperty.h"
 
 #define LOCTEXT_NAMESPACE "SDlgDataPropertyValues"
@@ -58,9 +59,10 @@ void SDlgDataPropertyValue::Tick(const FGeometry& AllottedGeometry, double InCur
 {
 	Super::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
 
-	// We only run this Tick only after TickUpdateTimeSeconds has passed
+	// We only run this Tick only after the refresh interval has passed
+	const float TickUpdateTimeSeconds = GetDefault<UDlgSystemSettings>()->DataDisplayRefreshIntervalSeconds;
 	TickPassedDeltaTimeSeconds += InDeltaTime;
-	if (TickPassedDeltaTimeSeconds < TickUpdateTimeSeconds)
+	if (TickUpdateTimeSeconds <= 0.f || TickPassedDeltaTimeSeconds < TickUpdateTimeSeconds)
 	{
 		return;
 	}
@@ -77,8 +77,6 @@ protected:
 
 	/** Number of seconds passed in the Tick */
 	float TickPassedDeltaTimeSeconds = 0.f;
-
-	static constexpr float TickUpdateTimeSeconds = 1.0f;
 };
 
 
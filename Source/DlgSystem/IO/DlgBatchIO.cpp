@@ -0,0 +1,406 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgBatchIO.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopedSlowTask.h"
+
+#include "IDlgParser.h"
+#include "DlgClassNameIndex.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/Logging/DlgLogger.h"
+
+#define LOCTEXT_NAMESPACE "DlgBatchIO"
+
+std::atomic<int32> FDlgBatchIO::DeferExportCounter{0};
+
+namespace
+{
+	/**
+	 * Calls ChunkFunction(StartIndex, Num) for consecutive chunks of [0, Num) while showing the progress dialog.
+	 * @return The number of items not processed because the user canceled
+	 */
+	template <typename ChunkFunctionType>
+	int32 ForEachChunk(int32 Num, int32 ChunkSize, const FText& Message, ChunkFunctionType&& ChunkFunction)
+	{
+		FScopedSlowTask SlowTask(static_cast<float>(Num), Message);
+		SlowTask.MakeDialog(true);
+
+		for (int32 StartIndex = 0; StartIndex < Num; StartIndex += ChunkSize)
+		{
+			if (SlowTask.ShouldCancel())
+			{
+				return Num - StartIndex;
+			}
+
+			const int32 ChunkNum = FMath::Min(ChunkSize, Num - StartIndex);
+			SlowTask.EnterProgressFrame(static_cast<float>(ChunkNum));
+			ChunkFunction(StartIndex, ChunkNum);
+		}
+
+		return 0;
+	}
+
+	TArray<UDlgDialogue*> GetValidDialogues(const TArray<UDlgDialogue*>& Dialogues)
+	{
+		TArray<UDlgDialogue*> ValidDialogues;
+		ValidDialogues.Reserve(Dialogues.Num());
+		for (UDlgDialogue* Dialogue : Dialogues)
+		{
+			if (IsValid(Dialogue))
+			{
+				ValidDialogues.Add(Dialogue);
+			}
+		}
+		return ValidDialogues;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+FDlgBatchIOResult FDlgBatchIO::ExportDialogues(const TArray<UDlgDialogue*>& Dialogues, EDlgDialogueTextFormat TextFormat)
+{
+	check(IsInGameThread());
+	const double StartTime = FPlatformTime::Seconds();
+	FDlgBatchIOResult Result;
+
+	const TArray<EDlgDialogueTextFormat> TextFormats = GetTextFormatsToProcess(TextFormat);
+	const TArray<UDlgDialogue*> ValidDialogues = GetValidDialogues(Dialogues);
+	if (TextFormats.Num() == 0 || ValidDialogues.Num() == 0)
+	{
+		return Result;
+	}
+
+	// Written by the workers, one entry per dialogue
+	TArray<bool> Succeeded;
+	Succeeded.Init(false, ValidDialogues.Num());
+	TArray<bool> Unchanged;
+	Unchanged.Init(false, ValidDialogues.Num());
+	TArray<TArray<TPair<EDlgDialogueTextFormat, FDlgTextFileContentHash>>> NewContentHashes;
+	NewContentHashes.SetNum(ValidDialogues.Num());
+
+	const FText Message = FText::Format(LOCTEXT("ExportDialogues", "Exporting {0} Dialogue text files"), ValidDialogues.Num());
+	Result.NumCanceled = ForEachChunk(ValidDialogues.Num(), ChunkSize, Message, [&](int32 StartIndex, int32 ChunkNum)
+	{
+		ParallelFor(ChunkNum, [&](int32 ChunkIndex)
+		{
+			const int32 Index = StartIndex + ChunkIndex;
+			bool bSuccess = true;
+			bool bAllUnchanged = true;
+			for (const EDlgDialogueTextFormat CurrentTextFormat : TextFormats)
+			{
+				bool bWasUnchanged = false;
+				FDlgTextFileContentHash NewContentHash;
+				const bool bExported = ValidDialogues[Index]->ExportToTextFile(CurrentTextFormat, &bWasUnchanged, &NewContentHash);
+				if (bExported && !bWasUnchanged)
+				{
+					NewContentHashes[Index].Emplace(CurrentTextFormat, NewContentHash);
+				}
+				bSuccess &= bExported;
+				bAllUnchanged &= bWasUnchanged;
+			}
+			Succeeded[Index] = bSuccess;
+			Unchanged[Index] = bSuccess && bAllUnchanged;
+		});
+
+		// The workers do not modify the dialogues, the hashes of the written files are stored here on the game thread
+		for (int32 Index = StartIndex; Index < StartIndex + ChunkNum; Index++)
+		{
+			for (const auto& FormatHash : NewContentHashes[Index])
+			{
+				ValidDialogues[Index]->SetTextFileContentHash(FormatHash.Key, FormatHash.Value);
+			}
+			NewContentHashes[Index].Empty();
+		}
+	});
+
+	const int32 NumProcessed = ValidDialogues.Num() - Result.NumCanceled;
+	for (int32 Index = 0; Index < NumProcessed; Index++)
+	{
+		if (Succeeded[Index])
+		{
+			Result.NumSucceeded++;
+			if (Unchanged[Index])
+			{
+				Result.NumUnchanged++;
+			}
+		}
+		else
+		{
+			Result.NumFailed++;
+			FDlgLogger::Get().Errorf(TEXT("Exporting data for Dialogue = `%s` FAILED"), *ValidDialogues[Index]->GetPathName());
+		}
+	}
+
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+	FDlgLogger::Get().Infof(TEXT("Exported Dialogues text files: %s"), *Result.ToString());
+	return Result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+FDlgBatchIOResult FDlgBatchIO::ImportDialogues(const TArray<UDlgDialogue*>& Dialogues, EDlgDialogueTextFormat TextFormat)
+{
+	check(IsInGameThread());
+	const double StartTime = FPlatformTime::Seconds();
+	FDlgBatchIOResult Result;
+
+	const TArray<EDlgDialogueTextFormat> TextFormats = GetTextFormatsToProcess(TextFormat);
+	const TArray<UDlgDialogue*> ValidDialogues = GetValidDialogues(Dialogues);
+	if (TextFormats.Num() == 0 || ValidDialogues.Num() == 0)
+	{
+		return Result;
+	}
+
+	// Importing from all the formats only imports the files that exist, same as UDlgDialogue::ImportFromFileFormat
+	const bool bMissingFileIsError = TextFormat != EDlgDialogueTextFormat::All;
+
+	// The parsers look up classes by name, build the index here so the workers do not iterate over all the classes
+	FDlgClassNameIndex::Get().RebuildIfDirty();
+
+	TArray<bool> Failed;
+	Failed.Init(false, ValidDialogues.Num());
+	TArray<bool> Imported;
+	Imported.Init(false, ValidDialogues.Num());
+
+	int32 NumProcessed = ValidDialogues.Num();
+	for (const EDlgDialogueTextFormat CurrentTextFormat : TextFormats)
+	{
+		// The paths are computed here, the workers only do the file I/O and the parsing
+		TArray<FString> TextFileNames;
+		TextFileNames.Reserve(ValidDialogues.Num());
+		for (const UDlgDialogue* Dialogue : ValidDialogues)
+		{
+			TextFileNames.Add(Dialogue->GetTextFilePathName(CurrentTextFormat));
+		}
+
+		TArray<TUniquePtr<IDlgParser>> Parsers;
+		Parsers.SetNum(ValidDialogues.Num());
+		TArray<bool> FileExists;
+		FileExists.Init(false, ValidDialogues.Num());
+
+		const FText Message = FText::Format(
+			LOCTEXT("ImportDialogues", "Importing {0} Dialogues from {1} text files"),
+			ValidDialogues.Num(), UDlgSystemSettings::GetTextFileExtension(CurrentTextFormat)
+		);
+		const int32 NumCanceled = ForEachChunk(ValidDialogues.Num(), ChunkSize, Message, [&](int32 StartIndex, int32 ChunkNum)
+		{
+			ParallelFor(ChunkNum, [&](int32 ChunkIndex)
+			{
+				const int32 Index = StartIndex + ChunkIndex;
+				FileExists[Index] = IFileManager::Get().FileExists(*TextFileNames[Index]);
+				if (!FileExists[Index])
+				{
+					return;
+				}
+
+				Parsers[Index] = UDlgDialogue::MakeTextFileParser(CurrentTextFormat);
+				if (Parsers[Index].IsValid())
+				{
+					Parsers[Index]->InitializeParser(TextFileNames[Index]);
+				}
+			});
+
+			// Back on the game thread, read the parsed data into the dialogues
+			for (int32 Index = StartIndex; Index < StartIndex + ChunkNum; Index++)
+			{
+				UDlgDialogue* Dialogue = ValidDialogues[Index];
+				TUniquePtr<IDlgParser>& Parser = Parsers[Index];
+				if (!FileExists[Index])
+				{
+					if (bMissingFileIsError)
+					{
+						Failed[Index] = true;
+						FDlgLogger::Get().Errorf(
+							TEXT("Reloading data for Dialogue = `%s` FROM file = `%s` FAILED, because the file does not exist"),
+							*Dialogue->GetPathName(), *TextFileNames[Index]
+						);
+					}
+					continue;
+				}
+				if (!Parser.IsValid() || !Parser->IsValidFile())
+				{
+					Failed[Index] = true;
+					FDlgLogger::Get().Errorf(
+						TEXT("Reloading data for Dialogue = `%s` FROM file = `%s` FAILED, because the file could not be parsed"),
+						*Dialogue->GetPathName(), *TextFileNames[Index]
+					);
+					Parser.Reset();
+					continue;
+				}
+
+				Dialogue->ImportFromParser(*Parser, false);
+				Imported[Index] = true;
+
+				// Free the memory of the file as soon as possible
+				Parser.Reset();
+			}
+		});
+
+		NumProcessed = FMath::Min(NumProcessed, ValidDialogues.Num() - NumCanceled);
+		if (NumCanceled > 0)
+		{
+			break;
+		}
+	}
+
+	TArray<UDlgDialogue*> ImportedDialogues;
+	for (int32 Index = 0; Index < ValidDialogues.Num(); Index++)
+	{
+		if (Imported[Index])
+		{
+			ImportedDialogues.Add(ValidDialogues[Index]);
+		}
+	}
+	FixDuplicateGUIDs(ImportedDialogues);
+
+	for (int32 Index = 0; Index < NumProcessed; Index++)
+	{
+		if (Failed[Index])
+		{
+			Result.NumFailed++;
+		}
+		else
+		{
+			Result.NumSucceeded++;
+		}
+	}
+	Result.NumCanceled = ValidDialogues.Num() - NumProcessed;
+
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+	FDlgLogger::Get().Infof(TEXT("Imported Dialogues from text files: %s"), *Result.ToString());
+	return Result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+FDlgBatchIOResult FDlgBatchIO::DeleteTextFiles(const TArray<UDlgDialogue*>& Dialogues)
+{
+	check(IsInGameThread());
+	const double StartTime = FPlatformTime::Seconds();
+	FDlgBatchIOResult Result;
+
+	const TArray<UDlgDialogue*> ValidDialogues = GetValidDialogues(Dialogues);
+	const TArray<FString> FileExtensions = GetDefault<UDlgSystemSettings>()->GetAllTextFileExtensions().Array();
+	if (ValidDialogues.Num() == 0 || FileExtensions.Num() == 0)
+	{
+		return Result;
+	}
+
+	TArray<FString> TextFilePathNames;
+	TextFilePathNames.Reserve(ValidDialogues.Num());
+	for (const UDlgDialogue* Dialogue : ValidDialogues)
+	{
+		TextFilePathNames.Add(Dialogue->GetTextFilePathName(false));
+	}
+
+	TArray<bool> Succeeded;
+	Succeeded.Init(false, ValidDialogues.Num());
+
+	const FText Message = FText::Format(LOCTEXT("DeleteTextFiles", "Deleting the text files of {0} Dialogues"), ValidDialogues.Num());
+	Result.NumCanceled = ForEachChunk(ValidDialogues.Num(), ChunkSize, Message, [&](int32 StartIndex, int32 ChunkNum)
+	{
+		ParallelFor(ChunkNum, [&](int32 ChunkIndex)
+		{
+			const int32 Index = StartIndex + ChunkIndex;
+
+			// Memory corruption? tread carefully here
+			if (TextFilePathNames[Index].IsEmpty())
+			{
+				return;
+			}
+
+			IFileManager& FileManager = IFileManager::Get();
+			bool bSuccess = true;
+			for (const FString& FileExtension : FileExtensions)
+			{
+				const FString FullPathName = TextFilePathNames[Index] + FileExtension;
+				if (FileManager.FileExists(*FullPathName))
+				{
+					bSuccess &= FileManager.Delete(*FullPathName);
+				}
+			}
+			Succeeded[Index] = bSuccess;
+		});
+	});
+
+	const int32 NumProcessed = ValidDialogues.Num() - Result.NumCanceled;
+	for (int32 Index = 0; Index < NumProcessed; Index++)
+	{
+		if (Succeeded[Index])
+		{
+			Result.NumSucceeded++;
+		}
+		else
+		{
+			Result.NumFailed++;
+			FDlgLogger::Get().Errorf(
+				TEXT("Can't delete the text files for Dialogue = `%s`, path name = `%s`"),
+				*ValidDialogues[Index]->GetPathName(), *TextFilePathNames[Index]
+			);
+		}
+	}
+
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+	FDlgLogger::Get().Infof(TEXT("Deleted Dialogues text files: %s"), *Result.ToString());
+	return Result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TArray<EDlgDialogueTextFormat> FDlgBatchIO::GetTextFormatsToProcess(EDlgDialogueTextFormat TextFormat)
+{
+	TArray<EDlgDialogueTextFormat> TextFormats;
+	if (TextFormat == EDlgDialogueTextFormat::All)
+	{
+		const int32 TextFormatsNum = static_cast<int32>(EDlgDialogueTextFormat::NumTextFormats);
+		for (int32 TextFormatIndex = static_cast<int32>(EDlgDialogueTextFormat::StartTextFormats);
+				   TextFormatIndex < TextFormatsNum; TextFormatIndex++)
+		{
+			TextFormats.Add(static_cast<EDlgDialogueTextFormat>(TextFormatIndex));
+		}
+	}
+	else if (UDlgSystemSettings::HasTextFileExtension(TextFormat))
+	{
+		TextFormats.Add(TextFormat);
+	}
+
+	return TextFormats;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBatchIO::FixDuplicateGUIDs(const TArray<UDlgDialogue*>& ImportedDialogues)
+{
+	if (ImportedDialogues.Num() == 0)
+	{
+		return;
+	}
+
+	// The dialogues that were not imported keep their GUIDs
+	const TSet<UDlgDialogue*> ImportedSet(ImportedDialogues);
+	TSet<FGuid> UsedGUIDs;
+	for (UDlgDialogue* Dialogue : UDlgManager::GetAllDialoguesFromMemory())
+	{
+		if (!ImportedSet.Contains(Dialogue))
+		{
+			UsedGUIDs.Add(Dialogue->GetGUID());
+		}
+	}
+
+	for (UDlgDialogue* Dialogue : ImportedDialogues)
+	{
+		bool bIsAlreadyUsed = false;
+		UsedGUIDs.Add(Dialogue->GetGUID(), &bIsAlreadyUsed);
+		if (!bIsAlreadyUsed)
+		{
+			continue;
+		}
+
+		Dialogue->RegenerateGUID();
+		UsedGUIDs.Add(Dialogue->GetGUID());
+		FDlgLogger::Get().Warningf(
+			TEXT("Creating new GUID = `%s` for Dialogue = `%s` because the input file contained a duplicate GUID."),
+			*Dialogue->GetGUID().ToString(), *Dialogue->GetPathName()
+		);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
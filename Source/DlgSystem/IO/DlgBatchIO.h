@@ -0,0 +1,90 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include <atomic>
+#include "CoreMinimal.h"
+
+#include "DlgSystem/DlgSystemSettings.h"
+
+class UDlgDialogue;
+
+struct DLGSYSTEM_API FDlgBatchIOResult
+{
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+
+	// Part of NumSucceeded, exports that did not write anything because the content did not change
+	int32 NumUnchanged = 0;
+
+	// Number of dialogues not processed because the user canceled the operation
+	int32 NumCanceled = 0;
+
+	// Wall time of the whole operation
+	double Seconds = 0.0;
+
+	bool IsSuccess() const { return NumFailed == 0 && NumCanceled == 0; }
+
+	FString ToString() const
+	{
+		return FString::Printf(
+			TEXT("Succeeded = %d (Unchanged = %d), Failed = %d, Canceled = %d, Time = %.3f seconds"),
+			NumSucceeded, NumUnchanged, NumFailed, NumCanceled, Seconds
+		);
+	}
+};
+
+/**
+ * Imports/Exports/Deletes the text files of many dialogues at once.
+ *
+ * The dialogues are processed in chunks, inside a chunk the file I/O, serialization and parsing run in parallel on worker threads.
+ * Everything that mutates a UObject (reading the parsed data into the dialogue, refreshing it, GUID fixes)
+ * and all the FDlgLogger messages stay on the game thread.
+ * A progress dialog is shown between chunks (when not running unattended) and the operation can be canceled from it.
+ */
+class DLGSYSTEM_API FDlgBatchIO
+{
+public:
+	/**
+	 * Writes the text files of all the Dialogues, the files whose content did not change are not rewritten (see UDlgDialogue::ExportToTextFile).
+	 * The dialogues must not be modified while this runs, this blocks the game thread until it is done.
+	 * @param TextFormat	EDlgDialogueTextFormat::All writes every text format
+	 */
+	static FDlgBatchIOResult ExportDialogues(const TArray<UDlgDialogue*>& Dialogues, EDlgDialogueTextFormat TextFormat);
+
+	/**
+	 * Reads the text files of all the Dialogues into the dialogues, same as calling UDlgDialogue::ImportFromFileFormat for each.
+	 * Duplicate GUIDs are resolved once at the end instead of once per dialogue.
+	 * @param TextFormat	EDlgDialogueTextFormat::All reads every text format that has a file, in the enum order
+	 */
+	static FDlgBatchIOResult ImportDialogues(const TArray<UDlgDialogue*>& Dialogues, EDlgDialogueTextFormat TextFormat);
+
+	// Deletes the text files of all the Dialogues for all the known text file extensions
+	static FDlgBatchIOResult DeleteTextFiles(const TArray<UDlgDialogue*>& Dialogues);
+
+	// Is UDlgDialogue::ExportToFile ignored right now, see FScopedDeferExport
+	static bool IsExportDeferred() { return DeferExportCounter.load() > 0; }
+
+	/**
+	 * While in scope UDlgDialogue::ExportToFile does nothing.
+	 * Used when saving many dialogue packages at once, so that saving does not export each dialogue serially,
+	 * the caller then exports all of them with ExportDialogues.
+	 */
+	struct FScopedDeferExport
+	{
+		FScopedDeferExport() { ++DeferExportCounter; }
+		~FScopedDeferExport() { --DeferExportCounter; }
+	};
+
+private:
+	// The text formats that TextFormat stands for (All expands to every text format)
+	static TArray<EDlgDialogueTextFormat> GetTextFormatsToProcess(EDlgDialogueTextFormat TextFormat);
+
+	// Keeps track of the GUIDs of all the dialogues in memory, regenerates the GUID of the imported dialogues that collide
+	static void FixDuplicateGUIDs(const TArray<UDlgDialogue*>& ImportedDialogues);
+
+private:
+	// Number of dialogues handled by one parallel chunk, the progress dialog is updated and cancel is checked between chunks
+	static constexpr int32 ChunkSize = 64;
+
+	static std::atomic<int32> DeferExportCounter;
+};
@@ -0,0 +1,124 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+#include "UObject/UnrealType.h"
+
+/**
+ * Layout of the binary text format, shared by FDlgBinaryWriter and FDlgBinaryParser.
+ *
+ * File:
+ *   uint32 Magic, uint32 Version
+ *   VarUInt NumStrings, FString[NumStrings]		String table, every name below is an index into it
+ *   Struct										The root object
+ *
+ * Struct:
+ *   VarUInt NumProperties
+ *   { VarUInt PropertyName, VarUInt PropertyType, uint32 PayloadSize, Payload }[NumProperties]
+ *
+ * The property name + type + payload size allow the parser to skip properties that were removed, renamed or changed type,
+ * just like the text formats ignore the unknown keys.
+ *
+ * Payload (by property type):
+ *   ArrayDim > 1		VarUInt Num, Value[Num]
+ *   Enum				VarUInt EnumName
+ *   Integer			zigzag VarInt
+ *   float/double		float/double
+ *   bool				uint8
+ *   FString/FText		FString (FText is exported as string, same as the other formats)
+ *   FName				VarUInt Name
+ *   TArray/TSet		VarUInt Num, Value[Num]
+ *   TMap				VarUInt Num, { Key, Value }[Num]
+ *   Struct				uint8 EStructTag, then FString (ExportTextItem) or Struct
+ *   UObject			uint8 EObjectTag, then nothing, FString path or VarUInt ClassName + Struct
+ *   Anything else		FString (ExportTextItem)
+ */
+struct DLGSYSTEM_API FDlgBinaryFormat
+{
+	// "DLGB"
+	static constexpr uint32 Magic = 0x42474C44;
+
+	enum EVersion : uint32
+	{
+		Initial = 1,
+
+		// -----<new versions can be added before this line>-------------------------------------------------
+		// - this needs to be the last line (see note below)
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	enum class EStructTag : uint8
+	{
+		Properties = 0,
+		ExportedText
+	};
+
+	enum class EObjectTag : uint8
+	{
+		Null = 0,
+		Reference,
+		Inline
+	};
+
+	// Type signature of the property written next to each property, e.g. int32, TArray<FString>, UDlgNode*
+	static FString GetPropertyTypeName(const FProperty* Property)
+	{
+		FString ExtendedTypeText;
+		FString TypeText = Property->GetCPPType(&ExtendedTypeText);
+		TypeText += ExtendedTypeText;
+		return TypeText;
+	}
+
+	static void WriteVarUInt(FArchive& Ar, uint64 Value)
+	{
+		do
+		{
+			uint8 Byte = static_cast<uint8>(Value & 0x7F);
+			Value >>= 7;
+			if (Value != 0)
+			{
+				Byte |= 0x80;
+			}
+			Ar << Byte;
+		}
+		while (Value != 0);
+	}
+
+	static uint64 ReadVarUInt(FArchive& Ar)
+	{
+		uint64 Value = 0;
+		for (int32 Shift = 0; Shift < 64; Shift += 7)
+		{
+			uint8 Byte = 0;
+			Ar << Byte;
+			if (Ar.IsError())
+			{
+				return 0;
+			}
+
+			Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return Value;
+			}
+		}
+
+		// Too many bytes, corrupted data
+		Ar.SetError();
+		return 0;
+	}
+
+	// Zigzag encoding so that small negative numbers are small too
+	static void WriteVarInt(FArchive& Ar, int64 Value)
+	{
+		WriteVarUInt(Ar, (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+	}
+
+	static int64 ReadVarInt(FArchive& Ar)
+	{
+		const uint64 Value = ReadVarUInt(Ar);
+		return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+	}
+};
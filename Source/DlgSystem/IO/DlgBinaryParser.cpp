@@ -0,0 +1,624 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgBinaryParser.h"
+
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/FeedbackContext.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/PropertyPortFlags.h"
+
+#include "DlgSystem/NYReflectionHelper.h"
+
+DEFINE_LOG_CATEGORY(LogDlgBinaryParser);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryParser::InitializeParser(const FString& FilePath)
+{
+	if (FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		FileName = FPaths::GetBaseFilename(FilePath, true);
+		bIsValidFile = true;
+	}
+	else
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("Failed to load binary file %s"), *FilePath);
+		bIsValidFile = false;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryParser::InitializeParserFromString(const FString& Text)
+{
+	FileName = "";
+	Bytes.Reset();
+	bIsValidFile = FBase64::Decode(Text, Bytes);
+	if (!bIsValidFile)
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("InitializeParserFromString - Text is not valid Base64"));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryParser::InitializeParserFromBytes(const TArray<uint8>& InBytes)
+{
+	Bytes = InBytes;
+	bIsValidFile = true;
+	FileName = "";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryParser::ReadAllProperty(const UStruct* ReferenceClass, void* TargetObject, UObject* InDefaultObjectOuter)
+{
+	if (!IsValidFile())
+	{
+		return;
+	}
+
+	DefaultObjectOuter = InDefaultObjectOuter;
+	FMemoryReader Reader(Bytes);
+	if (!ReadHeader(Reader))
+	{
+		bIsValidFile = false;
+		return;
+	}
+
+	ReadStruct(Reader, ReferenceClass, TargetObject);
+	if (Reader.IsError())
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("ReadAllProperty - File = `%s` is truncated or corrupted"), *FileName);
+		bIsValidFile = false;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadHeader(FArchive& Ar)
+{
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsError() || Magic != FDlgBinaryFormat::Magic)
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("ReadHeader - File = `%s` is not a binary dialogue file"), *FileName);
+		return false;
+	}
+	if (Version > FDlgBinaryFormat::LatestVersion)
+	{
+		UE_LOG(
+			LogDlgBinaryParser,
+			Error,
+			TEXT("ReadHeader - File = `%s` has Version = %u but the newest supported version is %u"),
+			*FileName, Version, static_cast<uint32>(FDlgBinaryFormat::LatestVersion)
+		);
+		return false;
+	}
+
+	const int32 NumStrings = ReadNum(Ar);
+	Strings.SetNum(NumStrings);
+	Names.SetNum(NumStrings);
+	for (int32 Index = 0; Index < NumStrings && !Ar.IsError(); Index++)
+	{
+		Ar << Strings[Index];
+		Names[Index] = FName(*Strings[Index]);
+	}
+
+	return !Ar.IsError();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FDlgBinaryParser::ReadStringIndex(FArchive& Ar)
+{
+	const uint64 Index = FDlgBinaryFormat::ReadVarUInt(Ar);
+	if (Index >= static_cast<uint64>(Strings.Num()))
+	{
+		Ar.SetError();
+		return INDEX_NONE;
+	}
+
+	return static_cast<int32>(Index);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FDlgBinaryParser::ReadNum(FArchive& Ar)
+{
+	// Every element takes at least one byte
+	const uint64 Num = FDlgBinaryFormat::ReadVarUInt(Ar);
+	if (Num > static_cast<uint64>(Ar.TotalSize() - Ar.Tell()))
+	{
+		Ar.SetError();
+		return 0;
+	}
+
+	return static_cast<int32>(Num);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::IsSameType(const FProperty* Property, int32 TypeStringIndex)
+{
+	const FString* TypeName = PropertyTypeNames.Find(Property);
+	if (TypeName == nullptr)
+	{
+		TypeName = &PropertyTypeNames.Add(Property, FDlgBinaryFormat::GetPropertyTypeName(Property));
+	}
+
+	return Strings[TypeStringIndex] == *TypeName;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadStruct(FArchive& Ar, const UStruct* StructDefinition, void* ContainerPtr)
+{
+	check(StructDefinition);
+	check(ContainerPtr);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgBinaryParser, Verbose, TEXT("ReadStruct, StructDefinition = `%s`"), *StructDefinition->GetPathName());
+	}
+
+	// Handle UObject inheritance (children of class)
+	if (StructDefinition->IsA<UClass>())
+	{
+		// Structure points to the child
+		const UObject* UnrealObject = static_cast<const UObject*>(ContainerPtr);
+		if (!UnrealObject->IsValidLowLevelFast())
+		{
+			UE_LOG(
+				LogDlgBinaryParser,
+				Error,
+				TEXT("ReadStruct: StructDefinition = `%s` is a UClass and expected ContainerPtr to be an UObject. Memory corruption?"),
+				*StructDefinition->GetPathName()
+			);
+			SkipStruct(Ar);
+			return false;
+		}
+		StructDefinition = UnrealObject->GetClass();
+	}
+
+	const int32 NumProperties = ReadNum(Ar);
+	for (int32 PropertyIndex = 0; PropertyIndex < NumProperties && !Ar.IsError(); PropertyIndex++)
+	{
+		const int32 NameIndex = ReadStringIndex(Ar);
+		const int32 TypeIndex = ReadStringIndex(Ar);
+		uint32 PayloadSize = 0;
+		Ar << PayloadSize;
+		const int64 PayloadEndOffset = Ar.Tell() + PayloadSize;
+		if (Ar.IsError() || PayloadEndOffset > Ar.TotalSize())
+		{
+			Ar.SetError();
+			return false;
+		}
+
+		// We allow properties to not be found since this mirrors the typical UObject mantra that all the fields are optional when deserializing
+		FProperty* Property = StructDefinition->FindPropertyByName(Names[NameIndex]);
+		if (Property == nullptr || (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags)))
+		{
+			Ar.Seek(PayloadEndOffset);
+			continue;
+		}
+		if (!IsSameType(Property, TypeIndex))
+		{
+			UE_LOG(
+				LogDlgBinaryParser,
+				Warning,
+				TEXT("ReadStruct - Ignoring %s.%s because it was written as `%s` but it is now `%s`"),
+				*StructDefinition->GetName(), *Property->GetName(), *Strings[TypeIndex], *PropertyTypeNames.FindChecked(Property)
+			);
+			Ar.Seek(PayloadEndOffset);
+			continue;
+		}
+
+		if (!ReadProperty(Ar, Property, Property->ContainerPtrToValuePtr<void>(ContainerPtr, 0)))
+		{
+			UE_LOG(
+				LogDlgBinaryParser,
+				Error,
+				TEXT("ReadStruct - Unable to parse %s.%s"),
+				*StructDefinition->GetName(), *Property->GetName()
+			);
+		}
+		if (Ar.IsError())
+		{
+			return false;
+		}
+
+		// Always continue from the next property, even if this one failed or did not read everything (static array got smaller)
+		Ar.Seek(PayloadEndOffset);
+	}
+
+	return !Ar.IsError();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryParser::SkipStruct(FArchive& Ar)
+{
+	const int32 NumProperties = ReadNum(Ar);
+	for (int32 PropertyIndex = 0; PropertyIndex < NumProperties && !Ar.IsError(); PropertyIndex++)
+	{
+		ReadStringIndex(Ar);
+		ReadStringIndex(Ar);
+		uint32 PayloadSize = 0;
+		Ar << PayloadSize;
+
+		const int64 PayloadEndOffset = Ar.Tell() + PayloadSize;
+		if (Ar.IsError() || PayloadEndOffset > Ar.TotalSize())
+		{
+			Ar.SetError();
+			return;
+		}
+		Ar.Seek(PayloadEndOffset);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadProperty(FArchive& Ar, FProperty* Property, void* ValuePtr)
+{
+	check(Property);
+
+	// Scalar only one property
+	if (Property->ArrayDim == 1)
+	{
+		return ReadScalarProperty(Ar, Property, ValuePtr);
+	}
+
+	// Static array, the excess elements are skipped by the caller
+	const int32 Num = ReadNum(Ar);
+	if (Num > Property->ArrayDim)
+	{
+		UE_LOG(LogDlgBinaryParser, Warning, TEXT("[Property->ArrayDim < Num] Ignoring excess properties when deserializing %s"), *Property->GetNameCPP());
+	}
+
+#if NY_ENGINE_VERSION >= 505
+	const int32 ElementSize = Property->GetElementSize();
+#else
+	const int32 ElementSize = Property->ElementSize;
+#endif
+
+	const int32 ItemsToRead = FMath::Min(Num, Property->ArrayDim);
+	uint8* ValueIntPtr = static_cast<uint8*>(ValuePtr);
+	bool bReturnStatus = true;
+	for (int32 Index = 0; Index < ItemsToRead; Index++)
+	{
+		bReturnStatus &= ReadScalarProperty(Ar, Property, ValueIntPtr + Index * ElementSize);
+	}
+	return bReturnStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadScalarProperty(FArchive& Ar, FProperty* Property, void* ValuePtr)
+{
+	check(Property);
+	check(ValuePtr);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgBinaryParser, Verbose, TEXT("ReadScalarProperty, Property = `%s`"), *Property->GetPathName());
+	}
+
+	// Get the enum value from the name
+	auto ReadEnumValue = [this, &Ar, Property](const UEnum* Enum, int64& OutValue) -> bool
+	{
+		const int32 NameIndex = ReadStringIndex(Ar);
+		if (NameIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		OutValue = Enum->GetValueByName(Names[NameIndex]);
+		if (OutValue == INDEX_NONE)
+		{
+			UE_LOG(
+				LogDlgBinaryParser,
+				Error,
+				TEXT("ReadScalarProperty - Unable import enum `%s` from value `%s` for property `%s`"),
+				*Enum->CppType, *Strings[NameIndex], *Property->GetNameCPP()
+			);
+			return false;
+		}
+		return true;
+	};
+
+	// Enum
+	if (auto* EnumProperty = FNYReflectionHelper::CastProperty<FEnumProperty>(Property))
+	{
+		int64 Value;
+		if (!ReadEnumValue(EnumProperty->GetEnum(), Value))
+		{
+			return false;
+		}
+
+		EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(ValuePtr, Value);
+		return true;
+	}
+
+	// Numeric, int, float, possible enum
+	if (auto* NumericProperty = FNYReflectionHelper::CastProperty<FNumericProperty>(Property))
+	{
+		if (const UEnum* EnumDefinition = NumericProperty->GetIntPropertyEnum())
+		{
+			int64 Value;
+			if (!ReadEnumValue(EnumDefinition, Value))
+			{
+				return false;
+			}
+
+			NumericProperty->SetIntPropertyValue(ValuePtr, Value);
+		}
+		else if (NumericProperty->IsInteger())
+		{
+			NumericProperty->SetIntPropertyValue(ValuePtr, FDlgBinaryFormat::ReadVarInt(Ar));
+		}
+		else if (Property->IsA<FDoubleProperty>())
+		{
+			double Value = 0.0;
+			Ar << Value;
+			NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Value);
+		}
+		else
+		{
+			float Value = 0.f;
+			Ar << Value;
+			NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Value);
+		}
+
+		return !Ar.IsError();
+	}
+
+	// Bool
+	if (auto* BoolProperty = FNYReflectionHelper::CastProperty<FBoolProperty>(Property))
+	{
+		uint8 Value = 0;
+		Ar << Value;
+		BoolProperty->SetPropertyValue(ValuePtr, Value != 0);
+		return !Ar.IsError();
+	}
+
+	// FString
+	if (auto* StringProperty = FNYReflectionHelper::CastProperty<FStrProperty>(Property))
+	{
+		FString Value;
+		Ar << Value;
+		StringProperty->SetPropertyValue(ValuePtr, MoveTemp(Value));
+		return !Ar.IsError();
+	}
+
+	// FName
+	if (auto* NameProperty = FNYReflectionHelper::CastProperty<FNameProperty>(Property))
+	{
+		const int32 NameIndex = ReadStringIndex(Ar);
+		if (NameIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		NameProperty->SetPropertyValue(ValuePtr, Names[NameIndex]);
+		return true;
+	}
+
+	// FText
+	if (auto* TextProperty = FNYReflectionHelper::CastProperty<FTextProperty>(Property))
+	{
+		FString Value;
+		Ar << Value;
+		TextProperty->SetPropertyValue(ValuePtr, FText::FromString(Value));
+		return !Ar.IsError();
+	}
+
+	// TArray
+	if (auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(Property))
+	{
+		const int32 Num = ReadNum(Ar);
+
+		// make the output array size match
+		FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+		Helper.EmptyValues();
+		Helper.Resize(Num);
+
+		bool bReturnStatus = true;
+		for (int32 Index = 0; Index < Num && !Ar.IsError(); Index++)
+		{
+			if (!ReadScalarProperty(Ar, ArrayProperty->Inner, Helper.GetRawPtr(Index)))
+			{
+				bReturnStatus = false;
+				UE_LOG(
+					LogDlgBinaryParser,
+					Error,
+					TEXT("ReadScalarProperty - Unable to deserialize array element [%d] for property %s"),
+					Index, *Property->GetNameCPP()
+				);
+			}
+		}
+
+		return bReturnStatus && !Ar.IsError();
+	}
+
+	// TSet
+	if (auto* SetProperty = FNYReflectionHelper::CastProperty<FSetProperty>(Property))
+	{
+		const int32 Num = ReadNum(Ar);
+
+		FScriptSetHelper Helper(SetProperty, ValuePtr);
+		Helper.EmptyElements(Num);
+
+		bool bReturnStatus = true;
+		for (int32 Index = 0; Index < Num && !Ar.IsError(); Index++)
+		{
+			const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+			if (!ReadScalarProperty(Ar, SetProperty->ElementProp, Helper.GetElementPtr(NewIndex)))
+			{
+				bReturnStatus = false;
+				UE_LOG(
+					LogDlgBinaryParser,
+					Error,
+					TEXT("ReadScalarProperty - Unable to deserialize set element [%d] for property %s"),
+					Index, *Property->GetNameCPP()
+				);
+			}
+		}
+
+		Helper.Rehash();
+		return bReturnStatus && !Ar.IsError();
+	}
+
+	// TMap
+	if (auto* MapProperty = FNYReflectionHelper::CastProperty<FMapProperty>(Property))
+	{
+		const int32 Num = ReadNum(Ar);
+
+		FScriptMapHelper Helper(MapProperty, ValuePtr);
+		Helper.EmptyValues(Num);
+
+		bool bReturnStatus = true;
+		for (int32 Index = 0; Index < Num && !Ar.IsError(); Index++)
+		{
+			const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+			const bool bKeySuccess = ReadScalarProperty(Ar, Helper.GetKeyProperty(), Helper.GetKeyPtr(NewIndex));
+			const bool bValueSuccess = ReadScalarProperty(Ar, Helper.GetValueProperty(), Helper.GetValuePtr(NewIndex));
+			if (!bKeySuccess || !bValueSuccess)
+			{
+				Helper.RemoveAt(NewIndex);
+				bReturnStatus = false;
+				UE_LOG(
+					LogDlgBinaryParser,
+					Error,
+					TEXT("ReadScalarProperty - Unable to deserialize map element [%d] for property %s"),
+					Index, *Property->GetNameCPP()
+				);
+			}
+		}
+
+		Helper.Rehash();
+		return bReturnStatus && !Ar.IsError();
+	}
+
+	// UStruct
+	if (auto* StructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(Property))
+	{
+		uint8 Tag = 0;
+		Ar << Tag;
+		if (Tag == static_cast<uint8>(FDlgBinaryFormat::EStructTag::Properties))
+		{
+			return ReadStruct(Ar, StructProperty->Struct, ValuePtr);
+		}
+		if (Tag != static_cast<uint8>(FDlgBinaryFormat::EStructTag::ExportedText))
+		{
+			Ar.SetError();
+			return false;
+		}
+
+		FString ImportTextString;
+		Ar << ImportTextString;
+		const TCHAR* ImportTextPtr = *ImportTextString;
+
+		UScriptStruct::ICppStructOps* TheCppStructOps = StructProperty->Struct->GetCppStructOps();
+		if (TheCppStructOps && TheCppStructOps->HasImportTextItem() &&
+			TheCppStructOps->ImportTextItem(ImportTextPtr, ValuePtr, PPF_None, nullptr, static_cast<FOutputDevice*>(GWarn)))
+		{
+			return true;
+		}
+
+		// Fall back to trying the tagged property approach if custom ImportTextItem couldn't get it done
+		ImportTextPtr = *ImportTextString;
+#if NY_ENGINE_VERSION >= 501
+		return Property->ImportText_Direct(ImportTextPtr, ValuePtr, nullptr, PPF_None) != nullptr;
+#else
+		return Property->ImportText(ImportTextPtr, ValuePtr, PPF_None, nullptr) != nullptr;
+#endif
+	}
+
+	// UObject
+	if (auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property))
+	{
+		uint8 Tag = 0;
+		Ar << Tag;
+
+		// Reset first, this mirrors the text parsers that always create a new object
+		ObjectProperty->SetObjectPropertyValue(ValuePtr, nullptr);
+
+		switch (static_cast<FDlgBinaryFormat::EObjectTag>(Tag))
+		{
+			case FDlgBinaryFormat::EObjectTag::Null:
+				return !Ar.IsError();
+
+			// Special case, load by reference, See CanSaveAsReference
+			case FDlgBinaryFormat::EObjectTag::Reference:
+			{
+				FString Path;
+				Ar << Path;
+				if (!Path.IsEmpty())
+				{
+					ObjectProperty->SetObjectPropertyValue(ValuePtr, StaticLoadObject(UObject::StaticClass(), DefaultObjectOuter, *Path));
+				}
+				return !Ar.IsError();
+			}
+
+			case FDlgBinaryFormat::EObjectTag::Inline:
+			{
+				const int32 ClassNameIndex = ReadStringIndex(Ar);
+				if (ClassNameIndex == INDEX_NONE)
+				{
+					return false;
+				}
+
+				const UClass* ChildClass = GetChildClassFromName(ObjectProperty->PropertyClass, Strings[ClassNameIndex]);
+				if (ChildClass == nullptr)
+				{
+					UE_LOG(
+						LogDlgBinaryParser,
+						Error,
+						TEXT("ReadScalarProperty - Could not find class `%s` for FObjectProperty = `%s`. Ignored."),
+						*Strings[ClassNameIndex], *Property->GetNameCPP()
+					);
+					SkipStruct(Ar);
+					return false;
+				}
+
+				UObject* NewUObject = CreateNewUObject(ChildClass, DefaultObjectOuter);
+				if (NewUObject == nullptr || !NewUObject->IsValidLowLevelFast())
+				{
+					UE_LOG(
+						LogDlgBinaryParser,
+						Error,
+						TEXT("ReadScalarProperty - PropertyName = `%s` Is a FObjectProperty but could not build any valid UObject"),
+						*Property->GetNameCPP()
+					);
+					SkipStruct(Ar);
+					return false;
+				}
+
+				ObjectProperty->SetObjectPropertyValue(ValuePtr, NewUObject);
+				return ReadStruct(Ar, ChildClass, NewUObject);
+			}
+
+			default:
+				Ar.SetError();
+				return false;
+		}
+	}
+
+	// Default to expect a string for everything else
+	FString Buffer;
+	Ar << Buffer;
+	if (Ar.IsError())
+	{
+		return false;
+	}
+
+#if NY_ENGINE_VERSION >= 501
+	if (Property->ImportText_Direct(*Buffer, ValuePtr, nullptr, PPF_None) == nullptr)
+#else
+	if (Property->ImportText(*Buffer, ValuePtr, PPF_None, nullptr) == nullptr)
+#endif
+	{
+		UE_LOG(
+			LogDlgBinaryParser,
+			Error,
+			TEXT("ReadScalarProperty - Unable import property type %s from string value for property %s"),
+			*Property->GetClass()->GetName(), *Property->GetNameCPP()
+		);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,89 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "Logging/LogMacros.h"
+
+#include "IDlgParser.h"
+#include "DlgBinaryFormat.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgBinaryParser, All, All);
+
+/**
+ * @brief Reads the compact binary format written by FDlgBinaryWriter, see DlgBinaryFormat.h
+ * See IDlgParser for properties and METADATA specifiers.
+ */
+class DLGSYSTEM_API FDlgBinaryParser : public IDlgParser
+{
+	/**
+	 * Call Order and possible calls:
+	 *  - DlgBinaryParser
+	 *		- ReadAllProperty
+	 *			- ReadHeader
+	 *			- ReadStruct
+	 *				- ReadProperty
+	 *					- ReadScalarProperty
+	 *						- ReadScalarProperty
+	 *						- ReadStruct
+	 */
+public:
+	FDlgBinaryParser() {}
+
+	FDlgBinaryParser(const FString& FilePath)
+	{
+		InitializeParser(FilePath);
+	}
+
+	// IDlgParser Interface
+	void InitializeParser(const FString& FilePath) override;
+
+	// Expects the Base64 string from FDlgBinaryWriter::GetAsString
+	void InitializeParserFromString(const FString& Text) override;
+
+	bool IsValidFile() const override { return bIsValidFile; }
+	void ReadAllProperty(const UStruct* ReferenceClass, void* TargetObject, UObject* DefaultObjectOuter = nullptr) override;
+
+	void InitializeParserFromBytes(const TArray<uint8>& InBytes);
+
+private:
+	// Reads the magic, version and the string table
+	bool ReadHeader(FArchive& Ar);
+
+	// Reads all the properties into the struct/object
+	bool ReadStruct(FArchive& Ar, const UStruct* StructDefinition, void* ContainerPtr);
+
+	// Skips all the properties of a struct/object, used when the object class does not exist anymore
+	void SkipStruct(FArchive& Ar);
+
+	// Reads a property that can be a static array (ArrayDim > 1)
+	bool ReadProperty(FArchive& Ar, FProperty* Property, void* ValuePtr);
+
+	// Reads a single value of Property, ValuePtr points directly to the value
+	bool ReadScalarProperty(FArchive& Ar, FProperty* Property, void* ValuePtr);
+
+	// Reads an index into the string table
+	int32 ReadStringIndex(FArchive& Ar);
+
+	// Reads a container size, sets the archive in error if it can't be right
+	int32 ReadNum(FArchive& Ar);
+
+	// Does the type the Property was written with match the current type of the Property
+	bool IsSameType(const FProperty* Property, int32 TypeStringIndex);
+
+private:
+	TArray<uint8> Bytes;
+	FString FileName;
+	bool bIsValidFile = false;
+
+	// String table of the file
+	TArray<FString> Strings;
+	TArray<FName> Names;
+
+	// Property => its type name, see FDlgBinaryFormat::GetPropertyTypeName
+	TMap<const FProperty*, FString> PropertyTypeNames;
+
+	/** The default object outer used when creating new objects when using NewObject.  */
+	UObject* DefaultObjectOuter = nullptr;
+
+	/** Only properties that have these flags will be read. */
+	static constexpr int64 CheckFlags = ~CPF_ParmFlags;
+};
@@ -0,0 +1,381 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgBinaryWriter.h"
+
+#include "Misc/Base64.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/PropertyPortFlags.h"
+
+#include "DlgSystem/DlgHelper.h"
+#include "DlgSystem/NYReflectionHelper.h"
+
+DEFINE_LOG_CATEGORY(LogDlgBinaryWriter);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryWriter::Write(const UStruct* StructDefinition, const void* ContainerPtr)
+{
+	Strings.Reset();
+	StringIndices.Reset();
+	PropertyStringIndices.Reset();
+	Base64String.Empty();
+
+	// The body is written first because it fills the string table that goes before it
+	TArray<uint8> Body;
+	Body.Reserve(FMath::Max(OutputSizeHint, DefaultOutputReserveSize));
+	{
+		FMemoryWriter BodyWriter(Body);
+		WriteStruct(BodyWriter, StructDefinition, ContainerPtr);
+	}
+
+	Bytes.Reset();
+	Bytes.Reserve(Body.Num() + Strings.Num() * 16 + 16);
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = FDlgBinaryFormat::Magic;
+	uint32 Version = FDlgBinaryFormat::LatestVersion;
+	Writer << Magic;
+	Writer << Version;
+
+	FDlgBinaryFormat::WriteVarUInt(Writer, Strings.Num());
+	for (FString& String : Strings)
+	{
+		Writer << String;
+	}
+
+	Writer.Serialize(Body.GetData(), Body.Num());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const FString& FDlgBinaryWriter::GetAsString() const
+{
+	if (Base64String.IsEmpty() && Bytes.Num() > 0)
+	{
+		Base64String = FBase64::Encode(Bytes);
+	}
+
+	return Base64String;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryWriter::ExportToArchive(FArchive& Ar) const
+{
+	Ar.Serialize(const_cast<uint8*>(Bytes.GetData()), Bytes.Num());
+	return !Ar.IsError();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FDlgBinaryWriter::GetStringIndex(const FString& String)
+{
+	if (const int32* IndexPtr = StringIndices.Find(String))
+	{
+		return *IndexPtr;
+	}
+
+	const int32 Index = Strings.Add(String);
+	StringIndices.Add(String, Index);
+	return Index;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryWriter::WriteStruct(FArchive& Ar, const UStruct* StructDefinition, const void* ContainerPtr)
+{
+	check(StructDefinition);
+	check(ContainerPtr);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgBinaryWriter, Verbose, TEXT("WriteStruct, StructDefinition = `%s`"), *StructDefinition->GetPathName());
+	}
+
+	// Handle UObject inheritance (children of class)
+	if (StructDefinition->IsA<UClass>())
+	{
+		const UObject* UnrealObject = static_cast<const UObject*>(ContainerPtr);
+		if (!UnrealObject->IsValidLowLevelFast())
+		{
+			UE_LOG(
+				LogDlgBinaryWriter,
+				Error,
+				TEXT("WriteStruct: StructDefinition = `%s` is a UClass and expected ContainerPtr to be an UObject. Memory corruption?"),
+				*StructDefinition->GetPathName()
+			);
+			FDlgBinaryFormat::WriteVarUInt(Ar, 0);
+			return;
+		}
+
+		// Structure points to the child
+		StructDefinition = UnrealObject->GetClass();
+	}
+
+	// Gather first, the number of properties is written before them
+	TArray<const FProperty*, TInlineAllocator<32>> Properties;
+	for (TFieldIterator<const FProperty> It(StructDefinition); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (!ensure(Property))
+			continue;
+
+		// Check to see if we should ignore this property
+		if (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags))
+		{
+			continue;
+		}
+		if (CanSkipProperty(Property))
+		{
+			continue;
+		}
+
+		Properties.Add(Property);
+	}
+
+	FDlgBinaryFormat::WriteVarUInt(Ar, Properties.Num());
+	for (const FProperty* Property : Properties)
+	{
+		FPropertyStringIndices* Indices = PropertyStringIndices.Find(Property);
+		if (Indices == nullptr)
+		{
+			Indices = &PropertyStringIndices.Add(Property);
+			Indices->Name = GetStringIndex(Property->GetName());
+			Indices->Type = GetStringIndex(FDlgBinaryFormat::GetPropertyTypeName(Property));
+		}
+		FDlgBinaryFormat::WriteVarUInt(Ar, Indices->Name);
+		FDlgBinaryFormat::WriteVarUInt(Ar, Indices->Type);
+
+		// Reserve the payload size, patched after the payload is written
+		const int64 PayloadSizeOffset = Ar.Tell();
+		uint32 PayloadSize = 0;
+		Ar << PayloadSize;
+
+		WriteProperty(Ar, Property, Property->ContainerPtrToValuePtr<void>(ContainerPtr, 0));
+
+		const int64 PayloadEndOffset = Ar.Tell();
+		PayloadSize = static_cast<uint32>(PayloadEndOffset - PayloadSizeOffset - sizeof(uint32));
+		Ar.Seek(PayloadSizeOffset);
+		Ar << PayloadSize;
+		Ar.Seek(PayloadEndOffset);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryWriter::WriteProperty(FArchive& Ar, const FProperty* Property, const void* ValuePtr)
+{
+	check(Property);
+
+	// Scalar Only one property
+	if (Property->ArrayDim == 1)
+	{
+		WriteScalarProperty(Ar, Property, ValuePtr);
+		return;
+	}
+
+	// Static array
+#if NY_ENGINE_VERSION >= 505
+	const int32 ElementSize = Property->GetElementSize();
+#else
+	const int32 ElementSize = Property->ElementSize;
+#endif
+
+	FDlgBinaryFormat::WriteVarUInt(Ar, Property->ArrayDim);
+	const uint8* ValueIntPtr = static_cast<const uint8*>(ValuePtr);
+	for (int32 Index = 0; Index < Property->ArrayDim; Index++)
+	{
+		WriteScalarProperty(Ar, Property, ValueIntPtr + Index * ElementSize);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryWriter::WriteScalarProperty(FArchive& Ar, const FProperty* Property, const void* ValuePtr)
+{
+	check(Property);
+	check(ValuePtr);
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgBinaryWriter, Verbose, TEXT("WriteScalarProperty, Property = `%s`"), *Property->GetPathName());
+	}
+
+	// Enum, by name so that reordering the enum values does not break the files
+	if (const auto* EnumProperty = FNYReflectionHelper::CastProperty<FEnumProperty>(Property))
+	{
+		const int64 Value = EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(ValuePtr);
+		WriteString(Ar, EnumProperty->GetEnum()->GetNameByValue(Value).ToString());
+		return;
+	}
+
+	// Numeric, int, float, possible enum
+	if (const auto* NumericProperty = FNYReflectionHelper::CastProperty<FNumericProperty>(Property))
+	{
+		if (const UEnum* EnumDefinition = NumericProperty->GetIntPropertyEnum())
+		{
+			const int64 Value = NumericProperty->GetSignedIntPropertyValue(ValuePtr);
+			WriteString(Ar, EnumDefinition->GetNameByValue(Value).ToString());
+		}
+		else if (NumericProperty->IsInteger())
+		{
+			FDlgBinaryFormat::WriteVarInt(Ar, NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+		}
+		else if (Property->IsA<FDoubleProperty>())
+		{
+			double Value = NumericProperty->GetFloatingPointPropertyValue(ValuePtr);
+			Ar << Value;
+		}
+		else
+		{
+			float Value = static_cast<float>(NumericProperty->GetFloatingPointPropertyValue(ValuePtr));
+			Ar << Value;
+		}
+		return;
+	}
+
+	// Bool
+	if (const auto* BoolProperty = FNYReflectionHelper::CastProperty<FBoolProperty>(Property))
+	{
+		uint8 Value = BoolProperty->GetPropertyValue(ValuePtr) ? 1 : 0;
+		Ar << Value;
+		return;
+	}
+
+	// FString
+	if (const auto* StringProperty = FNYReflectionHelper::CastProperty<FStrProperty>(Property))
+	{
+		FString Value = StringProperty->GetPropertyValue(ValuePtr);
+		Ar << Value;
+		return;
+	}
+
+	// FName
+	if (const auto* NameProperty = FNYReflectionHelper::CastProperty<FNameProperty>(Property))
+	{
+		WriteString(Ar, NameProperty->GetPropertyValue(ValuePtr).ToString());
+		return;
+	}
+
+	// FText, same as the text formats, only the string
+	if (const auto* TextProperty = FNYReflectionHelper::CastProperty<FTextProperty>(Property))
+	{
+		FString Value = TextProperty->GetPropertyValue(ValuePtr).ToString();
+		Ar << Value;
+		return;
+	}
+
+	// TArray
+	if (const auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(Property))
+	{
+		const FDlgConstScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+		const int32 Num = Helper.Num();
+		FDlgBinaryFormat::WriteVarUInt(Ar, Num);
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			WriteScalarProperty(Ar, ArrayProperty->Inner, Helper.GetConstRawPtr(Index));
+		}
+		return;
+	}
+
+	// TSet
+	if (const auto* SetProperty = FNYReflectionHelper::CastProperty<FSetProperty>(Property))
+	{
+		const FScriptSetHelper Helper(SetProperty, ValuePtr);
+		FDlgBinaryFormat::WriteVarUInt(Ar, Helper.Num());
+
+		// GetMaxIndex() instead of Num() - the container is not contiguous
+		for (int32 Index = 0; Index < Helper.GetMaxIndex(); Index++)
+		{
+			if (Helper.IsValidIndex(Index))
+			{
+				WriteScalarProperty(Ar, SetProperty->ElementProp, Helper.GetElementPtr(Index));
+			}
+		}
+		return;
+	}
+
+	// TMap
+	if (const auto* MapProperty = FNYReflectionHelper::CastProperty<FMapProperty>(Property))
+	{
+		const FDlgConstScriptMapHelper Helper(MapProperty, ValuePtr);
+		FDlgBinaryFormat::WriteVarUInt(Ar, Helper.Num());
+
+		// GetMaxIndex() instead of Num() - the container is not contiguous
+		for (int32 Index = 0; Index < Helper.GetMaxIndex(); Index++)
+		{
+			if (Helper.IsValidIndex(Index))
+			{
+				WriteScalarProperty(Ar, Helper.GetKeyProperty(), Helper.GetConstKeyPtr(Index));
+				WriteScalarProperty(Ar, Helper.GetValueProperty(), Helper.GetConstValuePtr(Index));
+			}
+		}
+		return;
+	}
+
+	// UStruct
+	if (const auto* StructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(Property))
+	{
+		// Same as the JSON writer, structs with native export are written as their text
+		UScriptStruct::ICppStructOps* TheCppStructOps = StructProperty->Struct->GetCppStructOps();
+		if (TheCppStructOps && TheCppStructOps->HasExportTextItem())
+		{
+			uint8 Tag = static_cast<uint8>(FDlgBinaryFormat::EStructTag::ExportedText);
+			Ar << Tag;
+
+			FString Value;
+			TheCppStructOps->ExportTextItem(Value, ValuePtr, ValuePtr, nullptr, PPF_None, nullptr);
+			Ar << Value;
+			return;
+		}
+
+		uint8 Tag = static_cast<uint8>(FDlgBinaryFormat::EStructTag::Properties);
+		Ar << Tag;
+		WriteStruct(Ar, StructProperty->Struct, ValuePtr);
+		return;
+	}
+
+	// UObject
+	if (const auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property))
+	{
+		const UObject* Object = ObjectProperty->GetObjectPropertyValue(ValuePtr);
+		if (Object != nullptr && !Object->IsValidLowLevelFast())
+		{
+			// Memory corruption?
+			UE_LOG(
+				LogDlgBinaryWriter,
+				Error,
+				TEXT("Object.IsValidLowLevelFast is false for Property = `%s`. Memory corruption for UObjects?"),
+				*Property->GetPathName()
+			);
+			Object = nullptr;
+		}
+
+		if (Object == nullptr)
+		{
+			uint8 Tag = static_cast<uint8>(FDlgBinaryFormat::EObjectTag::Null);
+			Ar << Tag;
+			return;
+		}
+
+		// Special case were we want just to save a reference to the object location
+		if (CanSaveAsReference(ObjectProperty, Object))
+		{
+			uint8 Tag = static_cast<uint8>(FDlgBinaryFormat::EObjectTag::Reference);
+			Ar << Tag;
+
+			FString PathName = Object->GetPathName();
+			Ar << PathName;
+			return;
+		}
+
+		// The type because objects can have inheritance
+		uint8 Tag = static_cast<uint8>(FDlgBinaryFormat::EObjectTag::Inline);
+		Ar << Tag;
+		WriteString(Ar, Object->GetClass()->GetName());
+		WriteStruct(Ar, Object->GetClass(), Object);
+		return;
+	}
+
+	// Default, convert to string
+	FString ValueString;
+#if NY_ENGINE_VERSION >= 501
+	Property->ExportTextItem_Direct(ValueString, ValuePtr, ValuePtr, nullptr, PPF_None);
+#else
+	Property->ExportTextItem(ValueString, ValuePtr, ValuePtr, nullptr, PPF_None);
+#endif
+	Ar << ValueString;
+}
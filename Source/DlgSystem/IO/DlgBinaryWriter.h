@@ -0,0 +1,91 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "Logging/LogMacros.h"
+#include "UObject/UnrealType.h"
+
+#include "IDlgWriter.h"
+#include "DlgBinaryFormat.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgBinaryWriter, All, All);
+
+/**
+ * @brief Writes the same data as the text writers but in the compact binary format described in DlgBinaryFormat.h
+ * Meant for build pipelines and tools, not for humans.
+ * See IDlgWriter for properties and METADATA specifiers.
+ */
+class DLGSYSTEM_API FDlgBinaryWriter : public IDlgWriter
+{
+	/**
+	 * Call Order and possible calls:
+	 *  - DlgBinaryWriter
+	 *		- Write
+	 *			- WriteStruct
+	 *				- WriteProperty
+	 *					- WriteScalarProperty
+	 *						- WriteScalarProperty
+	 *						- WriteStruct
+	 */
+public:
+	FDlgBinaryWriter() {}
+
+	// IDlgWriter Interface
+	void Write(const UStruct* StructDefinition, const void* ContainerPtr) override;
+
+	// The output is binary, this returns it encoded as Base64, the binary parser can read it back with InitializeParserFromString
+	const FString& GetAsString() const override;
+
+	// Writes the raw bytes
+	bool ExportToArchive(FArchive& Ar) const override;
+
+	const TArray<uint8>& GetAsBytes() const { return Bytes; }
+
+	// Hashes the raw bytes, no need to encode them
+	uint64 GetContentHash() const override
+	{
+		return CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), static_cast<uint32>(Bytes.Num()));
+	}
+
+private:
+	// Writes all the properties of the struct/object
+	void WriteStruct(FArchive& Ar, const UStruct* StructDefinition, const void* ContainerPtr);
+
+	// Writes a property that can be a static array (ArrayDim > 1)
+	void WriteProperty(FArchive& Ar, const FProperty* Property, const void* ValuePtr);
+
+	// Writes a single value of Property, ValuePtr points directly to the value
+	void WriteScalarProperty(FArchive& Ar, const FProperty* Property, const void* ValuePtr);
+
+	// Writes the index of String in the string table
+	void WriteString(FArchive& Ar, const FString& String)
+	{
+		FDlgBinaryFormat::WriteVarUInt(Ar, GetStringIndex(String));
+	}
+
+	int32 GetStringIndex(const FString& String);
+
+private:
+	// Final output
+	TArray<uint8> Bytes;
+
+	// Lazily encoded from Bytes in GetAsString
+	mutable FString Base64String;
+
+	// String table
+	TArray<FString> Strings;
+	TMap<FString, int32> StringIndices;
+
+	// Property => index of its name and type in the string table, so those are only computed once per property
+	struct FPropertyStringIndices
+	{
+		int32 Name = INDEX_NONE;
+		int32 Type = INDEX_NONE;
+	};
+	TMap<const FProperty*, FPropertyStringIndices> PropertyStringIndices;
+
+	// Minimum number of bytes reserved for the output when no OutputSizeHint is set
+	static constexpr int32 DefaultOutputReserveSize = 4 * 1024;
+
+	/** Only properties that have these flags will be written. */
+	static constexpr int64 CheckFlags = ~CPF_ParmFlags;
+};
@@ -0,0 +1,211 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgClassNameIndex.h"
+
+#include "UObject/Class.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "DlgSystem/NYEngineVersionHelpers.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgClassNameIndex::OnStart()
+{
+	Self& Index = Get();
+	Index.OnModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(&Index, &Self::HandleModulesChanged);
+#if WITH_EDITOR && NY_ENGINE_VERSION >= 500
+	// Blueprint compile replaces the old class with a new one. Before 5.0 the editor module binds UEditorEngine::OnObjectsReplaced
+	Index.OnObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddRaw(&Index, &Self::HandleObjectsReplaced);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgClassNameIndex::OnShutdown()
+{
+	Self& Index = Get();
+	if (Index.OnModulesChangedHandle.IsValid())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(Index.OnModulesChangedHandle);
+		Index.OnModulesChangedHandle.Reset();
+	}
+#if WITH_EDITOR && NY_ENGINE_VERSION >= 500
+	if (Index.OnObjectsReplacedHandle.IsValid())
+	{
+		FCoreUObjectDelegates::OnObjectsReplaced.Remove(Index.OnObjectsReplacedHandle);
+		Index.OnObjectsReplacedHandle.Reset();
+	}
+#endif
+
+	FWriteScopeLock WriteLock(Index.Lock);
+	Index.ClassesByName.Empty();
+	Index.MissingChildClasses.Empty();
+	Index.bIsDirty = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const UClass* FDlgClassNameIndex::FindChildClass(const UClass* ParentClass, const FString& Name)
+{
+	if (ParentClass == nullptr || Name.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	// If the name is not even in the name table there is no class with this name
+	const FName ClassName(*Name, FNAME_Find);
+	if (ClassName.IsNone())
+	{
+		return nullptr;
+	}
+
+	RebuildIfDirty();
+
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const UClass* Class = FindChildClassInIndex(ParentClass, ClassName))
+		{
+			return Class;
+		}
+
+		// Already looked up and not found
+		const TArray<const UClass*>* MissingParentClasses = MissingChildClasses.Find(ClassName);
+		if (MissingParentClasses && MissingParentClasses->Contains(ParentClass))
+		{
+			return nullptr;
+		}
+	}
+
+	// Not in the index, this class might have been loaded after the index was built
+	// More classes can have the same name (in different packages), the first one found might not be a child of ParentClass
+	TArray<UClass*> FoundClasses;
+#if NY_ENGINE_VERSION >= 501
+	// Use the name hash of the object system instead of iterating over all classes
+	TArray<UObject*> FoundObjects;
+	StaticFindAllObjectsFast(FoundObjects, UClass::StaticClass(), ClassName, false);
+	for (UObject* Object : FoundObjects)
+	{
+		FoundClasses.Add(CastChecked<UClass>(Object));
+	}
+#else
+	// Iterating over all objects is only safe on the game thread
+	if (!IsInGameThread())
+	{
+		return nullptr;
+	}
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->GetFName() == ClassName)
+		{
+			FoundClasses.Add(*It);
+		}
+	}
+#endif
+
+	const UClass* ChildClass = nullptr;
+	FWriteScopeLock WriteLock(Lock);
+	for (UClass* FoundClass : FoundClasses)
+	{
+		if (!IsIndexableClass(FoundClass))
+		{
+			continue;
+		}
+
+		// A new class with this name might be the child of a class we cached a miss for
+		TArray<TWeakObjectPtr<UClass>>& Classes = ClassesByName.FindOrAdd(ClassName);
+		if (!Classes.Contains(FoundClass))
+		{
+			Classes.Add(FoundClass);
+			MissingChildClasses.Remove(ClassName);
+		}
+		if (ChildClass == nullptr && FoundClass->IsChildOf(ParentClass))
+		{
+			ChildClass = FoundClass;
+		}
+	}
+
+	if (ChildClass == nullptr)
+	{
+		MissingChildClasses.FindOrAdd(ClassName).AddUnique(ParentClass);
+	}
+
+	return ChildClass;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgClassNameIndex::RebuildIfDirty()
+{
+	if (bIsDirty)
+	{
+		FWriteScopeLock WriteLock(Lock);
+		if (bIsDirty)
+		{
+			Rebuild();
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgClassNameIndex::Rebuild()
+{
+	ClassesByName.Empty(ClassesByName.Num());
+	MissingChildClasses.Empty();
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		if (IsIndexableClass(Class))
+		{
+			ClassesByName.FindOrAdd(Class->GetFName()).Add(Class);
+		}
+	}
+
+	bIsDirty = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const UClass* FDlgClassNameIndex::FindChildClassInIndex(const UClass* ParentClass, FName Name) const
+{
+	const TArray<TWeakObjectPtr<UClass>>* Classes = ClassesByName.Find(Name);
+	if (Classes == nullptr)
+	{
+		return nullptr;
+	}
+
+	for (const TWeakObjectPtr<UClass>& WeakClass : *Classes)
+	{
+		// Skip classes that were unloaded or replaced since the index was built
+		const UClass* Class = WeakClass.Get();
+		if (IsIndexableClass(Class) && Class->IsChildOf(ParentClass))
+		{
+			return Class;
+		}
+	}
+
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgClassNameIndex::IsIndexableClass(const UClass* Class)
+{
+	return IsValid(Class) && !Class->HasAnyClassFlags(CLASS_Abstract | CLASS_NewerVersionExists);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgClassNameIndex::HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (Reason == EModuleChangeReason::ModuleLoaded || Reason == EModuleChangeReason::ModuleUnloaded)
+	{
+		Invalidate();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgClassNameIndex::HandleObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	for (const auto& Elem : ReplacementMap)
+	{
+		if (Elem.Key != nullptr && Elem.Key->IsA<UClass>())
+		{
+			Invalidate();
+			return;
+		}
+	}
+}
@@ -0,0 +1,96 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include <atomic>
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/WeakObjectPtr.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UClass;
+
+/**
+ * Process wide index: class name => non abstract UClasses with that name.
+ * Shared by all the parsers so that finding the class of a type name read from a text file does not
+ * iterate over every UClass in the process.
+ *
+ * The index is built lazily on the first lookup and marked dirty when modules are (un)loaded or
+ * classes are replaced (blueprint compile), the next lookup rebuilds it.
+ * Classes not yet in the index (e.g. blueprints loaded after it was built) are looked up on a miss (by the name hash of the
+ * object system on 5.1+) and every class with that name is added to it. Before 5.1 that lookup iterates over all the classes
+ * so it only runs on the game thread, the parser worker threads only see the index.
+ * Misses are cached too, until the index is rebuilt or a class with that name is found.
+ */
+class DLGSYSTEM_API FDlgClassNameIndex
+{
+	typedef FDlgClassNameIndex Self;
+
+public:
+	static FDlgClassNameIndex& Get()
+	{
+		static FDlgClassNameIndex Instance;
+		return Instance;
+	}
+
+	// Registers/Unregisters the invalidation delegates
+	static void OnStart();
+	static void OnShutdown();
+
+	/**
+	 * Searches the proper not abstract class
+	 *
+	 * @param ParentClass: the class we are looking for has to inherit from this class
+	 * @param Name: the name of the class we are looking for (without engine pretags, e.g. Actor for AActor)
+	 *
+	 * @return the class, or nullptr if it does not exist
+	 */
+	const UClass* FindChildClass(const UClass* ParentClass, const FString& Name);
+
+	// Marks the index as out of date, it will be rebuilt on the next lookup
+	void Invalidate() { bIsDirty = true; }
+
+	// Rebuilds the index now if it is out of date, call it on the game thread before handing the parsers to other threads
+	void RebuildIfDirty();
+
+	int32 Num() const
+	{
+		FReadScopeLock ReadLock(Lock);
+		return ClassesByName.Num();
+	}
+
+private:
+	FDlgClassNameIndex() {}
+
+	// Rebuilds the whole index from all the classes in memory. Expects the write lock to be held.
+	void Rebuild();
+
+	// Searches inside the bucket of Name. Expects a lock to be held.
+	const UClass* FindChildClassInIndex(const UClass* ParentClass, FName Name) const;
+
+	// Is Class a valid entry for the index
+	static bool IsIndexableClass(const UClass* Class);
+
+	// Handlers
+	void HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+
+public:
+	// Invalidates the index if a class was replaced. Before 5.0 the delegate lives in the editor engine, the editor module binds it.
+	void HandleObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+
+private:
+	// Class Name => Classes with that name (there can be more than one class with the same name in different packages)
+	TMap<FName, TArray<TWeakObjectPtr<UClass>>> ClassesByName;
+
+	// Class Name => Parent classes for which no child class with that name exists
+	TMap<FName, TArray<const UClass*>> MissingChildClasses;
+
+	// Guards ClassesByName and MissingChildClasses, the parsers can be used from multiple threads
+	mutable FRWLock Lock;
+
+	// Should the index be rebuilt on the next lookup
+	std::atomic<bool> bIsDirty{true};
+
+	FDelegateHandle OnModulesChangedHandle;
+	FDelegateHandle OnObjectsReplacedHandle;
+};
@@ -33,8 +33,7 @@ public:
 	/**
 	 *  Creates empty parser
 	 *  Call ReinitializeParser() on it to parse a file
-	 *  It is better to use a single parser for more files from the same type if those contain dynamic arrays,
-	 *  because it has to check all class names for the first time for each class
+	 *  Class names are resolved through the shared FDlgClassNameIndex, so creating a new parser per file is cheap
 	 */
 	FDlgConfigParser(const FString InPreTag = "");
 
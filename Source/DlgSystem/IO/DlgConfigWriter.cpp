@@ -28,6 +28,9 @@ FDlgConfigWriter::FDlgConfigWriter(const FString InComplexNamePrefix,
 void FDlgConfigWriter::Write(const UStruct* const StructDefinition, const void* const Object)
 {
 	TopLevelObjectPtr = Object;
+
+	// Pre-size the output so that appending does not have to grow the buffer over and over
+	ConfigText.Empty(FMath::Max(OutputSizeHint, DefaultOutputReserveSize));
 	WriteComplexMembersToString(StructDefinition, Object, "", EOL, ConfigText);
 }
 
@@ -207,7 +210,11 @@ bool FDlgConfigWriter::WritePrimitiveElementToString(const FProperty* Property,
 		{
 			const void* Value = EnumProp->ContainerPtrToValuePtr<uint8>(Object);
 			const FName EnumName = EnumProp->GetEnum()->GetNameByIndex(EnumProp->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value));
-			Target += PreS + Property->GetName() + " " + NameToString(EnumName) + PostS;
+			Target += PreS;
+			AppendPropertyName(Property, Target);
+			Target += TEXT(' ');
+			Target += NameToString(EnumName);
+			Target += PostS;
 			return true;
 		}
 	}
@@ -306,14 +313,16 @@ bool FDlgConfigWriter::WriteComplexElementToString(const FProperty* Property,
 		const FString Path = *ObjPtrPtr != nullptr ? (*ObjPtrPtr)->GetPathName() : "";
 		auto WritePathName = [&]()
 		{
-			if (bContainerElement)
-			{
-				Target += PreString + "\"" + Path + "\"" + PostString;
-			}
-			else
+			Target += PreString;
+			if (!bContainerElement)
 			{
-				Target += PreString + Property->GetName() + " \"" + Path + "\"" + PostString;
+				AppendPropertyName(Property, Target);
+				Target += TEXT(' ');
 			}
+			Target += TEXT('"');
+			Target += Path;
+			Target += TEXT('"');
+			Target += PostString;
 		};
 
 		if (CanSaveAsReference(ObjectProperty, *ObjPtrPtr) || bPointerAsRef)
@@ -369,20 +378,36 @@ void FDlgConfigWriter::WriteComplexToString(const UStruct* StructDefinition,
 
 	// WARNING: bWriteType implicates objectproperty, if that changes this code (cause of the object cast) should be updated accordingly
 	const FString TypeString = bWriteType ? GetNameWithoutPrefix(Property, UnrealObject) + " ": "";
+	Target += PreString;
+	Target += TypeString;
 	if (bContainerElement)
 	{
-		if (TypeString.Len() > 0)
+		if (TypeString.Len() > 0 && bLinePerMember)
 		{
-			Target += PreString + TypeString + (bLinePerMember ? EOL + PreString + "{" + EOL : "{ ");
+			Target += EOL;
+			Target += PreString;
+			Target += TEXT('{');
+			Target += EOL;
 		}
 		else
 		{
-			Target += PreString + (bLinePerMember ? "{" + EOL_String : "{ ");
+			Target += bLinePerMember ? TEXT("{\n") : TEXT("{ ");
 		}
 	}
 	else
 	{
-		Target += PreString + TypeString + Property->GetName() + (bLinePerMember ? EOL + PreString + "{" + EOL : " { ");
+		AppendPropertyName(Property, Target);
+		if (bLinePerMember)
+		{
+			Target += EOL;
+			Target += PreString;
+			Target += TEXT('{');
+			Target += EOL;
+		}
+		else
+		{
+			Target += TEXT(" { ");
+		}
 	}
 
 	// Write the properties of the Struct/Object
@@ -390,12 +415,14 @@ void FDlgConfigWriter::WriteComplexToString(const UStruct* StructDefinition,
 
 	if (bLinePerMember)
 	{
-		Target += PreString + "}" + PostString;
+		Target += PreString;
+		Target += TEXT('}');
 	}
 	else
 	{
-		Target += " }" + PostString;
+		Target += TEXT(" }");
 	}
+	Target += PostString;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -431,28 +458,41 @@ bool FDlgConfigWriter::WriteComplexArrayToString(const FProperty* Property,
 		TypeText = GetStringWithoutPrefix(ObjProp->PropertyClass->GetName()) + " ";
 	}
 
+	const bool bSaveAsReference = CanSaveAsReference(ArrayProp, nullptr);
+	Target += PreString;
+	Target += TypeText;
+	AppendPropertyName(ArrayProp->Inner, Target);
 	if (Helper.Num() == 1 && !WouldWriteNonPrimitive(GetComplexType(ArrayProp->Inner), Helper.GetConstRawPtr(0)))
 	{
-		Target += PreString + TypeText + ArrayProp->Inner->GetName() + " {";
+		Target += TEXT(" {");
 		for (int32 i = 0; i < Helper.Num(); ++i)
 		{
-			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, " ", "", CanSaveAsReference(ArrayProp, nullptr), Target);
+			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, " ", "", bSaveAsReference, Target);
 		}
-		Target += " }" + PostString;
+		Target += TEXT(" }");
+		Target += PostString;
 	}
 	else
 	{
-		Target += PreString + TypeText + ArrayProp->Inner->GetName() + EOL;
-		Target += PreString + "{" + EOL;
+		const FString SubPreString = PreString + "\t";
+		Target += EOL;
+		Target += PreString;
+		Target += TEXT('{');
+		Target += EOL;
 		for (int32 i = 0; i < Helper.Num(); ++i)
 		{
 			if (bWriteIndex)
 			{
-				Target += PreString + "\t// " + FString::FromInt(i) + EOL;
+				Target += SubPreString;
+				Target += TEXT("// ");
+				Target.AppendInt(i);
+				Target += EOL;
 			}
-			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, PreString + "\t", EOL, CanSaveAsReference(ArrayProp, nullptr), Target);
+			WriteComplexElementToString(ArrayProp->Inner, Helper.GetConstRawPtr(i), true, SubPreString, EOL, bSaveAsReference, Target);
 		}
-		Target += PreString + "}" + EOL;
+		Target += PreString;
+		Target += TEXT('}');
+		Target += EOL;
 	}
 
 	return true;
@@ -482,7 +522,9 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 	if (IsPrimitive(MapProp->KeyProp) && IsPrimitive(MapProp->ValueProp))
 	{
 		// Both Key and Value are primitives
-		Target += PreString + MapProp->GetName() + " { ";
+		Target += PreString;
+		AppendPropertyName(MapProp, Target);
+		Target += TEXT(" { ");
 
 		// GetMaxIndex() instead of Num() - the container is not contiguous
 		// elements are in [0, GetMaxIndex[, some of them are invalid (Num() returns with the valid element num)
@@ -496,13 +538,20 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 			WritePrimitiveElementToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, "", " ", Target);
 			WritePrimitiveElementToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, "", " ", Target);
 		}
-		Target += "}" + PostString;
+		Target += TEXT('}');
+		Target += PostString;
 	}
 	else
 	{
 		// Either Key or Value is not a primitive
-		Target += PreString + MapProp->GetName() + EOL;
-		Target += PreString + "{" + EOL;
+		const FString SubPreString = PreString + "\t";
+		const bool bSaveAsReference = CanSaveAsReference(MapProp, nullptr);
+		Target += PreString;
+		AppendPropertyName(MapProp, Target);
+		Target += EOL;
+		Target += PreString;
+		Target += TEXT('{');
+		Target += EOL;
 
 		// GetMaxIndex() instead of Num() - the container is not contiguous
 		// elements are in [0, GetMaxIndex[, some of them are invalid (Num() returns with the valid element num)
@@ -513,10 +562,12 @@ bool FDlgConfigWriter::WriteMapToString(const FProperty* Property,
 				continue;
 			}
 
-			WritePropertyToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, PreString + "\t", EOL, CanSaveAsReference(MapProp, nullptr), Target);
-			WritePropertyToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, PreString + "\t", EOL, CanSaveAsReference(MapProp, nullptr), Target);
+			WritePropertyToString(MapProp->KeyProp, Helper.GetPairPtr(i), true, SubPreString, EOL, bSaveAsReference, Target);
+			WritePropertyToString(MapProp->ValueProp, Helper.GetPairPtr(i), true, SubPreString, EOL, bSaveAsReference, Target);
 		}
-		Target += PreString + "}" + EOL;
+		Target += PreString;
+		Target += TEXT('}');
+		Target += EOL;
 	}
 
 	return true;
@@ -547,19 +598,29 @@ bool FDlgConfigWriter::WriteSetToString(const FProperty* Property,
 	{
 		const bool bLinePerItem = CanWriteOneLinePerItem(SetProp);
 
-		// Add space indentation
-		FString SubPreString = PreString;
-		for (int32 i = 0; i < SetProp->GetName().Len() + 3; ++i)
+		// Add space indentation, the new line is part of it
+		const FString PropertyName = SetProp->GetName();
+		FString SubPreString;
+		if (bLinePerItem)
 		{
-			SubPreString += " ";
+			SubPreString.Reserve(1 + PreString.Len() + PropertyName.Len() + 3);
+			SubPreString += EOL;
+			SubPreString += PreString;
+			SubPreString.Append(TEXT("   "));
+			for (int32 i = 0; i < PropertyName.Len(); ++i)
+			{
+				SubPreString += TEXT(' ');
+			}
 		}
 
 		// SetName {
-		Target += PreString + SetProp->GetName() + " {";
+		Target += PreString;
+		Target += PropertyName;
+		Target += TEXT(" {");
 		if (!bLinePerItem)
 		{
 			// Add space because there is no new line
-			Target += " ";
+			Target += TEXT(' ');
 		}
 
 		// Set content
@@ -573,7 +634,7 @@ bool FDlgConfigWriter::WriteSetToString(const FProperty* Property,
 
 			if (bLinePerItem)
 			{
-				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, EOL + SubPreString, "", Target);
+				WritePrimitiveElementToString(SetProp->ElementProp, Helper.GetElementPtr(i), true, SubPreString, "", Target);
 			}
 			else
 			{
@@ -582,7 +643,12 @@ bool FDlgConfigWriter::WriteSetToString(const FProperty* Property,
 		}
 
 		// }
-		Target += (bLinePerItem ? " " : "") + FString("}") + PostString;
+		if (bLinePerItem)
+		{
+			Target += TEXT(' ');
+		}
+		Target += TEXT('}');
+		Target += PostString;
 	}
 	else
 	{
@@ -46,15 +46,6 @@ public:
 	/** Has to be called to prepare the text data */
 	void Write(const UStruct* StructDefinition, const void* Object) override;
 
-	/**
-	 * Save the config string to a text file
-	 * @param FullName: Full path + file name + extension
-	 */
-	bool ExportToFile(const FString& FileName) override
-	{
-		return FFileHelper::SaveStringToFile(ConfigText, *FileName, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
-	}
-
 	const FString& GetAsString() const override
 	{
 		return ConfigText;
@@ -144,7 +135,7 @@ protected:
 	bool WritePrimitiveElementToStringTemplated(const FProperty* Property,
 												const void* Object,
 												bool bContainerElement,
-												std::function<FString(const VariableType&)> GetAsString,
+												const std::function<FString(const VariableType&)>& GetAsString,
 												const FString& PreString,
 												const FString& PostString,
 												FString& Target)
@@ -152,10 +143,14 @@ protected:
 		const PropertyType* CastedProperty = FNYReflectionHelper::CastProperty<PropertyType>(Property);
 		if (CastedProperty != nullptr)
 		{
-			Target += PreString +
-					  (bContainerElement ? "" : (CastedProperty->GetName() + " ")) +
-					  GetAsString(CastedProperty->GetPropertyValue_InContainer(Object, 0)) +
-					  PostString;
+			Target += PreString;
+			if (!bContainerElement)
+			{
+				AppendPropertyName(CastedProperty, Target);
+				Target += TEXT(' ');
+			}
+			Target += GetAsString(CastedProperty->GetPropertyValue_InContainer(Object, 0));
+			Target += PostString;
 			return true;
 		}
 
@@ -166,7 +161,7 @@ protected:
 	template <typename PropertyType, typename VariableType>
 	bool WritePrimitiveArrayToStringTemplated(const FArrayProperty* ArrayProp,
 											  const void* Object,
-											  std::function<FString(const VariableType&)> ToString,
+											  const std::function<FString(const VariableType&)>& ToString,
 											  const FString& PreString,
 											  const FString& PostString,
 											  FString& Target)
@@ -184,37 +179,54 @@ protected:
 		const bool bLinePerItem = CanWriteOneLinePerItem(ArrayProp);
 
 		// Empty array
-		const TArray<VariableType> Array = *ArrayPtr;
+		const TArray<VariableType>& Array = *ArrayPtr;
 		if (Array.Num() == 0 && bDontWriteEmptyContainer)
 		{
 			return true;
 		}
 
 		// Establish indentation to be the same as the ArrayName.len + 3 spaces
-		FString SubPreString = PreString;
-		for (int32 i = 0; i < ArrayProp->GetName().Len() + 3; ++i)
+		const FString PropertyName = ArrayProp->GetName();
+		FString SubPreString;
+		if (bLinePerItem)
 		{
-			SubPreString += " ";
+			SubPreString.Reserve(PreString.Len() + PropertyName.Len() + 3);
+			SubPreString += PreString;
+			SubPreString.Append(TEXT("   "));
+			for (int32 i = 0; i < PropertyName.Len(); ++i)
+			{
+				SubPreString += TEXT(' ');
+			}
 		}
 
 		// ArrayName {
-		Target += PreString + ArrayProp->GetName() + " {" + (bLinePerItem ? EOL_String : " ");
+		Target += PreString;
+		Target += PropertyName;
+		Target += bLinePerItem ? TEXT(" {\n") : TEXT(" { ");
 
 		// Array content
 		for (int32 i = 0; i < Array.Num(); ++i)
 		{
 			if (bLinePerItem)
 			{
-				Target += SubPreString + ToString(Array[i]) + EOL;
+				Target += SubPreString;
+				Target += ToString(Array[i]);
+				Target += EOL;
 			}
 			else
 			{
-				Target += ToString(Array[i]) + " ";
+				Target += ToString(Array[i]);
+				Target += TEXT(' ');
 			}
 		}
 
 		// }
-		Target += (bLinePerItem ? PreString : "") + "}" + PostString;
+		if (bLinePerItem)
+		{
+			Target += PreString;
+		}
+		Target += TEXT('}');
+		Target += PostString;
 
 		return true;
 	}
@@ -224,7 +236,7 @@ protected:
 	bool WritePrimitiveToStringTemplated(const FProperty* Property,
 										 const void* Object,
 										 bool bContainerElement,
-										 std::function<FString(const VariableType&)> GetAsString,
+										 const std::function<FString(const VariableType&)>& GetAsString,
 										 const FString& PreString,
 										 const FString& PostString,
 										 FString& Target)
@@ -232,19 +244,34 @@ protected:
 		const PropertyType* CastedProperty = FNYReflectionHelper::CastProperty<PropertyType>(Property);
 		if (CastedProperty != nullptr)
 		{
-			Target += PreString +
-					  (bContainerElement ? "" : (CastedProperty->GetName() + " ")) +
-					  GetAsString(*((VariableType*)(Object))) +
-					  PostString;
+			Target += PreString;
+			if (!bContainerElement)
+			{
+				AppendPropertyName(CastedProperty, Target);
+				Target += TEXT(' ');
+			}
+			Target += GetAsString(*((VariableType*)(Object)));
+			Target += PostString;
 			return true;
 		}
 
 		return false;
 	}
 
+	/** Appends the name of the property without allocating a temporary string. */
+	static void AppendPropertyName(const FProperty* Property, FString& Target)
+	{
+		Property->GetFName().AppendString(Target);
+	}
+
 	/** Converts all endlines to be of one type. */
 	static FString NormalizeEndlines(const FString& Original)
 	{
+		// Only allocate a new string if there is something to replace
+		if (!Original.Contains(EOL_CRLF, ESearchCase::CaseSensitive))
+		{
+			return Original;
+		}
 		return Original.Replace(EOL_CRLF, EOL_LF, ESearchCase::IgnoreCase);
 	}
 
@@ -257,6 +284,9 @@ private:
 	// Helper strings
 	static const FString EOL_String;
 
+	// Minimum number of characters reserved for the output when no OutputSizeHint is set
+	static constexpr int32 DefaultOutputReserveSize = 4 * 1024;
+
 	FString ConfigText = "";
 
 	const void* TopLevelObjectPtr = nullptr;
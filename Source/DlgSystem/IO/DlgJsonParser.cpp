@@ -72,23 +72,36 @@ void FDlgJsonParser::InitializeParser(const FString& FilePath)
 	if (FFileHelper::LoadFileToString(JsonString, *FilePath))
 	{
 		FileName = FPaths::GetBaseFilename(FilePath, true);
-		bIsValidFile = true;
+		bIsValidFile = DeserializeJsonString();
 	}
 	else
 	{
 		UE_LOG(LogDlgJsonParser, Error, TEXT("Failed to load config file %s"), *FilePath);
 		bIsValidFile = false;
 	}
-
-	// TODO check here if the JSON file is valid.
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void FDlgJsonParser::InitializeParserFromString(const FString& Text)
 {
 	JsonString = Text;
-	bIsValidFile = true;
 	FileName = "";
+	bIsValidFile = DeserializeJsonString();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgJsonParser::DeserializeJsonString()
+{
+	JsonObject.Reset();
+	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogDlgJsonParser, Error, TEXT("DeserializeJsonString - Unable to parse json=[%s]"), *JsonString);
+		JsonObject.Reset();
+		return false;
+	}
+
+	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -865,11 +878,8 @@ bool FDlgJsonParser::JsonAttributesToUStruct(const TMap<FString, TSharedPtr<FJso
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgJsonParser::JsonObjectStringToUStruct(const UStruct* StructDefinition, void* ContainerPtr)
 {
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
-	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+	if (!JsonObject.IsValid() && !DeserializeJsonString())
 	{
-		UE_LOG(LogDlgJsonParser, Error, TEXT("JsonObjectStringToUStruct - Unable to parse json=[%s]"), *JsonString);
 		return false;
 	}
 	if (!JsonObjectToUStruct(JsonObject.ToSharedRef(), StructDefinition, ContainerPtr))
@@ -21,6 +21,8 @@ class DLGSYSTEM_API FDlgJsonParser : public IDlgParser
 	 * Call Order and possible calls:
 	 *  - DlgJsonParser
 	 *		- InitializeParser
+	 *			- DeserializeJsonString
+	 *		- ReadAllProperty
 	 *			- JsonObjectStringToUStruct
 	 *				- JsonObjectToUStruct
 	 *					- JsonAttributesToUStruct
@@ -100,8 +102,15 @@ private: // JSON -> UStruct
 	 */
 	bool JsonObjectStringToUStruct(const UStruct* StructDefinition, void* ContainerPtr);
 
+	/**
+	 * Parses JsonString into JsonObject. Done when initializing so that the file is validated up front
+	 * and so that batch imports can do the parsing on worker threads, only ReadAllProperty touches UObjects.
+	 */
+	bool DeserializeJsonString();
+
 private:
 	FString JsonString;
+	TSharedPtr<FJsonObject> JsonObject;
 	FString FileName;
 	bool bIsValidFile = false;
 
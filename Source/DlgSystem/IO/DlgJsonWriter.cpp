@@ -20,6 +20,9 @@ void FDlgJsonWriter::Write(const UStruct* StructDefinition, const void* Containe
 	DlgJsonWriterOptions WriterOptions;
 	WriterOptions.bPrettyPrint = true;
 	WriterOptions.InitialIndent = 0;
+
+	// Pre-size the output so that the json printer does not have to grow the buffer over and over
+	JsonString.Empty(FMath::Max(OutputSizeHint, DefaultOutputReserveSize));
 	UStructToJsonString(StructDefinition, ContainerPtr, WriterOptions, JsonString);
 }
 
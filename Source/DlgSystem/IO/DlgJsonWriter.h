@@ -42,16 +42,6 @@ public:
 	// IDlgWriter Interface
 	void Write(const UStruct* StructDefinition, const void* ContainerPtr) override;
 
-	/**
-	 * Save the config string to a text file
-	 * @param FullName: Full path + file name + extension
-	 * @return	False on failure to write
-	 */
-	bool ExportToFile(const FString& FileName) override
-	{
-		return FFileHelper::SaveStringToFile(JsonString, *FileName, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
-	}
-
 	const FString& GetAsString() const override
 	{
 		return JsonString;
@@ -122,6 +112,9 @@ private:
 	// Final output string
 	FString JsonString;
 
+	// Minimum number of characters reserved for the output when no OutputSizeHint is set
+	static constexpr int32 DefaultOutputReserveSize = 4 * 1024;
+
 	/** Only properties that have these flags will be written. */
 	static constexpr int64 CheckFlags = ~CPF_ParmFlags; // all properties except those who have these flags? TODO is this ok?
 
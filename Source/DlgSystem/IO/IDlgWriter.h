@@ -4,6 +4,9 @@
 #include "CoreMinimal.h"
 #include "UObject/UnrealType.h"
 #include "UObject/Package.h"
+#include "Serialization/Archive.h"
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
 
 /**
  * The writer will ignore properties by default that are marked DEPRECATED or TRANSIENT, see SkipFlags variable.
@@ -33,9 +36,77 @@ public:
 
 	/** Has to be called before ExportToFile in order to have something to write */
 	virtual void Write(const UStruct* StructDefinition, const void* Object) = 0;
-	virtual bool ExportToFile(const FString& FileName) = 0;
 	virtual const FString& GetAsString() const = 0;
 
+	/**
+	 * Streams the written text as UTF-8 (without BOM) into the archive.
+	 * The text is converted in fixed size chunks so no second full size copy of the output is ever allocated.
+	 * @return False on failure to write
+	 */
+	virtual bool ExportToArchive(FArchive& Ar) const
+	{
+		const FString& Text = GetAsString();
+		const TCHAR* TextPtr = *Text;
+		const int32 TextLen = Text.Len();
+
+		int32 Offset = 0;
+		while (Offset < TextLen)
+		{
+			int32 ChunkLen = FMath::Min(ExportChunkSize, TextLen - Offset);
+
+			// Do not split an UTF-16 surrogate pair between two chunks
+			const TCHAR LastChar = TextPtr[Offset + ChunkLen - 1];
+			if (Offset + ChunkLen < TextLen && (LastChar & 0xFC00) == 0xD800)
+			{
+				ChunkLen++;
+			}
+
+			const FTCHARToUTF8 Converted(TextPtr + Offset, ChunkLen);
+			Ar.Serialize(const_cast<void*>(static_cast<const void*>(Converted.Get())), Converted.Length());
+			Offset += ChunkLen;
+		}
+
+		return !Ar.IsError();
+	}
+
+	/**
+	 * Save the written text to a text file (UTF-8 without BOM)
+	 * @param FileName: Full path + file name + extension
+	 * @return False on failure to write
+	 */
+	virtual bool ExportToFile(const FString& FileName)
+	{
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FileName));
+		if (!FileWriter)
+		{
+			return false;
+		}
+
+		const bool bSuccess = ExportToArchive(*FileWriter);
+		return FileWriter->Close() && bSuccess;
+	}
+
+	/**
+	 * Hash of the written content, equal content gives an equal hash.
+	 * Used to skip rewriting a text file whose content did not change, see UDlgDialogue::ExportToTextFile.
+	 */
+	virtual uint64 GetContentHash() const
+	{
+		return HashText(GetAsString());
+	}
+
+	static uint64 HashText(const FString& Text)
+	{
+		return CityHash64(reinterpret_cast<const char*>(*Text), static_cast<uint32>(Text.Len() * sizeof(TCHAR)));
+	}
+
+	/**
+	 * Hint about how many characters the output will have, used to pre-size the output buffer before writing.
+	 * A good estimate is the size of the previous export of the same object.
+	 */
+	void SetOutputSizeHint(int32 NumCharacters) { OutputSizeHint = FMath::Max(0, NumCharacters); }
+	int32 GetOutputSizeHint() const { return OutputSizeHint; }
+
 	/** Can we skip this property from exporting? */
 	static bool CanSkipProperty(const FProperty* Property)
 	{
@@ -111,6 +182,12 @@ protected:
 	/** The properties with these flags set will be ignored from writing. */
 	static constexpr int64 SkipFlags = CPF_Deprecated | CPF_Transient;
 
+	/** Number of characters converted to UTF-8 at once in ExportToArchive. */
+	static constexpr int32 ExportChunkSize = 16 * 1024;
+
 	// Should this class verbose log?
 	bool bLogVerbose = false;
+
+	// Number of characters to reserve in the output before writing
+	int32 OutputSizeHint = 0;
 };
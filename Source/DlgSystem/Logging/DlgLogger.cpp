@@ -35,6 +35,8 @@ FDlgLogger& FDlgLogger::SyncWithSettings()
 	SetRedirectMessageLogLevelsHigherThan(Settings->RedirectMessageLogLevelsHigherThan);
 	SetOpenMessageLogLevelsHigherThan(Settings->OpenMessageLogLevelsHigherThan);
 	SetMessageLogOpenOnNewMessage(Settings->bMessageLogOpen);
+	SetRateLimitSeconds(Settings->LogRateLimitSeconds);
+	UseAsyncOutputLog(Settings->bAsyncOutputLog);
 
 	return *this;
 }
@@ -8,6 +8,8 @@
 #include "GameFramework/PlayerController.h"
 #include "Engine/Engine.h"
 #include "Logging/MessageLog.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
 #include "DlgSystem/NYEngineVersionHelpers.h"
 #include "Runtime/Launch/Resources/Version.h"
 
@@ -81,6 +83,12 @@
 		FMemory::SystemFree(AllocatedBuffer);
 #endif
 
+// Guards the RateLimitedMessages of all the loggers, a member would make the loggers non copyable
+static FCriticalSection RateLimitCriticalSection;
+
+// Above this the messages not logged for a while are forgotten
+static constexpr int32 MAX_RATE_LIMITED_MESSAGES = 1024;
+
 INYLogger& INYLogger::SetClientConsolePlayerController(APlayerController* PC)
 {
 	PlayerController = PC;
@@ -191,6 +199,70 @@ void INYLogger::MessageLogOpenLogName(FName LogName)
 #endif // WITH_UNREAL_DEVELOPER_TOOLS
 }
 
+void INYLogger::ResetRateLimits()
+{
+	FScopeLock Lock(&RateLimitCriticalSection);
+	RateLimitedMessages.Empty();
+}
+
+void INYLogger::ForgetRateLimits(const void* Owner)
+{
+	FScopeLock Lock(&RateLimitCriticalSection);
+	for (auto It = RateLimitedMessages.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key == Owner)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool INYLogger::ShouldLogRateLimited(const void* Owner, uint32 MessageKey, int32& OutNumSkipped)
+{
+	OutNumSkipped = 0;
+	if (RateLimitSeconds <= 0.f)
+	{
+		return true;
+	}
+
+	const double NowSeconds = FPlatformTime::Seconds();
+	FScopeLock Lock(&RateLimitCriticalSection);
+	if (FNYRateLimitedMessage* Message = RateLimitedMessages.Find(TPair<const void*, uint32>(Owner, MessageKey)))
+	{
+		if (NowSeconds - Message->LastLogSeconds < RateLimitSeconds)
+		{
+			Message->NumSkipped++;
+			return false;
+		}
+
+		OutNumSkipped = Message->NumSkipped;
+		Message->LastLogSeconds = NowSeconds;
+		Message->NumSkipped = 0;
+		return true;
+	}
+
+	if (RateLimitedMessages.Num() >= MAX_RATE_LIMITED_MESSAGES)
+	{
+		for (auto It = RateLimitedMessages.CreateIterator(); It; ++It)
+		{
+			if (NowSeconds - It.Value().LastLogSeconds >= RateLimitSeconds)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		// Everything is recent, owners are being created and destroyed too fast to be worth tracking
+		if (RateLimitedMessages.Num() >= MAX_RATE_LIMITED_MESSAGES)
+		{
+			RateLimitedMessages.Empty();
+		}
+	}
+
+	FNYRateLimitedMessage& NewMessage = RateLimitedMessages.Add(TPair<const void*, uint32>(Owner, MessageKey));
+	NewMessage.LastLogSeconds = NowSeconds;
+	return true;
+}
+
 void INYLogger::LogfImplementation(ENYLoggerLogLevel Level, const TCHAR* Fmt, ...)
 {
 #if !NO_LOGGING
@@ -313,6 +385,16 @@ void INYLogger::LogOutputLog(ENYLoggerLogLevel Level, const FString& Message)
 	}
 
 	const ELogVerbosity::Type UnrealLogType = GetUnrealLogTypeForLogLevel(Level);
+	if (bAsyncOutputLog)
+	{
+		// Through GLog as it is thread safe, it buffers what does not come from the main thread
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Category = OutputLogCategory, UnrealLogType, Message]()
+		{
+			GLog->Log(Category, UnrealLogType, Message);
+		});
+		return;
+	}
+
 	LogDevice->Log(OutputLogCategory, UnrealLogType, Message);
 }
 
@@ -223,7 +223,7 @@ public:
 	//
 
 	Self& EnableMessageLog(bool bSuppressLoggingToOutputLog = false) { return UseMessageLog(true, bSuppressLoggingToOutputLog); }
-	Self& DisableMessageLog() { return UseMessageLog(true); }
+	Self& DisableMessageLog() { return UseMessageLog(false); }
 	Self& UseMessageLog(bool bValue, bool bInMessageLogMirrorToOutputLog = true)
 	{
 		bMessageLog = bValue;
@@ -283,6 +283,31 @@ public:
 		return *this;
 	}
 
+	//
+	// Rate limiting and async output, see LogLazy
+	//
+
+	// The same message of the same owner is logged at most once per Seconds by LogLazy, 0 disables the limit
+	Self& SetRateLimitSeconds(float Seconds)
+	{
+		RateLimitSeconds = FMath::Max(Seconds, 0.f);
+		return *this;
+	}
+
+	// Writes to the output log from a background task so that the output devices do not run on the calling thread.
+	// The message log is not affected, it is only written on the game thread.
+	Self& UseAsyncOutputLog(bool bValue)
+	{
+		bAsyncOutputLog = bValue;
+		return *this;
+	}
+
+	// Forgets the messages that were rate limited
+	void ResetRateLimits();
+
+	// Forgets the messages of the Owner, call it when the Owner is destroyed as the messages are keyed by its address
+	void ForgetRateLimits(const void* Owner);
+
 	//
 	// Public accessors
 	//
@@ -292,6 +317,18 @@ public:
 	FORCEINLINE bool IsOnScreenEnabled() const { return bOnScreen; }
 	FORCEINLINE bool IsOutputLogEnabled() const { return bOutputLog; }
 	FORCEINLINE bool IsMessageLogEnabled() const { return bMessageLog; }
+	FORCEINLINE float GetRateLimitSeconds() const { return RateLimitSeconds; }
+	FORCEINLINE bool IsAsyncOutputLogEnabled() const { return bAsyncOutputLog; }
+
+	// Would a message be written anywhere
+	FORCEINLINE bool IsAnyOutputEnabled() const
+	{
+#if NO_LOGGING
+		return false;
+#else
+		return bClientConsole || bOnScreen || bOutputLog || bMessageLog;
+#endif
+	}
 
 	template <typename FmtType, typename... Types>
 	void Logf(ENYLoggerLogLevel Level, const FmtType& Fmt, Types... Args)
@@ -332,9 +369,57 @@ public:
 	FORCEINLINE void Debug(const FString& Message) { Log(ENYLoggerLogLevel::Debug, Message); }
 	FORCEINLINE void Trace(const FString& Message) { Log(ENYLoggerLogLevel::Trace, Message); }
 
+	/**
+	 * For the messages that can be logged every frame by misconfigured content.
+	 * MakeMessage returns the FString to log and is only called if an output is enabled and if the same MessageKey
+	 * of the same Owner was not logged in the last RateLimitSeconds. The messages skipped meanwhile are counted in the next one.
+	 */
+	template <typename MessageFunctionType>
+	void LogLazy(ENYLoggerLogLevel Level, const void* Owner, uint32 MessageKey, MessageFunctionType&& MakeMessage)
+	{
+#if !NO_LOGGING
+		int32 NumSkipped = 0;
+		if (!IsAnyOutputEnabled() || !ShouldLogRateLimited(Owner, MessageKey, NumSkipped))
+		{
+			return;
+		}
+
+		FString Message = MakeMessage();
+		if (NumSkipped > 0)
+		{
+			Message += FString::Printf(TEXT("\n(Repeated %d more times since the last time it was logged)"), NumSkipped);
+		}
+		Log(Level, Message);
+#endif // !NO_LOGGING
+	}
+
+	// Same as above, the MessageKey is the call site: each lambda has its own type
+	template <typename MessageFunctionType>
+	void LogLazy(ENYLoggerLogLevel Level, const void* Owner, MessageFunctionType&& MakeMessage)
+	{
+		LogLazy(Level, Owner, GetCallSiteKey<typename TDecay<MessageFunctionType>::Type>(), Forward<MessageFunctionType>(MakeMessage));
+	}
+
+	template <typename MessageFunctionType>
+	void ErrorLazy(const void* Owner, MessageFunctionType&& MakeMessage) { LogLazy(ENYLoggerLogLevel::Error, Owner, Forward<MessageFunctionType>(MakeMessage)); }
+
+	template <typename MessageFunctionType>
+	void WarningLazy(const void* Owner, MessageFunctionType&& MakeMessage) { LogLazy(ENYLoggerLogLevel::Warning, Owner, Forward<MessageFunctionType>(MakeMessage)); }
+
 protected:
 	void VARARGS LogfImplementation(ENYLoggerLogLevel Level, const TCHAR* Fmt, ...);
 
+	// One static per instantiation, its address identifies the call site
+	template <typename CallSiteType>
+	static uint32 GetCallSiteKey()
+	{
+		static const uint8 CallSite = 0;
+		return PointerHash(&CallSite);
+	}
+
+	// Thread safe, the conditions can be evaluated from worker threads by the simulation commandlet
+	bool ShouldLogRateLimited(const void* Owner, uint32 MessageKey, int32& OutNumSkipped);
+
 #if WITH_UNREAL_DEVELOPER_TOOLS
 	static FMessageLogModule* GetMessageLogModule();
 #endif // WITH_UNREAL_DEVELOPER_TOOLS
@@ -481,6 +566,25 @@ protected:
 	// Required to print to client console
 	APlayerController* PlayerController = nullptr;
 
+	//
+	// Rate limiting
+	//
+
+	struct FNYRateLimitedMessage
+	{
+		double LastLogSeconds = 0.0;
+		int32 NumSkipped = 0;
+	};
+
+	// Key: owner and message key
+	TMap<TPair<const void*, uint32>, FNYRateLimitedMessage> RateLimitedMessages;
+
+	// See SetRateLimitSeconds
+	float RateLimitSeconds = 0.f;
+
+	// See UseAsyncOutputLog
+	bool bAsyncOutputLog = false;
+
 	//
 	// Colors
 	//
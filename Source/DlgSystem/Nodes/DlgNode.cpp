@@ -9,6 +9,7 @@
 #include "DlgSystem/Logging/DlgLogger.h"
 #include "DlgSystem/DlgLocalizationHelper.h"
 #include "DlgSystem/DlgHelper.h"
+#include "DlgSystem/DlgCookStripping.h"
 
 #if WITH_EDITOR
 #include "Misc/DataValidation.h"
@@ -19,7 +20,10 @@
 // Begin UObject interface
 void UDlgNode::Serialize(FArchive& Ar)
 {
-	Super::Serialize(Ar);
+	{
+		FDlgCookStripScope StripScope(*this, Ar);
+		Super::Serialize(Ar);
+	}
 #if NY_ENGINE_VERSION >= 500
 	const auto CurrentVersion = Ar.UEVer();
 #else
@@ -207,6 +211,12 @@ EDataValidationResult UDlgNode::IsDataValid(FDataValidationContext& Context) con
 
 bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated)
 {
+	// Spread over the next frames, only the options of the entered node and not the ones gathered through virtual parents
+	if (AlreadyEvaluated.Num() == 0 && Context.ShouldTimeSliceOptionsEvaluation())
+	{
+		return Context.StartTimeSlicedOptionsEvaluation(*this);
+	}
+
 	TArray<FDlgEdge>& AvailableOptions = Context.GetMutableOptionsArray();
 	TArray<FDlgEdgeData>& AllOptions = Context.GetAllMutableOptionsArray();
 	AvailableOptions.Empty();
@@ -229,22 +239,29 @@ bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> Al
 	// no child, but no end node?
 	if (AvailableOptions.Num() == 0)
 	{
-		switch (GetDefault<UDlgSystemSettings>()->NoSatisfiedChildBehavior)
-		{
-			case EDlgNoSatisfiedChildBehavior::PrintErrorAndEndDialogue:
-				FDlgLogger::Get().Errorf(
-					TEXT("ReevaluateChildren (ReevaluateOptions) - no valid child option for a NODE.\nContext:\n\t%s"),
-					*Context.GetContextString());
+		return HandleNoSatisfiedChild(Context);
+	}
 
-			case EDlgNoSatisfiedChildBehavior::EndDialogue:
-				return false;
+	return true;
+}
 
-			case EDlgNoSatisfiedChildBehavior::ContinueDialogue:
-				return true;
+bool UDlgNode::HandleNoSatisfiedChild(const UDlgContext& Context) const
+{
+	switch (GetDefault<UDlgSystemSettings>()->NoSatisfiedChildBehavior)
+	{
+		case EDlgNoSatisfiedChildBehavior::PrintErrorAndEndDialogue:
+			FDlgLogger::Get().Errorf(
+				TEXT("ReevaluateChildren (ReevaluateOptions) - no valid child option for a NODE.\nContext:\n\t%s"),
+				*Context.GetContextString());
 
-			default:
-				check(false);
-		}
+		case EDlgNoSatisfiedChildBehavior::EndDialogue:
+			return false;
+
+		case EDlgNoSatisfiedChildBehavior::ContinueDialogue:
+			return true;
+
+		default:
+			check(false);
 	}
 
 	return true;
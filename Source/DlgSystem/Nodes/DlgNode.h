@@ -23,6 +23,7 @@ class USoundBase;
 class USoundWave;
 class UDialogueWave;
 struct FDlgTextArgument;
+struct FSoftObjectPath;
 class UDlgDialogue;
 
 
@@ -102,6 +103,9 @@ public:
 	virtual bool HandleNodeEnter(UDlgContext& Context, bool bFireThisNodeEnterEvents, TSet<const UDlgNode*> NodesEnteredWithThisStep);
 	virtual bool ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated);
 
+	// What ReevaluateChildren returns if no option is satisfied, see UDlgSystemSettings::NoSatisfiedChildBehavior
+	bool HandleNoSatisfiedChild(const UDlgContext& Context) const;
+
 	virtual bool CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
 	bool HasAnySatisfiedChild(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
 
@@ -281,6 +285,9 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual UDlgNodeData* GetNodeData() const { return nullptr; }
 
+	// Adds the soft referenced assets of this node (see FDlgNodeSoftAssets), only non empty in the dialogues cooked with soft references
+	virtual void GetNodeSoftAssetPaths(TArray<FSoftObjectPath>& OutPaths) const {}
+
 	// Helper method to get directly the Dialogue (which is our parent)
 	UDlgDialogue* GetDialogue() const;
 
@@ -0,0 +1,73 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgNodeSoftAssets.h"
+
+#include "Misc/ScopeExit.h"
+#include "Serialization/ObjectWriter.h"
+#include "Sound/DialogueWave.h"
+#include "Sound/SoundBase.h"
+
+#include "DlgSystem/DlgSystemSettings.h"
+
+// Set by WriteAsCooked to swap outside of a cook
+static bool bForceCookAsSoft = false;
+
+void FDlgNodeSoftAssets::GetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (!VoiceSoundWave.IsNull())
+	{
+		OutPaths.Add(VoiceSoundWave.ToSoftObjectPath());
+	}
+	if (!VoiceDialogueWave.IsNull())
+	{
+		OutPaths.Add(VoiceDialogueWave.ToSoftObjectPath());
+	}
+	if (!GenericData.IsNull())
+	{
+		OutPaths.Add(GenericData.ToSoftObjectPath());
+	}
+}
+
+bool FDlgNodeSoftAssets::ShouldCookAsSoft(const FArchive& Ar)
+{
+#if WITH_EDITOR
+	return Ar.IsSaving() && (bForceCookAsSoft || (Ar.IsCooking() && GetDefault<UDlgSystemSettings>()->bCookNodeAssetsAsSoftReferences));
+#else
+	return false;
+#endif
+}
+
+#if WITH_EDITOR
+void FDlgNodeSoftAssets::WriteAsCooked(UObject& Object, TArray<uint8>& OutBytes)
+{
+	check(IsInGameThread());
+
+	OutBytes.Reset();
+	bForceCookAsSoft = true;
+	ON_SCOPE_EXIT
+	{
+		bForceCookAsSoft = false;
+	};
+	FObjectWriter Writer(&Object, OutBytes);
+}
+#endif
+
+void FDlgNodeSoftAssets::MoveFrom(USoundBase*& InOutVoiceSoundWave, UDialogueWave*& InOutVoiceDialogueWave, UObject*& InOutGenericData)
+{
+	VoiceSoundWave = InOutVoiceSoundWave;
+	VoiceDialogueWave = InOutVoiceDialogueWave;
+	GenericData = InOutGenericData;
+	InOutVoiceSoundWave = nullptr;
+	InOutVoiceDialogueWave = nullptr;
+	InOutGenericData = nullptr;
+}
+
+void FDlgNodeSoftAssets::Restore(USoundBase*& OutVoiceSoundWave, UDialogueWave*& OutVoiceDialogueWave, UObject*& OutGenericData)
+{
+	// The editor keeps working with the hard references, the soft ones only exist in the cooked package
+	OutVoiceSoundWave = VoiceSoundWave.Get();
+	OutVoiceDialogueWave = VoiceDialogueWave.Get();
+	OutGenericData = GenericData.Get();
+	VoiceSoundWave.Reset();
+	VoiceDialogueWave.Reset();
+	GenericData.Reset();
+}
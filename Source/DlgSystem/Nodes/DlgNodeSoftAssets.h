@@ -0,0 +1,53 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPtr.h"
+
+#include "DlgNodeSoftAssets.generated.h"
+
+class USoundBase;
+class UDialogueWave;
+
+/**
+ * Soft references to the voice and generic data of a node (or of a speech sequence entry).
+ * Only filled in the cooked dialogues if UDlgSystemSettings::bCookNodeAssetsAsSoftReferences is set, the hard references are cooked as null then.
+ * The UDlgContext loads them asynchronously for the nodes reachable from the active one, the getters load them synchronously if that did not finish yet.
+ */
+USTRUCT()
+struct DLGSYSTEM_API FDlgNodeSoftAssets
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	bool IsEmpty() const { return VoiceSoundWave.IsNull() && VoiceDialogueWave.IsNull() && GenericData.IsNull(); }
+
+	USoundBase* GetVoiceSoundBase() const { return VoiceSoundWave.IsNull() ? nullptr : VoiceSoundWave.LoadSynchronous(); }
+	UDialogueWave* GetVoiceDialogueWave() const { return VoiceDialogueWave.IsNull() ? nullptr : VoiceDialogueWave.LoadSynchronous(); }
+	UObject* GetGenericData() const { return GenericData.IsNull() ? nullptr : GenericData.LoadSynchronous(); }
+
+	// Adds the non null paths, loaded or not
+	void GetPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
+	// Is the Archive writing a cooked dialogue that should only keep soft references
+	static bool ShouldCookAsSoft(const FArchive& Ar);
+
+#if WITH_EDITOR
+	// Writes the Object as if it was cooked with soft references, outside of a cook. Used by the tests, see FDlgCookStripScope::GetStrippedBytes
+	static void WriteAsCooked(UObject& Object, TArray<uint8>& OutBytes);
+#endif
+
+	// Moves the hard references into this, Restore moves them back. Called around the serialization of a cooked dialogue
+	void MoveFrom(USoundBase*& InOutVoiceSoundWave, UDialogueWave*& InOutVoiceDialogueWave, UObject*& InOutGenericData);
+	void Restore(USoundBase*& OutVoiceSoundWave, UDialogueWave*& OutVoiceDialogueWave, UObject*& OutGenericData);
+
+public:
+	UPROPERTY()
+	TSoftObjectPtr<USoundBase> VoiceSoundWave;
+
+	UPROPERTY()
+	TSoftObjectPtr<UDialogueWave> VoiceDialogueWave;
+
+	UPROPERTY()
+	TSoftObjectPtr<UObject> GenericData;
+};
@@ -24,7 +24,15 @@ bool UDlgNode_Proxy::HandleNodeEnter(UDlgContext& Context, bool bFireEnterEvents
 	}
 	NodesEnteredWithThisStep.Add(this);
 
-	return Context.EnterNode(NodeIndex, true, NodesEnteredWithThisStep);
+	// The collapsed proxies only forward, visiting them is all entering them would do
+	for (const int32 SkippedNodeIndex : SkippedNodeIndices)
+	{
+		const UDlgNode* SkippedNode = Context.GetNodeFromIndex(SkippedNodeIndex);
+		check(SkippedNode);
+		Context.SetNodeVisited(SkippedNodeIndex, SkippedNode->GetGUID());
+	}
+
+	return Context.EnterNode(GetJumpNodeIndex(), true, NodesEnteredWithThisStep);
 }
 
 bool UDlgNode_Proxy::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
@@ -34,15 +42,17 @@ bool UDlgNode_Proxy::CheckNodeEnterConditions(const UDlgContext& Context, TSet<c
 		return false;
 	}
 
-	const UDlgNode* Node = Context.GetNodeFromIndex(NodeIndex);
+	const UDlgNode* Node = Context.GetNodeFromIndex(GetJumpNodeIndex());
 	check(Node);
 	return Node->CheckNodeEnterConditions(Context, AlreadyVisitedNodes);
 }
 
 void UDlgNode_Proxy::RemapOldIndicesWithNew(const TMap<int32, int32>& OldToNewIndexMap)
 {
-	if (const int32* NewIndexPtr = OldToNewIndexMap.Find(NodeIndex))
+	// The dialogue collapses the chain again once all the proxies are remapped, see UDlgDialogue::RebuildResolvedNodeIndices
+	const int32* NewIndexPtr = OldToNewIndexMap.Find(NodeIndex);
+	if (NewIndexPtr != nullptr && *NewIndexPtr != NodeIndex)
 	{
-		NodeIndex = *NewIndexPtr;
+		SetTargetNodeIndex(*NewIndexPtr);
 	}
 }
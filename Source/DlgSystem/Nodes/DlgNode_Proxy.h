@@ -46,6 +46,29 @@ public:
 	// return with the index of the target in the UDlgDialogue::Nodes array
 	int32 GetTargetNodeIndex() const { return NodeIndex; }
 
+	// NOTE: the jump falls back to the target, call UDlgDialogue::RebuildResolvedNodeIndices after to collapse the chain again
+	void SetTargetNodeIndex(int32 InNodeIndex)
+	{
+		NodeIndex = InNodeIndex;
+		JumpNodeIndex = INDEX_NONE;
+		SkippedNodeIndices.Empty();
+	}
+
+	// return with the index the runtime jumps to, the target with the proxies that do nothing skipped (see UDlgDialogue::CollapseProxyChains)
+	int32 GetJumpNodeIndex() const { return JumpNodeIndex != INDEX_NONE ? JumpNodeIndex : NodeIndex; }
+
+	// The proxies jumped over, in the order they would have been entered
+	const TArray<int32>& GetSkippedNodeIndices() const { return SkippedNodeIndices; }
+	void SetJumpNodeIndex(int32 InNodeIndex, TArray<int32> InSkippedNodeIndices)
+	{
+		JumpNodeIndex = InNodeIndex;
+		SkippedNodeIndices = MoveTemp(InSkippedNodeIndices);
+		SkippedNodeIndices.Shrink();
+	}
+
+	// Entering this proxy only forwards to the target: no enter conditions, no entry restriction and no enter events
+	bool CanBeSkipped() const { return !HasAnyEnterConditions() && !HasAnyEnterEvents(); }
+
 
 	// Helper functions to get the names of some properties. Used by the DlgSystemEditor module.
 	static FName GetMemberNameNodeIndex() { return GET_MEMBER_NAME_CHECKED(UDlgNode_Proxy, NodeIndex); }
@@ -55,4 +78,12 @@ protected:
 	// Index of the node the Proxy represents (in UDlgDialogue::Nodes)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
 	int32 NodeIndex = 0;
+
+	// Computed by the Dialogue when its nodes change, INDEX_NONE means NodeIndex
+	UPROPERTY(Transient)
+	int32 JumpNodeIndex = INDEX_NONE;
+
+	// Marked as visited when jumping, as if they were entered
+	UPROPERTY(Transient)
+	TArray<int32> SkippedNodeIndices;
 };
@@ -97,71 +97,136 @@ bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, bool bFireThisNode
 int32 UDlgNode_Selector::GetRandomChildNodeIndex(UDlgContext& Context)
 {
 	FDlgNodeSavedData& SavedData = Context.GetNodeSavedData(NodeGUID);
+	UpdateSavedData(Context, SavedData);
 
-	// The list of all valid children (ones with satisfied condition)
-	TArray<int32> Candidates;
+	// All the valid children (ones with satisfied condition), the default bit array allocator is inline so selectors with up to 128 children do not allocate
+	TBitArray<> Candidates(false, Children.Num());
+	int32 NumCandidates = 0;
 
-	// List of possible candidates if we want to avoid repetition based on the booleans
-	TArray<int32> CandidatesLimited;
+	// Number of candidates if we want to avoid repetition based on the booleans
+	int32 NumCandidatesLimited = 0;
 
 	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); ++EdgeIndex)
 	{
 		if (Children[EdgeIndex].Evaluate(Context, { this }))
 		{
-			Candidates.Add(EdgeIndex);
-
-			const FGuid ChildNodeGUID = Context.GetNodeGUIDForIndex(Children[EdgeIndex].TargetIndex);
-			if (!SavedData.GUIDList.Contains(ChildNodeGUID))
+			Candidates[EdgeIndex] = true;
+			NumCandidates++;
+			if (!SavedData.IsEdgePicked(EdgeIndex))
 			{
-				CandidatesLimited.Add(EdgeIndex);
+				NumCandidatesLimited++;
 			}
 		}
 	}
 
 	// No candidates :(
-	if (Candidates.Num() == 0)
+	if (NumCandidates == 0)
 	{
 		return INDEX_NONE;
 	}
 
 	// Option cycle is over or something is wrong with the setup
-	if (CandidatesLimited.Num() == 0)
+	// Only allow to preserve last option if it is needed and we are sure that a valid option can be picked even if it stays there
+	const int32 LastEdgeIndex = SavedData.LastPickedEdgeIndex;
+	bool bTempBlockLast = false;
+	if (NumCandidatesLimited == 0)
 	{
-		// Only allow to preserve last option in list if it is needed and we are sure that
-		// a valid option can be picked even if it stays there
-		const bool bTempBlockLast = bAvoidPickingSameOptionTwiceInARow && Candidates.Num() > 1;
+		SavedData.ClearPickedEdges();
+		NumCandidatesLimited = NumCandidates;
+
+		bTempBlockLast = bAvoidPickingSameOptionTwiceInARow && NumCandidates > 1 && Candidates.IsValidIndex(LastEdgeIndex) && Candidates[LastEdgeIndex];
 		if (bTempBlockLast)
 		{
-			const FGuid TempBlockedEntry = SavedData.GUIDList.Last();
-			SavedData.GUIDList.Empty();
-			SavedData.GUIDList.Add(TempBlockedEntry);
-			const int32 RandomChildNodeIndex = GetRandomChildNodeIndex(Context);
-			SavedData.GUIDList.Remove(TempBlockedEntry);
-			return RandomChildNodeIndex;
+			SavedData.SetEdgePicked(LastEdgeIndex, true);
+			NumCandidatesLimited--;
+		}
+	}
+
+	// Select Random, from the stream of the context so that it can be seeded
+	int32 SelectedIndex = Context.GetRandomStream().RandHelper(NumCandidatesLimited);
+	int32 SelectedEdgeIndex = INDEX_NONE;
+	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); ++EdgeIndex)
+	{
+		if (Candidates[EdgeIndex] && !SavedData.IsEdgePicked(EdgeIndex) && SelectedIndex-- == 0)
+		{
+			SelectedEdgeIndex = EdgeIndex;
+			break;
+		}
+	}
+	check(SelectedEdgeIndex != INDEX_NONE);
+
+	// The random stream was still used above so that it stays in sync with the recording
+	int32 ReplayedEdgeIndex = INDEX_NONE;
+	if (Context.GetMutableRecorder().ReplaySelection(ReplayedEdgeIndex))
+	{
+		if (Candidates.IsValidIndex(ReplayedEdgeIndex) && Candidates[ReplayedEdgeIndex] && !SavedData.IsEdgePicked(ReplayedEdgeIndex))
+		{
+			SelectedEdgeIndex = ReplayedEdgeIndex;
 		}
 		else
 		{
-			SavedData.GUIDList.Empty();
-			return GetRandomChildNodeIndex(Context);
+			FDlgLogger::Get().Warningf(
+				TEXT("SelectorNode::GetRandomChildNodeIndex - the replayed edge %d is not a candidate anymore, keeping the random one.\nContext:\n\t%s"),
+				ReplayedEdgeIndex, *Context.GetContextString()
+			);
 		}
 	}
+	Context.GetMutableRecorder().RecordSelection(SelectedEdgeIndex);
 
-	// Select Random
-	const int32 SelectedIndex = FMath::RandHelper(CandidatesLimited.Num());
-	const int32 TargetNodeIndex = Children[CandidatesLimited[SelectedIndex]].TargetIndex;
-	const FGuid TargetNodeGUID = Context.GetNodeGUIDForIndex(TargetNodeIndex);
+	if (bTempBlockLast)
+	{
+		SavedData.SetEdgePicked(LastEdgeIndex, false);
+	}
 
-	// if we cycle through everything the list of picked nodes is needed
+	// if we cycle through everything the picked edges are needed
 	if (bCycleThroughSatisfiedOptionsWithoutRepetition)
 	{
-		// add the currently picked node to the disallow list, it will be cleared on selection if all valid options are added
-		SavedData.GUIDList.Add(TargetNodeGUID);
+		// add the currently picked edge to the disallow mask, it will be cleared on selection if all valid options are picked
+		SavedData.SetEdgePicked(SelectedEdgeIndex, true);
 	}
 	else if (bAvoidPickingSameOptionTwiceInARow)
 	{
-		// only disallow the currently picked node for the next selection
-		SavedData.GUIDList = { TargetNodeGUID };
+		// only disallow the currently picked edge for the next selection
+		SavedData.ClearPickedEdges();
+		SavedData.SetEdgePicked(SelectedEdgeIndex, true);
 	}
+	SavedData.LastPickedEdgeIndex = SelectedEdgeIndex;
 
-	return TargetNodeIndex;
+	return Children[SelectedEdgeIndex].TargetIndex;
+}
+
+void UDlgNode_Selector::UpdateSavedData(const UDlgContext& Context, FDlgNodeSavedData& SavedData) const
+{
+	// The bits are per edge, they mean something else once the children changed
+	uint32 EdgesHash = 0;
+	for (const FDlgEdge& Edge : Children)
+	{
+		EdgesHash = HashCombine(EdgesHash, GetTypeHash(Context.GetNodeGUIDForIndex(Edge.TargetIndex)));
+	}
+	if (SavedData.NumEdges != Children.Num() || SavedData.EdgesHash != EdgesHash)
+	{
+		SavedData.NumEdges = Children.Num();
+		SavedData.EdgesHash = EdgesHash;
+		SavedData.PickedEdgesMask.SetNumZeroed(FMath::DivideAndRoundUp(Children.Num(), 32));
+		SavedData.ClearPickedEdges();
+		SavedData.LastPickedEdgeIndex = INDEX_NONE;
+	}
+
+	// Saves made before the edge mask store the GUIDs of the picked nodes
+	if (SavedData.GUIDList.Num() > 0)
+	{
+		for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); ++EdgeIndex)
+		{
+			const FGuid ChildNodeGUID = Context.GetNodeGUIDForIndex(Children[EdgeIndex].TargetIndex);
+			if (SavedData.GUIDList.Contains(ChildNodeGUID))
+			{
+				SavedData.SetEdgePicked(EdgeIndex, true);
+			}
+			if (ChildNodeGUID == SavedData.GUIDList.Last())
+			{
+				SavedData.LastPickedEdgeIndex = EdgeIndex;
+			}
+		}
+		SavedData.GUIDList.Empty();
+	}
 }
@@ -17,6 +17,8 @@ enum class EDlgNodeSelectorType : uint8
 	Random		UMETA(DisplayName = "Random"),
 };
 
+struct FDlgNodeSavedData;
+
 /**
  * Node without text. Selector of child depends on the type.
  * It should have at least one (satisfied child), HandleNodeEnter returns false and the Dialogue is terminated otherwise.
@@ -66,6 +68,9 @@ public:
 	// Sets the Selector Type
 	void SetSelectorType(EDlgNodeSelectorType InType) { SelectorType = InType; }
 
+	void SetAvoidPickingSameOptionTwiceInARow(bool bValue) { bAvoidPickingSameOptionTwiceInARow = bValue; }
+	void SetCycleThroughSatisfiedOptionsWithoutRepetition(bool bValue) { bCycleThroughSatisfiedOptionsWithoutRepetition = bValue; }
+
 	// Helper functions to get the names of some properties. Used by the DlgSystemEditor module.
 	static FName GetMemberNameSelectorType() { return GET_MEMBER_NAME_CHECKED(UDlgNode_Selector, SelectorType); }
 	static FName GetMemberNameAvoidPickingSameOptionTwiceInARow() { return GET_MEMBER_NAME_CHECKED(UDlgNode_Selector, bAvoidPickingSameOptionTwiceInARow); }
@@ -75,6 +80,9 @@ protected:
 
 	int32 GetRandomChildNodeIndex(UDlgContext& Context);
 
+	// Converts the GUIDList of old saves into the edge mask, resets the mask if the children changed (number, order or targets)
+	void UpdateSavedData(const UDlgContext& Context, FDlgNodeSavedData& SavedData) const;
+
 protected:
 	// Defines the type of selector this node represents
 	UPROPERTY(EditAnywhere, Category = "Dialogue|Node")
@@ -83,12 +91,14 @@ protected:
 	// Modifies the way EDlgNodeSelectorType::Random works.
 	// Ensures that an option is not picked twice before any other option is,
 	// unless it is not possible because of the node setup/conditions
+	// NOTE: the options are the child edges, two edges to the same node count as two options (before they were counted as one)
 	UPROPERTY(EditAnywhere, meta = (EditCondition = "SelectorType == EDlgNodeSelectorType::Random", EditConditionHides), Category = "Dialogue|Node")
 	bool bAvoidPickingSameOptionTwiceInARow = false;
 
 	// Only after each satisfied option is picked once can an option be picked again
 	// Still allows repetition if bAvoidPickingSameOptionTwiceInARow is not set to true,
 	// e.g. for options {A, B, C} A-B-C-C-A-B-B... is a valid series of choices
+	// The picked options are remembered per child edge in FDlgNodeSavedData::PickedEdgesMask
 	UPROPERTY(EditAnywhere, meta = (EditCondition = "SelectorType == EDlgNodeSelectorType::Random", EditConditionHides), Category = "Dialogue|Node")
 	bool bCycleThroughSatisfiedOptionsWithoutRepetition = false;
 
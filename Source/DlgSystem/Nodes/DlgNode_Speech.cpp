@@ -12,6 +12,22 @@
 #endif // WITH_EDITOR
 
 
+void UDlgNode_Speech::Serialize(FArchive& Ar)
+{
+	const bool bCookAsSoft = FDlgNodeSoftAssets::ShouldCookAsSoft(Ar);
+	if (bCookAsSoft)
+	{
+		SoftAssets.MoveFrom(VoiceSoundWave, VoiceDialogueWave, GenericData);
+	}
+
+	Super::Serialize(Ar);
+
+	if (bCookAsSoft)
+	{
+		SoftAssets.Restore(VoiceSoundWave, VoiceDialogueWave, GenericData);
+	}
+}
+
 void UDlgNode_Speech::OnCreatedInEditor()
 {
 	const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
@@ -59,6 +75,9 @@ void UDlgNode_Speech::RebuildConstructedText(const UDlgContext& Context)
 		return;
 	}
 
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgText_Construct);
+	Context.GetMutableMetrics().OnTextFormatted();
+
 	FFormatNamedArguments OrderedArguments;
 	for (const FDlgTextArgument& DlgArgument : TextArguments)
 	{
@@ -3,6 +3,7 @@
 
 #include "DlgSystem/Nodes/DlgNode.h"
 #include "DlgSystem/DlgTextArgument.h"
+#include "DlgSystem/Nodes/DlgNodeSoftAssets.h"
 
 #include "DlgNode_Speech.generated.h"
 
@@ -23,6 +24,7 @@ public:
 	virtual void OnCreatedInEditor() override;
 
 	// Begin UObject Interface.
+	void Serialize(FArchive& Ar) override;
 	FString GetDesc() override
 	{
 		if (bIsVirtualParent)
@@ -75,9 +77,10 @@ public:
 
 	// stuff we have to keep for legacy reason (but would make more sense to remove them from the plugin as they could be created in NodeData):
 	FName GetSpeakerState() const override { return SpeakerState; }
-	USoundBase* GetNodeVoiceSoundBase() const override { return VoiceSoundWave; }
-	UDialogueWave* GetNodeVoiceDialogueWave() const override { return VoiceDialogueWave; }
-	UObject* GetNodeGenericData() const override { return GenericData; }
+	USoundBase* GetNodeVoiceSoundBase() const override { return VoiceSoundWave != nullptr ? VoiceSoundWave : SoftAssets.GetVoiceSoundBase(); }
+	UDialogueWave* GetNodeVoiceDialogueWave() const override { return VoiceDialogueWave != nullptr ? VoiceDialogueWave : SoftAssets.GetVoiceDialogueWave(); }
+	UObject* GetNodeGenericData() const override { return GenericData != nullptr ? GenericData : SoftAssets.GetGenericData(); }
+	void GetNodeSoftAssetPaths(TArray<FSoftObjectPath>& OutPaths) const override { SoftAssets.GetPaths(OutPaths); }
 
 	void AddAllSpeakerStatesIntoSet(TSet<FName>& OutStates) const override { OutStates.Add(SpeakerState); }
 
@@ -172,6 +175,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Dialogue|Node", Meta = (DlgSaveOnlyReference))
 	UObject* GenericData = nullptr;
 
+	// The voices and generic data as soft references, only set in the cooked dialogues, see UDlgSystemSettings::bCookNodeAssetsAsSoftReferences
+	UPROPERTY(Meta = (DlgNoExport))
+	FDlgNodeSoftAssets SoftAssets;
+
 	// Constructed at runtime from the original text and the arguments if there is any.
 	FText ConstructedText;
 
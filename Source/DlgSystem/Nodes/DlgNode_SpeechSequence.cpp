@@ -10,6 +10,28 @@
 #endif // WITH_EDITOR
 
 
+void UDlgNode_SpeechSequence::Serialize(FArchive& Ar)
+{
+	const bool bCookAsSoft = FDlgNodeSoftAssets::ShouldCookAsSoft(Ar);
+	if (bCookAsSoft)
+	{
+		for (FDlgSpeechSequenceEntry& Entry : SpeechSequence)
+		{
+			Entry.SoftAssets.MoveFrom(Entry.VoiceSoundWave, Entry.VoiceDialogueWave, Entry.GenericData);
+		}
+	}
+
+	Super::Serialize(Ar);
+
+	if (bCookAsSoft)
+	{
+		for (FDlgSpeechSequenceEntry& Entry : SpeechSequence)
+		{
+			Entry.SoftAssets.Restore(Entry.VoiceSoundWave, Entry.VoiceDialogueWave, Entry.GenericData);
+		}
+	}
+}
+
 #if WITH_EDITOR
 void UDlgNode_SpeechSequence::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
@@ -194,7 +216,8 @@ USoundBase* UDlgNode_SpeechSequence::GetNodeVoiceSoundBase() const
 {
 	if (SpeechSequence.IsValidIndex(ActualIndex))
 	{
-		return SpeechSequence[ActualIndex].VoiceSoundWave;
+		const FDlgSpeechSequenceEntry& Entry = SpeechSequence[ActualIndex];
+		return Entry.VoiceSoundWave != nullptr ? Entry.VoiceSoundWave : Entry.SoftAssets.GetVoiceSoundBase();
 	}
 
 	return nullptr;
@@ -204,7 +227,8 @@ UDialogueWave* UDlgNode_SpeechSequence::GetNodeVoiceDialogueWave() const
 {
 	if (SpeechSequence.IsValidIndex(ActualIndex))
 	{
-		return SpeechSequence[ActualIndex].VoiceDialogueWave;
+		const FDlgSpeechSequenceEntry& Entry = SpeechSequence[ActualIndex];
+		return Entry.VoiceDialogueWave != nullptr ? Entry.VoiceDialogueWave : Entry.SoftAssets.GetVoiceDialogueWave();
 	}
 
 	return nullptr;
@@ -214,12 +238,22 @@ UObject* UDlgNode_SpeechSequence::GetNodeGenericData() const
 {
 	if (SpeechSequence.IsValidIndex(ActualIndex))
 	{
-		return SpeechSequence[ActualIndex].GenericData;
+		const FDlgSpeechSequenceEntry& Entry = SpeechSequence[ActualIndex];
+		return Entry.GenericData != nullptr ? Entry.GenericData : Entry.SoftAssets.GetGenericData();
 	}
 
 	return nullptr;
 }
 
+void UDlgNode_SpeechSequence::GetNodeSoftAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	// The whole sequence, it stays the active node while it plays
+	for (const FDlgSpeechSequenceEntry& Entry : SpeechSequence)
+	{
+		Entry.SoftAssets.GetPaths(OutPaths);
+	}
+}
+
 FName UDlgNode_SpeechSequence::GetSpeakerState() const
 {
 	if (SpeechSequence.IsValidIndex(ActualIndex))
@@ -319,6 +353,9 @@ void FDlgSpeechSequenceEntry::RebuildConstructedText(const UDlgContext& Context,
 		return;
 	}
 
+	DLG_SCOPE_CYCLE_COUNTER(STAT_DlgText_Construct);
+	Context.GetMutableMetrics().OnTextFormatted();
+
 	FFormatNamedArguments OrderedArguments;
 	for (const FDlgTextArgument& DlgArgument : TextArguments)
 	{
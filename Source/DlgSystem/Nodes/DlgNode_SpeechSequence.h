@@ -3,6 +3,7 @@
 
 #include "DlgSystem/Nodes/DlgNode.h"
 #include "DlgSystem/DlgSystemSettings.h"
+#include "DlgSystem/Nodes/DlgNodeSoftAssets.h"
 #include "GameplayTagContainer.h"
 
 #include "DlgNode_SpeechSequence.generated.h"
@@ -72,6 +73,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Node", Meta = (DlgSaveOnlyReference))
 	UObject* GenericData = nullptr;
 
+	// The voices and generic data as soft references, only set in the cooked dialogues, see UDlgSystemSettings::bCookNodeAssetsAsSoftReferences
+	UPROPERTY(Meta = (DlgNoExport))
+	FDlgNodeSoftAssets SoftAssets;
+
 protected:
 	// Text that will appear when this node participant name speaks to someone else.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Node", Meta = (MultiLine = true))
@@ -97,6 +102,7 @@ class DLGSYSTEM_API UDlgNode_SpeechSequence : public UDlgNode
 
 public:
 	// Begin UObject Interface.
+	void Serialize(FArchive& Ar) override;
 	/** @return a one line description of an object. */
 	FString GetDesc() override
 	{
@@ -125,6 +131,7 @@ public:
 	FName GetSpeakerState() const override;
 	void AddAllSpeakerStatesIntoSet(TSet<FName>& OutStates) const override;
 	UObject* GetNodeGenericData() const override;
+	void GetNodeSoftAssetPaths(TArray<FSoftObjectPath>& OutPaths) const override;
 	FGameplayTag GetNodeParticipantTag() const override;
 	void GetAssociatedParticipants(TArray<FGameplayTag>& OutArray) const override;
 
@@ -0,0 +1,285 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "DlgRuntimeBenchmarkTypes.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgContextTrace.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgMemory.h"
+#include "DlgSystem/Nodes/DlgNode_End.h"
+#include "DlgSystem/Nodes/DlgNode_Proxy.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextReplayTest,
+	"DlgSystem.Runtime.Context.Replay",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgContextReplayTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 MaxSteps = 100;
+
+	FDlgSyntheticDialogueOptions Options;
+	Options.ConditionDensity = 0.5f;
+	Options.SelectorChance = 0.35f;
+	Options.ProxyChance = 0.25f;
+	const FDlgTestDialogueScope Scope(Options);
+	UDlgDialogue* Dialogue = Scope.GetDialogue();
+
+	// Record
+	FRandomStream Random(Options.Seed);
+	UDlgContext* RecordedContext = Scope.NewContext();
+	RecordedContext->SetRandomSeed(Options.Seed);
+	RecordedContext->StartRecording();
+	bool bRecordedActive = RecordedContext->Start(Dialogue, Scope.CreateParticipants(&Random));
+	for (int32 Step = 0; bRecordedActive && Step < MaxSteps && RecordedContext->GetOptionsNum() > 0; Step++)
+	{
+		bRecordedActive = RecordedContext->ChooseOption(Random.RandHelper(RecordedContext->GetOptionsNum()));
+	}
+	RecordedContext->StopRecording();
+
+	FDlgContextTrace Trace;
+	TestTrue(TEXT("Trace bytes round trip"), Trace.FromBytes(RecordedContext->GetRecordedTrace().ToBytes()));
+	TestTrue(TEXT("Trace is not empty"), !Trace.IsEmpty());
+
+	// Replay with participants that answer differently, the recorded condition results are used instead
+	Scope.ResetMemory();
+	FRandomStream OtherRandom(Options.Seed + 1);
+	UDlgContext* ReplayedContext = Scope.NewContext();
+	ReplayedContext->StartReplay(Trace);
+	bool bReplayedActive = ReplayedContext->Start(Dialogue, Scope.CreateParticipants(&OtherRandom));
+	if (bReplayedActive)
+	{
+		bReplayedActive = ReplayedContext->ReplayChoices();
+	}
+
+	TestEqual(TEXT("Replay ended the same"), bReplayedActive, bRecordedActive);
+	TestEqual(TEXT("Replay active node"), ReplayedContext->GetActiveNodeIndex(), RecordedContext->GetActiveNodeIndex());
+	TestTrue(
+		TEXT("Replay visited the same nodes"),
+		ReplayedContext->GetHistoryOfThisContext().VisitedNodeIndices.Difference(RecordedContext->GetHistoryOfThisContext().VisitedNodeIndices).Num() == 0
+		&& RecordedContext->GetHistoryOfThisContext().VisitedNodeIndices.Num() == ReplayedContext->GetHistoryOfThisContext().VisitedNodeIndices.Num()
+	);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextTraceBytesTest,
+	"DlgSystem.Runtime.Context.TraceBytes",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgContextTraceBytesTest::RunTest(const FString& Parameters)
+{
+	FDlgContextTrace Trace;
+	Trace.Seed = 42;
+	Trace.Choices = { FDlgContextTrace::EncodeChoice(2, false), FDlgContextTrace::EncodeChoice(300, true) };
+	Trace.Selections = { 1, 0, 7 };
+	for (int32 Index = 0; Index < 11; Index++)
+	{
+		Trace.ConditionResults.Add(Index % 3 == 0);
+	}
+
+	FDlgContextTrace Loaded;
+	TestTrue(TEXT("Round trip"), Loaded.FromBytes(Trace.ToBytes()));
+	TestEqual(TEXT("Seed"), Loaded.Seed, Trace.Seed);
+	TestTrue(TEXT("Choices"), Loaded.Choices == Trace.Choices);
+	TestTrue(TEXT("Selections"), Loaded.Selections == Trace.Selections);
+	TestTrue(TEXT("Condition results"), Loaded.ConditionResults == Trace.ConditionResults);
+
+	// A count larger than the rest of the bytes is rejected before allocating
+	TArray<uint8> Corrupt;
+	{
+		FMemoryWriter Writer(Corrupt);
+		uint8 Version = FDlgContextTrace::FormatVersion;
+		int32 Seed = 0;
+		uint32 NumChoices = MAX_int32;
+		Writer << Version << Seed;
+		Writer.SerializeIntPacked(NumChoices);
+	}
+	TestFalse(TEXT("Corrupt count is rejected"), Loaded.FromBytes(Corrupt));
+	TestTrue(TEXT("Rejected trace is empty"), Loaded.IsEmpty());
+
+	TArray<uint8> Truncated = Trace.ToBytes();
+	Truncated.SetNum(Truncated.Num() - 2);
+	TestFalse(TEXT("Truncated trace is rejected"), Loaded.FromBytes(Truncated));
+
+	// Invalid choices are not recorded
+	const FDlgTestDialogueScope Scope(FDlgSyntheticDialogueOptions{});
+	UDlgContext* Context = Scope.NewContext();
+	Context->StartRecording();
+	const bool bStarted = Context->Start(Scope.GetDialogue(), Scope.CreateParticipants());
+	TestTrue(TEXT("Started"), bStarted);
+	if (bStarted)
+	{
+		AddExpectedError(TEXT("ChooseOption - INVALID given OptionIndex"), EAutomationExpectedErrorFlags::Contains, 1);
+		TestFalse(TEXT("Invalid option ends the dialogue"), Context->ChooseOption(Context->GetOptionsNum()));
+		TestEqual(TEXT("Invalid option is not recorded"), Context->GetRecordedTrace().Choices.Num(), 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextTimeSlicedOptionsTest,
+	"DlgSystem.Runtime.Context.TimeSlicedOptions",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgContextTimeSlicedOptionsTest::RunTest(const FString& Parameters)
+{
+	FDlgSyntheticDialogueOptions Options;
+	Options.FanOut = 12;
+	Options.ConditionDensity = 1.f;
+	const FDlgTestDialogueScope Scope(Options);
+
+	// Active node, options and all options after the start and after choosing the first option, each run with fresh participants and memory
+	const auto Run = [&Scope](bool bTimeSlice) -> TArray<int32>
+	{
+		Scope.ResetMemory();
+		UDlgContext* Context = Scope.NewContext(bTimeSlice);
+
+		TArray<int32> Result;
+		const bool bStarted = Context->Start(Scope.GetDialogue(), Scope.CreateParticipants());
+		Context->FinishOptionsEvaluationNow();
+		Result.Append({ bStarted, Context->GetActiveNodeIndex(), Context->GetOptionsNum(), Context->GetAllOptionsNum() });
+
+		// Choosing while evaluating finishes the evaluation first
+		if (Context->GetOptionsNum() > 0)
+		{
+			const bool bActive = Context->ChooseOption(0);
+			Context->FinishOptionsEvaluationNow();
+			Result.Append({ bActive, Context->GetActiveNodeIndex(), Context->GetOptionsNum(), Context->GetAllOptionsNum() });
+		}
+
+		Result.Add(Context->IsEvaluatingOptions());
+		return Result;
+	};
+
+	const TArray<int32> SyncResult = Run(false);
+	const TArray<int32> SlicedResult = Run(true);
+
+	TestTrue(TEXT("Time sliced evaluation gives the same options"), SyncResult == SlicedResult);
+	TestTrue(TEXT("Started"), SyncResult.Num() > 0 && SyncResult[0] != 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextProxyChainsTest,
+	"DlgSystem.Runtime.Context.ProxyChains",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgContextProxyChainsTest::RunTest(const FString& Parameters)
+{
+	// 0 Speech -> 1 Proxy -> 2 Proxy -> 3 Proxy with an enter event -> 4 Speech -> 5 Proxy -> 6 Proxy -> 5 (loop)
+	FDlgTestDialogueBuilder Builder;
+	Builder.AddNode(UDlgNode_Speech::StaticClass(), {1});
+	Builder.AddNode(UDlgNode_Proxy::StaticClass(), {2});
+	Builder.AddNode(UDlgNode_Proxy::StaticClass(), {3});
+	const int32 EventProxyIndex = Builder.AddNode(UDlgNode_Proxy::StaticClass(), {4});
+	Builder.AddNode(UDlgNode_Speech::StaticClass(), {5});
+	Builder.AddNode(UDlgNode_Proxy::StaticClass(), {6});
+	Builder.AddNode(UDlgNode_Proxy::StaticClass(), {5});
+	Builder.AddNode(UDlgNode_End::StaticClass());
+	{
+		FDlgEvent Event;
+		Event.ParticipantTag = Builder.GetParticipantTag();
+		Event.EventType = EDlgEventType::ModifyInt;
+		Event.EventName = TEXT("IntValue");
+		Event.IntValue = 1;
+		Event.bDelta = true;
+		Builder.GetNode(EventProxyIndex)->SetNodeEnterEvents({Event});
+	}
+	UDlgDialogue* Dialogue = Builder.Finish();
+
+	// Chain collapsing
+	const auto GetProxy = [Dialogue](int32 NodeIndex) { return CastChecked<UDlgNode_Proxy>(Dialogue->GetNodes()[NodeIndex]); };
+	TestEqual(TEXT("Forwarding proxy is skipped"), GetProxy(1)->GetJumpNodeIndex(), EventProxyIndex);
+	TestTrue(TEXT("Skipped proxies of the chain"), GetProxy(1)->GetSkippedNodeIndices() == TArray<int32>{2});
+	TestEqual(TEXT("Proxy with enter events is kept"), GetProxy(2)->GetJumpNodeIndex(), EventProxyIndex);
+	TestEqual(TEXT("Proxy to a speech node"), GetProxy(EventProxyIndex)->GetJumpNodeIndex(), 4);
+
+	// Proxy loops keep their target
+	TestEqual(TEXT("Looping chain keeps its target"), GetProxy(5)->GetJumpNodeIndex(), 6);
+	TestEqual(TEXT("Looping chain keeps its other target"), GetProxy(6)->GetJumpNodeIndex(), 5);
+	TestEqual(TEXT("Looping chain skips nothing"), GetProxy(5)->GetSkippedNodeIndices().Num(), 0);
+
+	// Visit bookkeeping, the skipped proxies are visited as if they were entered
+	const FDlgTestDialogueScope Scope(Dialogue);
+	UDlgContext* Context = Scope.NewContext();
+	TestTrue(TEXT("Started"), Context->Start(Dialogue, Scope.CreateParticipants()));
+	TestTrue(TEXT("Went through the proxies"), Context->ChooseOption(0));
+	TestEqual(TEXT("Stopped after the proxies"), Context->GetActiveNodeIndex(), 4);
+	for (int32 NodeIndex = 0; NodeIndex <= 4; NodeIndex++)
+	{
+		TestTrue(FString::Printf(TEXT("Node %d is in the context history"), NodeIndex), Context->WasNodeIndexVisitedInThisContext(NodeIndex));
+		TestTrue(
+			FString::Printf(TEXT("Node %d is in the memory"), NodeIndex),
+			FDlgMemory::Get().IsNodeVisited(Dialogue->GetGUID(), NodeIndex, Dialogue->GetNodes()[NodeIndex]->GetGUID())
+		);
+	}
+
+	// The loop is still reported
+	AddExpectedError(TEXT("entered multiple times in a single step"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Looping proxies terminate the dialogue"), Context->ChooseOption(0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextReachableNodesTest,
+	"DlgSystem.Runtime.Context.ReachableNodes",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgContextReachableNodesTest::RunTest(const FString& Parameters)
+{
+	// 0 Speech -> 1 Proxy -> 3 Speech -> 4 Selector -> 5 Speech -> 6 Speech -> 7 End
+	// 0 and 3 also go to 2 Speech -> 6 through an edge that is never satisfied
+	FDlgTestDialogueBuilder Builder;
+	Builder.AddNode(UDlgNode_Speech::StaticClass(), {1, 2});
+	Builder.AddNode(UDlgNode_Proxy::StaticClass(), {3});
+	Builder.AddNode(UDlgNode_Speech::StaticClass(), {6});
+	Builder.AddNode(UDlgNode_Speech::StaticClass(), {4, 2});
+	Builder.AddNode(UDlgNode_Selector::StaticClass(), {5});
+	Builder.AddNode(UDlgNode_Speech::StaticClass(), {6});
+	Builder.AddNode(UDlgNode_Speech::StaticClass(), {7});
+	const int32 EndIndex = Builder.AddNode(UDlgNode_End::StaticClass());
+	for (const int32 NodeIndex : {0, 3})
+	{
+		FDlgCondition Never;
+		Never.ConditionType = EDlgConditionType::WasNodeVisited;
+		Never.IntValue = EndIndex;
+		Builder.GetNode(NodeIndex)->GetMutableNodeChildAt(1)->Conditions.Add(Never);
+	}
+
+	const FDlgTestDialogueScope Scope(Builder.Finish());
+	UDlgContext* Context = Scope.NewContext();
+	const bool bStarted = Context->Start(Scope.GetDialogue(), Scope.CreateParticipants());
+	TestTrue(TEXT("Started"), bStarted);
+	TestEqual(TEXT("Active node"), Context->GetActiveNodeIndex(), 0);
+
+	TArray<int32> Reachable;
+	Context->GetReachableNodeIndices(0, Reachable);
+	TestEqual(TEXT("Nothing without depth"), Reachable.Num(), 0);
+
+	// The first step only goes through the satisfied options, the proxy is passed through
+	Context->GetReachableNodeIndices(1, Reachable);
+	TestTrue(TEXT("First step"), Reachable == TArray<int32>({3}));
+
+	// The deeper steps go through all the edges, the selector is passed through
+	Context->GetReachableNodeIndices(2, Reachable);
+	TestTrue(TEXT("Second step"), Reachable == TArray<int32>({3, 2, 5}));
+
+	// Nodes reachable in more ways are only there once
+	Context->GetReachableNodeIndices(4, Reachable);
+	TestTrue(TEXT("Fourth step"), Reachable == TArray<int32>({3, 2, 5, 6, EndIndex}));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
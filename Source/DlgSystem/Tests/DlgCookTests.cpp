@@ -0,0 +1,113 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/ObjectReader.h"
+#include "Sound/DialogueWave.h"
+#include "Sound/SoundWave.h"
+#include "UObject/Package.h"
+
+#include "DlgRuntimeBenchmarkTypes.h"
+#include "DlgSystem/DlgCookStripping.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/Nodes/DlgNode.h"
+#include "DlgSystem/Nodes/DlgNodeSoftAssets.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgCookStripTest,
+	"DlgSystem.Runtime.Cook.Strip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgCookStripTest::RunTest(const FString& Parameters)
+{
+	FDlgSyntheticDialogueOptions Options;
+	Options.ConditionDensity = 0.5f;
+	UDlgDialogue* Dialogue = FDlgSyntheticDialogue::Generate(Options);
+
+	const TMap<FGameplayTag, FDlgParticipantData> ParticipantsData = Dialogue->GetParticipantsData();
+	const FGuid LastNodeGUID = Dialogue->GetNodes().Last()->GetGUID();
+	const int32 LastNodeIndexForGUID = Dialogue->GetNodeIndexForGUID(LastNodeGUID);
+
+	const int64 StrippedBytes = FDlgCookStripScope::GetStrippedBytes(*Dialogue);
+	TestTrue(TEXT("Stripping makes the dialogue smaller"), StrippedBytes > 0);
+
+	// The editor object is left as it was
+	TestEqual(TEXT("Participants are restored"), Dialogue->GetParticipantsData().Num(), ParticipantsData.Num());
+	for (const auto& KeyValue : ParticipantsData)
+	{
+		TestEqual(
+			TEXT("Participant names are restored"),
+			Dialogue->GetParticipantIntNames(KeyValue.Key).Num(),
+			KeyValue.Value.IntVariableNames.Num()
+		);
+	}
+	TestEqual(TEXT("GUID map is restored"), Dialogue->GetNodeIndexForGUID(LastNodeGUID), LastNodeIndexForGUID);
+
+	AddInfo(FString::Printf(TEXT("Cook stripping saves %lld bytes of the dialogue object"), StrippedBytes));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgCookSoftAssetsTest,
+	"DlgSystem.Runtime.Cook.SoftAssets",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgCookSoftAssetsTest::RunTest(const FString& Parameters)
+{
+	USoundWave* SoundWave = NewObject<USoundWave>(GetTransientPackage(), NAME_None, RF_Transient);
+	UDialogueWave* DialogueWave = NewObject<UDialogueWave>(GetTransientPackage(), NAME_None, RF_Transient);
+	UObject* GenericData = NewObject<UDlgBenchmarkParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+
+	// Move and restore
+	{
+		USoundBase* Voice = SoundWave;
+		UDialogueWave* Wave = DialogueWave;
+		UObject* Data = GenericData;
+		FDlgNodeSoftAssets SoftAssets;
+		SoftAssets.MoveFrom(Voice, Wave, Data);
+		TestTrue(TEXT("The hard references are moved out"), Voice == nullptr && Wave == nullptr && Data == nullptr);
+		TestTrue(
+			TEXT("The soft references point to the assets"),
+			SoftAssets.GetVoiceSoundBase() == SoundWave && SoftAssets.GetVoiceDialogueWave() == DialogueWave && SoftAssets.GetGenericData() == GenericData
+		);
+
+		TArray<FSoftObjectPath> Paths;
+		SoftAssets.GetPaths(Paths);
+		TestEqual(TEXT("Soft paths"), Paths.Num(), 3);
+
+		SoftAssets.Restore(Voice, Wave, Data);
+		TestTrue(TEXT("The hard references are restored"), Voice == SoundWave && Wave == DialogueWave && Data == GenericData);
+		TestTrue(TEXT("The soft references are cleared"), SoftAssets.IsEmpty());
+	}
+
+	// The swap around the serialization of a cooked speech node
+	UDlgNode_Speech* Speech = NewObject<UDlgNode_Speech>(GetTransientPackage(), NAME_None, RF_Transient);
+	Speech->SetVoiceSoundBase(SoundWave);
+	Speech->SetVoiceDialogueWave(DialogueWave);
+	Speech->SetGenericData(GenericData);
+
+	TArray<uint8> CookedBytes;
+	FDlgNodeSoftAssets::WriteAsCooked(*Speech, CookedBytes);
+
+	TArray<FSoftObjectPath> EditorPaths;
+	Speech->GetNodeSoftAssetPaths(EditorPaths);
+	TestTrue(TEXT("The editor node keeps its hard references"), Speech->GetNodeVoiceSoundBase() == SoundWave && Speech->GetNodeGenericData() == GenericData);
+	TestEqual(TEXT("The editor node has no soft references"), EditorPaths.Num(), 0);
+
+	UDlgNode_Speech* Cooked = NewObject<UDlgNode_Speech>(GetTransientPackage(), NAME_None, RF_Transient);
+	FObjectReader Reader(Cooked, CookedBytes);
+	TArray<FSoftObjectPath> CookedPaths;
+	Cooked->GetNodeSoftAssetPaths(CookedPaths);
+	TestEqual(TEXT("The cooked node only has soft references"), CookedPaths.Num(), 3);
+	TestTrue(
+		TEXT("The cooked node getters resolve the soft references"),
+		Cooked->GetNodeVoiceSoundBase() == SoundWave && Cooked->GetNodeVoiceDialogueWave() == DialogueWave && Cooked->GetNodeGenericData() == GenericData
+	);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
@@ -0,0 +1,322 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/IO/DlgConfigWriter.h"
+#include "DlgSystem/IO/DlgJsonWriter.h"
+#include "DlgSystem/IO/DlgBinaryWriter.h"
+#include "DlgSystem/IO/DlgConfigParser.h"
+#include "DlgSystem/IO/DlgJsonParser.h"
+#include "DlgSystem/IO/DlgBinaryParser.h"
+#include "DlgIOTesterTypes.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgIOBenchmark, All, All);
+DEFINE_LOG_CATEGORY(LogDlgIOBenchmark);
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+struct FDlgIOBenchmarkResult
+{
+	FString Name;
+
+	// What was written/parsed
+	FString Input;
+
+	int32 Iterations = 0;
+	int64 BytesPerIteration = 0;
+	double TotalSeconds = 0.0;
+
+	double GetBytesPerSecond() const
+	{
+		return TotalSeconds > 0.0 ? static_cast<double>(BytesPerIteration) * Iterations / TotalSeconds : 0.0;
+	}
+
+	FString ToString() const
+	{
+		return FString::Printf(
+			TEXT("%s: %d iterations, %lld bytes/iteration, %.3f ms/iteration, %.2f MB/s"),
+			*Name, Iterations, BytesPerIteration, Iterations > 0 ? TotalSeconds * 1000.0 / Iterations : 0.0,
+			GetBytesPerSecond() / (1024.0 * 1024.0)
+		);
+	}
+
+	static FString GetCSVHeader()
+	{
+		return TEXT("Name,Input,Iterations,BytesPerIteration,MillisecondsPerIteration,MBPerSecond");
+	}
+
+	FString ToCSVRow() const
+	{
+		return FString::Printf(
+			TEXT("%s,%s,%d,%lld,%.4f,%.3f"),
+			*Name, *Input, Iterations, BytesPerIteration, Iterations > 0 ? TotalSeconds * 1000.0 / Iterations : 0.0,
+			GetBytesPerSecond() / (1024.0 * 1024.0)
+		);
+	}
+};
+
+class FDlgIOBenchmark
+{
+public:
+	// Measures Write + ExportToArchive, the same work UDlgDialogue::ExportToFile does minus the disk
+	template <typename WriterType>
+	static FDlgIOBenchmarkResult BenchmarkWriter(
+		const FString& Name,
+		const UStruct* StructDefinition,
+		const void* Object,
+		int32 Iterations,
+		TFunction<WriterType()> CreateWriter
+	)
+	{
+		FDlgIOBenchmarkResult Result;
+		Result.Name = Name;
+		Result.Iterations = Iterations;
+
+		TArray<uint8> Bytes;
+		int32 OutputSizeHint = 0;
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Bytes.Reset();
+			FMemoryWriter Archive(Bytes);
+
+			const double StartTime = FPlatformTime::Seconds();
+			WriterType Writer = CreateWriter();
+			Writer.SetOutputSizeHint(OutputSizeHint);
+			Writer.Write(StructDefinition, Object);
+			Writer.ExportToArchive(Archive);
+			Result.TotalSeconds += FPlatformTime::Seconds() - StartTime;
+
+			// Same as on save, the previous export is the hint for the next one
+			OutputSizeHint = Bytes.Num();
+			Result.BytesPerIteration = Bytes.Num();
+		}
+
+		return Result;
+	}
+
+	// Writes the Object once, the output of ExportToArchive
+	template <typename WriterType>
+	static TArray<uint8> WriteToBytes(const UStruct* StructDefinition, const void* Object, WriterType&& Writer)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Archive(Bytes);
+		Writer.Write(StructDefinition, Object);
+		Writer.ExportToArchive(Archive);
+		return Bytes;
+	}
+
+	/**
+	 * Measures InitializeParser + ReadAllProperty of the Bytes written by ExportToArchive, the same work as importing a text file minus the disk.
+	 * The text formats are decoded from UTF-8 once, outside of the timer, same as FFileHelper::LoadFileToString would.
+	 */
+	template <typename ParserType, typename StructType>
+	static FDlgIOBenchmarkResult BenchmarkParser(const FString& Name, const TArray<uint8>& Bytes, int32 Iterations)
+	{
+		FDlgIOBenchmarkResult Result;
+		Result.Name = Name;
+		Result.Iterations = Iterations;
+		Result.BytesPerIteration = Bytes.Num();
+
+		const FString Text = BytesToText(Bytes);
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			StructType Struct;
+
+			const double StartTime = FPlatformTime::Seconds();
+			ParserType Parser;
+			InitializeParser(Parser, Bytes, Text);
+			Parser.ReadAllProperty(StructType::StaticStruct(), &Struct);
+			Result.TotalSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		return Result;
+	}
+
+	// Benchmarks the Writer and then the Parser on what the Writer wrote
+	template <typename WriterType, typename ParserType, typename StructType>
+	static void BenchmarkWriterAndParser(
+		const FString& WriterName,
+		const FString& ParserName,
+		const FString& Input,
+		const StructType& Struct,
+		int32 Iterations,
+		TFunction<WriterType()> CreateWriter,
+		TArray<FDlgIOBenchmarkResult>& OutResults
+	)
+	{
+		FDlgIOBenchmarkResult& WriterResult = OutResults.Add_GetRef(
+			BenchmarkWriter<WriterType>(WriterName, StructType::StaticStruct(), &Struct, Iterations, CreateWriter)
+		);
+		WriterResult.Input = Input;
+
+		const TArray<uint8> Bytes = WriteToBytes(StructType::StaticStruct(), &Struct, CreateWriter());
+		FDlgIOBenchmarkResult& ParserResult = OutResults.Add_GetRef(BenchmarkParser<ParserType, StructType>(ParserName, Bytes, Iterations));
+		ParserResult.Input = Input;
+	}
+
+	/**
+	 * Benchmarks the pair on a small (one FDlgTestStructComplex) and a huge (FDlgTestStructHuge) random input.
+	 * The random data only contains what the format supports (see FDlgIOTesterOptions), same as in FDlgIOTester.
+	 */
+	template <typename WriterType, typename ParserType>
+	static void BenchmarkFormat(
+		const FDlgIOTesterOptions& Options,
+		const FString& WriterName,
+		const FString& ParserName,
+		TFunction<WriterType()> CreateWriter,
+		TArray<FDlgIOBenchmarkResult>& OutResults
+	)
+	{
+		// Same random data on every run so that the results are comparable
+		static constexpr int32 Seed = 1337;
+		static constexpr int32 SmallIterations = 500;
+		static constexpr int32 HugeIterations = 5;
+		static constexpr int32 HugeNumElements = 500;
+
+		FMath::RandInit(Seed);
+		FDlgTestStructComplex Small;
+		Small.GenerateRandomData(Options);
+		BenchmarkWriterAndParser<WriterType, ParserType, FDlgTestStructComplex>(
+			WriterName, ParserName, TEXT("Small"), Small, SmallIterations, CreateWriter, OutResults
+		);
+
+		FMath::RandInit(Seed);
+		FDlgTestStructHuge Huge;
+		Huge.GenerateRandomData(Options, HugeNumElements);
+		BenchmarkWriterAndParser<WriterType, ParserType, FDlgTestStructHuge>(
+			WriterName, ParserName, TEXT("Huge"), Huge, HugeIterations, CreateWriter, OutResults
+		);
+	}
+
+	// Gets the loaded dialogue with the most nodes
+	static UDlgDialogue* GetLargestDialogue()
+	{
+		UDlgManager::LoadAllDialoguesIntoMemory();
+
+		UDlgDialogue* LargestDialogue = nullptr;
+		for (UDlgDialogue* Dialogue : UDlgManager::GetAllDialoguesFromMemory())
+		{
+			if (LargestDialogue == nullptr || Dialogue->GetNodes().Num() > LargestDialogue->GetNodes().Num())
+			{
+				LargestDialogue = Dialogue;
+			}
+		}
+
+		return LargestDialogue;
+	}
+
+private:
+	static FString BytesToText(const TArray<uint8>& Bytes)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		return FString(Converter.Length(), Converter.Get());
+	}
+
+	template <typename ParserType>
+	static void InitializeParser(ParserType& Parser, const TArray<uint8>& Bytes, const FString& Text)
+	{
+		Parser.InitializeParserFromString(Text);
+	}
+
+	// The binary format is not text, read the bytes directly
+	static void InitializeParser(FDlgBinaryParser& Parser, const TArray<uint8>& Bytes, const FString& Text)
+	{
+		Parser.InitializeParserFromBytes(Bytes);
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgIOWriterBenchmark,
+	"DlgSystem.IO.Benchmark.Writers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgIOWriterBenchmark::RunTest(const FString& Parameters)
+{
+	static constexpr int32 Iterations = 20;
+
+	UDlgDialogue* Dialogue = FDlgIOBenchmark::GetLargestDialogue();
+	if (Dialogue == nullptr)
+	{
+		AddWarning(TEXT("No dialogues found, nothing to benchmark"));
+		return true;
+	}
+	AddInfo(FString::Printf(TEXT("Benchmarking Dialogue = `%s` with %d nodes"), *Dialogue->GetPathName(), Dialogue->GetNodes().Num()));
+
+	TArray<FDlgIOBenchmarkResult> Results;
+	Results.Add(FDlgIOBenchmark::BenchmarkWriter<FDlgJsonWriter>(
+		TEXT("FDlgJsonWriter"), Dialogue->GetClass(), Dialogue, Iterations,
+		[]() { return FDlgJsonWriter(); }
+	));
+	Results.Add(FDlgIOBenchmark::BenchmarkWriter<FDlgConfigWriter>(
+		TEXT("FDlgConfigWriter"), Dialogue->GetClass(), Dialogue, Iterations,
+		[]() { return FDlgConfigWriter(TEXT("Dlg")); }
+	));
+	Results.Add(FDlgIOBenchmark::BenchmarkWriter<FDlgBinaryWriter>(
+		TEXT("FDlgBinaryWriter"), Dialogue->GetClass(), Dialogue, Iterations,
+		[]() { return FDlgBinaryWriter(); }
+	));
+
+	for (const FDlgIOBenchmarkResult& Result : Results)
+	{
+		TestTrue(FString::Printf(TEXT("%s wrote something"), *Result.Name), Result.BytesPerIteration > 0);
+		UE_LOG(LogDlgIOBenchmark, Display, TEXT("%s"), *Result.ToString());
+		AddInfo(Result.ToString());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgIOParserWriterBenchmark,
+	"DlgSystem.IO.Benchmark.ParsersWriters",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgIOParserWriterBenchmark::RunTest(const FString& Parameters)
+{
+	TArray<FDlgIOBenchmarkResult> Results;
+	FDlgIOBenchmark::BenchmarkFormat<FDlgJsonWriter, FDlgJsonParser>(
+		FDlgIOTesterOptions::MakeForJson(), TEXT("FDlgJsonWriter"), TEXT("FDlgJsonParser"),
+		[]() { return FDlgJsonWriter(); }, Results
+	);
+	FDlgIOBenchmark::BenchmarkFormat<FDlgConfigWriter, FDlgConfigParser>(
+		FDlgIOTesterOptions::MakeForConfig(), TEXT("FDlgConfigWriter"), TEXT("FDlgConfigParser"),
+		[]() { return FDlgConfigWriter(TEXT("Dlg")); }, Results
+	);
+	FDlgIOBenchmark::BenchmarkFormat<FDlgBinaryWriter, FDlgBinaryParser>(
+		FDlgIOTesterOptions::MakeForBinary(), TEXT("FDlgBinaryWriter"), TEXT("FDlgBinaryParser"),
+		[]() { return FDlgBinaryWriter(); }, Results
+	);
+
+	FString CSV = FDlgIOBenchmarkResult::GetCSVHeader() + LINE_TERMINATOR;
+	for (const FDlgIOBenchmarkResult& Result : Results)
+	{
+		TestTrue(FString::Printf(TEXT("%s on %s processed something"), *Result.Name, *Result.Input), Result.BytesPerIteration > 0);
+		CSV += Result.ToCSVRow() + LINE_TERMINATOR;
+		AddInfo(Result.ToString());
+	}
+	UE_LOG(LogDlgIOBenchmark, Display, TEXT("Parser/Writer benchmark:%s%s"), LINE_TERMINATOR, *CSV);
+
+	const FString CSVPath = FPaths::ProjectSavedDir() / TEXT("DlgSystem") / TEXT("IOBenchmark.csv");
+	if (FFileHelper::SaveStringToFile(CSV, *CSVPath))
+	{
+		AddInfo(FString::Printf(TEXT("Results written to `%s`"), *CSVPath));
+	}
+	else
+	{
+		AddWarning(FString::Printf(TEXT("Could not write the results to `%s`"), *CSVPath));
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
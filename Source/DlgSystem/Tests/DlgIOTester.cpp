@@ -9,6 +9,8 @@
 #include "DlgSystem/IO/DlgConfigParser.h"
 #include "DlgSystem/IO/DlgJsonParser.h"
 #include "DlgSystem/IO/DlgJsonWriter.h"
+#include "DlgSystem/IO/DlgBinaryParser.h"
+#include "DlgSystem/IO/DlgBinaryWriter.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogDlgIOTester, All, All);
 DEFINE_LOG_CATEGORY(LogDlgIOTester);
@@ -126,18 +128,9 @@ bool FDlgIOTester::TestAllParsers(FAutomationTestBase& Test)
 {
 	bool bAllSucceeded = true;
 
-	FDlgIOTesterOptions Options;
-	Options.bSupportsDatePrimitive = false;
-	Options.bSupportsUObjectValueInMap = false;
-	bAllSucceeded &= TestParser<FDlgJsonWriter, FDlgJsonParser>(Test, Options, TEXT("FDlgJsonWriter"), TEXT("FDlgJsonParser"));
-
-	Options = {};
-	Options.bSupportsPureEnumContainer = false;
-	Options.bSupportsNonPrimitiveInSet = false;
-	Options.bSupportsColorPrimitives = false;
-	Options.bSupportsDatePrimitive = false;
-	Options.bSupportsUObjectValueInMap = false;
-	bAllSucceeded &= TestParser<FDlgConfigWriter, FDlgConfigParser>(Test, Options, TEXT("FDlgConfigWriter"), TEXT("FDlgConfigParser"));
+	bAllSucceeded &= TestParser<FDlgJsonWriter, FDlgJsonParser>(Test, FDlgIOTesterOptions::MakeForJson(), TEXT("FDlgJsonWriter"), TEXT("FDlgJsonParser"));
+	bAllSucceeded &= TestParser<FDlgConfigWriter, FDlgConfigParser>(Test, FDlgIOTesterOptions::MakeForConfig(), TEXT("FDlgConfigWriter"), TEXT("FDlgConfigParser"));
+	bAllSucceeded &= TestParser<FDlgBinaryWriter, FDlgBinaryParser>(Test, FDlgIOTesterOptions::MakeForBinary(), TEXT("FDlgBinaryWriter"), TEXT("FDlgBinaryParser"));
 
 	return bAllSucceeded;
 }
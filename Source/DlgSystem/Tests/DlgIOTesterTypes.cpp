@@ -1326,3 +1326,17 @@ bool FDlgTestMapComplex::IsEqual(const Self& Other, FString& OutError) const
 	}
 	return bIsEqual;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgTestStructHuge
+void FDlgTestStructHuge::GenerateRandomData(const FDlgIOTesterOptions& InOptions, int32 NumElements)
+{
+	Options = InOptions;
+	StructsComplex.SetNum(NumElements);
+	MapsComplex.SetNum(NumElements);
+	for (int32 Index = 0; Index < NumElements; Index++)
+	{
+		StructsComplex[Index].GenerateRandomData(Options);
+		MapsComplex[Index].GenerateRandomData(Options);
+	}
+}
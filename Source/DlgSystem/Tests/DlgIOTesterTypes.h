@@ -53,6 +53,32 @@ public:
 			bSupportsPureEnumContainer, bSupportsNonPrimitiveInSet, bSupportsColorPrimitives);
 	}
 
+	// What each parser/writer pair supports
+	static FDlgIOTesterOptions MakeForJson()
+	{
+		FDlgIOTesterOptions Options;
+		Options.bSupportsDatePrimitive = false;
+		Options.bSupportsUObjectValueInMap = false;
+		return Options;
+	}
+	static FDlgIOTesterOptions MakeForConfig()
+	{
+		FDlgIOTesterOptions Options;
+		Options.bSupportsPureEnumContainer = false;
+		Options.bSupportsNonPrimitiveInSet = false;
+		Options.bSupportsColorPrimitives = false;
+		Options.bSupportsDatePrimitive = false;
+		Options.bSupportsUObjectValueInMap = false;
+		return Options;
+	}
+	static FDlgIOTesterOptions MakeForBinary()
+	{
+		// FDateTime is exported as text with millisecond precision
+		FDlgIOTesterOptions Options;
+		Options.bSupportsDatePrimitive = false;
+		return Options;
+	}
+
 };
 
 
@@ -659,3 +685,24 @@ public:
 	UPROPERTY()
 	TMap<FName, FDlgTestSetComplex> NameToStructOfSetComplex;
 };
+
+// Lots of complex structs, the huge input of the IO benchmarks
+USTRUCT()
+struct DLGSYSTEM_API FDlgTestStructHuge
+{
+	GENERATED_USTRUCT_BODY()
+	typedef FDlgTestStructHuge Self;
+public:
+	FDlgTestStructHuge() {}
+	void GenerateRandomData(const FDlgIOTesterOptions& InOptions, int32 NumElements);
+
+public:
+	// Tester Options
+	FDlgIOTesterOptions Options;
+
+	UPROPERTY()
+	TArray<FDlgTestStructComplex> StructsComplex;
+
+	UPROPERTY()
+	TArray<FDlgTestMapComplex> MapsComplex;
+};
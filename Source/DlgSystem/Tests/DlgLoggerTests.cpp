@@ -0,0 +1,70 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgSystem/Logging/INYLogger.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgLoggerTests, All, All);
+DEFINE_LOG_CATEGORY(LogDlgLoggerTests);
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgLoggerRateLimitTest,
+	"DlgSystem.Runtime.Logger.RateLimit",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgLoggerRateLimitTest::RunTest(const FString& Parameters)
+{
+	INYLogger Logger = INYLogger::New();
+	Logger.OnlyEnableOutputLog().SetOutputLogCategory(LogDlgLoggerTests).SetRateLimitSeconds(3600.f);
+
+	int32 NumFormatted = 0;
+	const auto MakeMessage = [&NumFormatted]()
+	{
+		NumFormatted++;
+		return FString::Printf(TEXT("Rate limited message %d"), NumFormatted);
+	};
+
+	const int32 FirstOwner = 0;
+	const int32 SecondOwner = 0;
+	for (int32 Index = 0; Index < 10; Index++)
+	{
+		Logger.LogLazy(ENYLoggerLogLevel::Info, &FirstOwner, MakeMessage);
+	}
+	TestEqual(TEXT("Repeated message of the same owner is formatted once"), NumFormatted, 1);
+
+	Logger.LogLazy(ENYLoggerLogLevel::Info, &SecondOwner, MakeMessage);
+	TestEqual(TEXT("Other owner is not limited"), NumFormatted, 2);
+
+	Logger.LogLazy(ENYLoggerLogLevel::Info, &FirstOwner, [&NumFormatted]()
+	{
+		NumFormatted++;
+		return FString(TEXT("Other call site"));
+	});
+	TestEqual(TEXT("Other call site is not limited"), NumFormatted, 3);
+
+	Logger.DisableOutputLog();
+	Logger.SetRateLimitSeconds(0.f);
+	Logger.LogLazy(ENYLoggerLogLevel::Info, &FirstOwner, MakeMessage);
+	TestEqual(TEXT("Nothing is formatted without an output"), NumFormatted, 3);
+
+	Logger.EnableOutputLog();
+	Logger.LogLazy(ENYLoggerLogLevel::Info, &FirstOwner, MakeMessage);
+	Logger.LogLazy(ENYLoggerLogLevel::Info, &FirstOwner, MakeMessage);
+	TestEqual(TEXT("Without a rate limit every message is formatted"), NumFormatted, 5);
+
+	// A new owner at the address of a destroyed one is not limited by the messages of the old one
+	Logger.SetRateLimitSeconds(3600.f);
+	Logger.LogLazy(ENYLoggerLogLevel::Info, &FirstOwner, MakeMessage);
+	TestEqual(TEXT("Still limited by the message logged before"), NumFormatted, 5);
+	Logger.ForgetRateLimits(&FirstOwner);
+	Logger.LogLazy(ENYLoggerLogLevel::Info, &FirstOwner, MakeMessage);
+	TestEqual(TEXT("Not limited once the owner is forgotten"), NumFormatted, 6);
+
+	Logger.ResetRateLimits();
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
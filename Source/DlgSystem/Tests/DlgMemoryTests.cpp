@@ -0,0 +1,111 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "DlgSystem/DlgMemory.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgMemorySaveTest,
+	"DlgSystem.Runtime.Memory.Save",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgMemorySaveTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumDialogues = 50;
+	static constexpr int32 NumNodes = 200;
+
+	FRandomStream Random(1337);
+	FDlgMemory Memory;
+	TArray<FGuid> DialogueGUIDs;
+	for (int32 DialogueIndex = 0; DialogueIndex < NumDialogues; DialogueIndex++)
+	{
+		const FGuid DialogueGUID = FGuid::NewGuid();
+		DialogueGUIDs.Add(DialogueGUID);
+		for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+		{
+			if (Random.FRand() < 0.3f)
+			{
+				Memory.SetNodeVisited(DialogueGUID, NodeIndex, FGuid::NewGuid());
+			}
+		}
+
+		FDlgNodeSavedData& Data = Memory.FindOrAddEntry(DialogueGUID).GetNodeData(FGuid::NewGuid());
+		Data.NumEdges = 40;
+		Data.EdgesHash = Random.GetUnsignedInt();
+		Data.SetEdgePicked(Random.RandHelper(40), true);
+		Data.LastPickedEdgeIndex = 3;
+	}
+
+	TArray<uint8> FullSave;
+	Memory.SaveToBytes(FullSave);
+	TestFalse(TEXT("Nothing dirty after saving"), Memory.HasDirtyDialogues());
+
+	FDlgMemory Loaded;
+	TestTrue(TEXT("Load full save"), Loaded.LoadFromBytes(FullSave));
+	TestEqual(TEXT("Number of dialogues"), Loaded.GetHistoryMaps().Num(), Memory.GetHistoryMaps().Num());
+	for (const auto& KeyValue : Memory.GetHistoryMaps())
+	{
+		const FDlgHistory* LoadedHistory = Loaded.GetHistoryMaps().Find(KeyValue.Key);
+		TestTrue(TEXT("Dialogue history round trip"), LoadedHistory != nullptr && *LoadedHistory == KeyValue.Value);
+		if (LoadedHistory != nullptr)
+		{
+			for (const auto& NodeData : KeyValue.Value.NodeData)
+			{
+				const FDlgNodeSavedData* LoadedData = LoadedHistory->NodeData.Find(NodeData.Key);
+				TestTrue(
+					TEXT("Node data round trip"),
+					LoadedData != nullptr && LoadedData->PickedEdgesMask == NodeData.Value.PickedEdgesMask
+					&& LoadedData->LastPickedEdgeIndex == NodeData.Value.LastPickedEdgeIndex && LoadedData->NumEdges == NodeData.Value.NumEdges
+					&& LoadedData->EdgesHash == NodeData.Value.EdgesHash
+				);
+			}
+		}
+	}
+
+	// Only one dialogue changes
+	const FGuid NewNodeGUID = FGuid::NewGuid();
+	Memory.SetNodeVisited(DialogueGUIDs[0], NumNodes, NewNodeGUID);
+	TArray<uint8> DirtySave;
+	Memory.SaveToBytes(DirtySave, true);
+	TestTrue(TEXT("Dirty only save is smaller"), DirtySave.Num() < FullSave.Num());
+	TestTrue(TEXT("Load dirty only save"), Loaded.LoadFromBytes(DirtySave));
+	TestTrue(TEXT("Dirty only save merged"), *Loaded.GetHistoryMaps().Find(DialogueGUIDs[0]) == *Memory.GetHistoryMaps().Find(DialogueGUIDs[0]));
+	TestEqual(TEXT("Dirty only save keeps the others"), Loaded.GetHistoryMaps().Num(), Memory.GetHistoryMaps().Num());
+
+	// Reading does not dirty
+	Memory.GetEntry(DialogueGUIDs[0]);
+	TestFalse(TEXT("Nothing is dirty after GetEntry"), Memory.HasDirtyDialogues());
+	Memory.SetNodeVisited(DialogueGUIDs[0], NumNodes, NewNodeGUID);
+	TestFalse(TEXT("Nothing is dirty after a revisit"), Memory.HasDirtyDialogues());
+
+	TArray<uint8> Corrupt = FullSave;
+	Corrupt.SetNum(Corrupt.Num() / 2);
+	AddExpectedError(TEXT("the save is truncated"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Truncated save is rejected"), Loaded.LoadFromBytes(Corrupt));
+
+	// A compressed payload that would decompress to 2 GB, rejected before it is allocated
+	{
+		Corrupt.Reset();
+		FMemoryWriter Writer(Corrupt);
+		uint32 Magic = 0x4D474C44;
+		uint8 Version = 1;
+		uint8 Flags = 0;
+		int32 PayloadSize = MAX_int32;
+		int32 CompressedSize = 16;
+		Writer << Magic << Version << Flags << PayloadSize << CompressedSize;
+		Corrupt.AddZeroed(CompressedSize);
+	}
+	AddExpectedError(TEXT("the payload size is corrupt"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Oversized payload is rejected"), Loaded.LoadFromBytes(Corrupt));
+
+	AddInfo(FString::Printf(TEXT("Memory save: full = %d bytes, dirty only = %d bytes"), FullSave.Num(), DirtySave.Num()));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,174 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgRuntimeBenchmarkTypes.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/Nodes/DlgNode.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgRuntimeBenchmark, All, All);
+DEFINE_LOG_CATEGORY(LogDlgRuntimeBenchmark);
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+struct FDlgRuntimeBenchmarkResult
+{
+	FString Name;
+	FDlgRandomWalkResult Walks;
+	double WalkSeconds = 0.0;
+
+	// From FDlgContextMetrics, summed over all the walks
+	int64 NumConditionsEvaluated = 0;
+	int64 NumEventsFired = 0;
+	int64 NumTextsFormatted = 0;
+
+	// Growth of UDlgContext::GetAllocatedSize over the walks, the containers of the context are the only allocations the runtime owns
+	int64 ContextBytesAllocated = 0;
+
+	// Size of the UObject + its containers at the end of the walk, averaged
+	double BytesPerContext = 0.0;
+
+	// Only the edges conditions evaluated over and over, without anything else from the step
+	double ConditionsSeconds = 0.0;
+	int64 NumConditionsTimed = 0;
+
+	double GetStepsPerSecond() const { return WalkSeconds > 0.0 ? Walks.NumSteps / WalkSeconds : 0.0; }
+	double GetNanosecondsPerCondition() const { return NumConditionsTimed > 0 ? ConditionsSeconds * 1e9 / NumConditionsTimed : 0.0; }
+	double GetContextBytesPerStep() const { return Walks.NumSteps > 0 ? static_cast<double>(ContextBytesAllocated) / Walks.NumSteps : 0.0; }
+
+	FString ToString() const
+	{
+		return FString::Printf(
+			TEXT("%s: %d walks (%d ended, %d failed to start), %lld steps, %.0f steps/s, %.1f ns/condition, ")
+			TEXT("%.2f conditions/step, %.2f events/step, %.2f texts/step, %.1f context bytes/step, %.0f bytes/context"),
+			*Name, Walks.NumWalks, Walks.NumEnded, Walks.NumFailedToStart, Walks.NumSteps, GetStepsPerSecond(), GetNanosecondsPerCondition(),
+			Walks.NumSteps > 0 ? static_cast<double>(NumConditionsEvaluated) / Walks.NumSteps : 0.0,
+			Walks.NumSteps > 0 ? static_cast<double>(NumEventsFired) / Walks.NumSteps : 0.0,
+			Walks.NumSteps > 0 ? static_cast<double>(NumTextsFormatted) / Walks.NumSteps : 0.0,
+			GetContextBytesPerStep(), BytesPerContext
+		);
+	}
+};
+
+class FDlgRuntimeBenchmark
+{
+public:
+	// Generates the dialogue from the Options and random walks it NumWalks times, each walk with a new context.
+	// Each configuration starts with an empty FDlgMemory, the memory from before is restored after it
+	static FDlgRuntimeBenchmarkResult Run(const FString& Name, const FDlgSyntheticDialogueOptions& Options, int32 NumWalks, int32 MaxStepsPerWalk)
+	{
+		FDlgRuntimeBenchmarkResult Result;
+		Result.Name = Name;
+
+		FRandomStream Random(Options.Seed);
+		const FDlgTestDialogueScope Scope(Options);
+		UDlgDialogue* Dialogue = Scope.GetDialogue();
+		const TMap<FGameplayTag, UObject*> Participants = Scope.CreateParticipants(&Random);
+
+		double TotalBytesPerContext = 0.0;
+		for (int32 WalkIndex = 0; WalkIndex < NumWalks; WalkIndex++)
+		{
+			UDlgContext* Context = Scope.NewContext();
+			const SIZE_T InitialAllocatedSize = Context->GetAllocatedSize();
+
+			const double StartTime = FPlatformTime::Seconds();
+			Result.Walks += FDlgRandomWalk::Walk(*Context, Dialogue, Participants, Random, MaxStepsPerWalk);
+			Result.WalkSeconds += FPlatformTime::Seconds() - StartTime;
+
+			const FDlgContextMetrics& Metrics = Context->GetMetrics();
+			Result.NumConditionsEvaluated += Metrics.NumConditionsEvaluated;
+			Result.NumEventsFired += Metrics.NumEventsFired;
+			Result.NumTextsFormatted += Metrics.NumTextsFormatted;
+			Result.ContextBytesAllocated += static_cast<int64>(Context->GetAllocatedSize()) - static_cast<int64>(InitialAllocatedSize);
+			TotalBytesPerContext += Context->GetClass()->GetStructureSize() + Context->GetAllocatedSize();
+
+			// Conditions only, on the last context as it has some history
+			if (WalkIndex == NumWalks - 1)
+			{
+				MeasureConditions(*Context, *Dialogue, Result);
+			}
+		}
+		Result.BytesPerContext = NumWalks > 0 ? TotalBytesPerContext / NumWalks : 0.0;
+
+		return Result;
+	}
+
+	static void MeasureConditions(UDlgContext& Context, const UDlgDialogue& Dialogue, FDlgRuntimeBenchmarkResult& Result)
+	{
+		static constexpr int32 Iterations = 20;
+		const int32 ConditionsBefore = Context.GetMetrics().NumConditionsEvaluated;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (const UDlgNode* Node : Dialogue.GetNodes())
+			{
+				for (const FDlgEdge& Edge : Node->GetNodeChildren())
+				{
+					if (Edge.Conditions.Num() > 0)
+					{
+						FDlgCondition::EvaluateArray(Context, Edge.Conditions);
+					}
+				}
+			}
+		}
+		Result.ConditionsSeconds = FPlatformTime::Seconds() - StartTime;
+		Result.NumConditionsTimed = Context.GetMetrics().NumConditionsEvaluated - ConditionsBefore;
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgRuntimeRandomWalkBenchmark,
+	"DlgSystem.Runtime.Benchmark.RandomWalk",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgRuntimeRandomWalkBenchmark::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumWalks = 200;
+	static constexpr int32 MaxStepsPerWalk = 200;
+
+	TArray<TPair<FString, FDlgSyntheticDialogueOptions>> Configurations;
+	{
+		FDlgSyntheticDialogueOptions Options;
+		Configurations.Emplace(TEXT("Default"), Options);
+
+		Options.NumNodes = 2000;
+		Options.FanOut = 5;
+		Configurations.Emplace(TEXT("Large"), Options);
+
+		Options = FDlgSyntheticDialogueOptions();
+		Options.ConditionDensity = 1.f;
+		Options.FanOut = 8;
+		Configurations.Emplace(TEXT("ConditionHeavy"), Options);
+
+		Options = FDlgSyntheticDialogueOptions();
+		Options.NumTextArguments = 6;
+		Configurations.Emplace(TEXT("TextArgumentHeavy"), Options);
+
+		Options = FDlgSyntheticDialogueOptions();
+		Options.SelectorChance = 0.35f;
+		Options.ProxyChance = 0.25f;
+		Configurations.Emplace(TEXT("SelectorProxyHeavy"), Options);
+	}
+
+	for (const auto& Configuration : Configurations)
+	{
+		const FDlgRuntimeBenchmarkResult Result = FDlgRuntimeBenchmark::Run(Configuration.Key, Configuration.Value, NumWalks, MaxStepsPerWalk);
+
+		TestTrue(FString::Printf(TEXT("%s started"), *Result.Name), Result.Walks.NumFailedToStart == 0);
+		TestTrue(FString::Printf(TEXT("%s made steps"), *Result.Name), Result.Walks.NumSteps > Result.Walks.NumWalks);
+
+		const FString Message = FString::Printf(TEXT("%s\n\t%s"), *Result.ToString(), *Configuration.Value.ToString());
+		UE_LOG(LogDlgRuntimeBenchmark, Display, TEXT("%s"), *Message);
+		AddInfo(Message);
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,397 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgRuntimeBenchmarkTypes.h"
+
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgConstants.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/Nodes/DlgNode_Start.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+#include "DlgSystem/Nodes/DlgNode_Proxy.h"
+#include "DlgSystem/Nodes/DlgNode_End.h"
+
+namespace DlgSyntheticDialogue
+{
+	static const FName NAME_IntValue(TEXT("IntValue"));
+	static const FName NAME_Condition(TEXT("Condition"));
+
+	enum class ENodeType : uint8
+	{
+		Speech,
+		Selector,
+		Proxy,
+		End
+	};
+
+	// A condition that is cheap to set up but still goes through the participant, the reflection or the history
+	static FDlgCondition MakeCondition(FRandomStream& Random, const FGameplayTag& ParticipantTag, int32 NumNodes)
+	{
+		FDlgCondition Condition;
+		Condition.ParticipantTag = ParticipantTag;
+		switch (Random.RandHelper(4))
+		{
+			case 0:
+				Condition.ConditionType = EDlgConditionType::IntCall;
+				Condition.CallbackName = NAME_IntValue;
+				Condition.Operation = EDlgOperation::GreaterOrEqual;
+				Condition.IntValue = 0;
+				break;
+
+			case 1:
+				Condition.ConditionType = EDlgConditionType::EventCall;
+				Condition.CallbackName = NAME_Condition;
+				Condition.bBoolValue = true;
+				break;
+
+			case 2:
+				Condition.ConditionType = EDlgConditionType::ClassIntVariable;
+				Condition.CallbackName = UDlgBenchmarkParticipant::GetMemberNameClassInt();
+				Condition.Operation = EDlgOperation::GreaterOrEqual;
+				Condition.IntValue = 0;
+				break;
+
+			default:
+				Condition.ConditionType = EDlgConditionType::WasNodeVisited;
+				Condition.IntValue = Random.RandHelper(NumNodes);
+				Condition.bBoolValue = Random.FRand() < 0.5f;
+				Condition.bLongTermMemory = false;
+				break;
+		}
+
+		return Condition;
+	}
+}
+
+UDlgDialogue* FDlgSyntheticDialogue::Generate(const FDlgSyntheticDialogueOptions& Options, UObject* Outer)
+{
+	using namespace DlgSyntheticDialogue;
+
+	FRandomStream Random(Options.Seed);
+	Outer = Outer ? Outer : GetTransientPackage();
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(Outer, NAME_None, RF_Transient);
+
+	const int32 NumNodes = FMath::Max(Options.NumNodes, 2);
+	const int32 FanOut = FMath::Max(Options.FanOut, 1);
+	const TArray<FGameplayTag> ParticipantTags = GetParticipantTags(Options.NumParticipants);
+	auto GetRandomParticipantTag = [&Random, &ParticipantTags]() { return ParticipantTags[Random.RandHelper(ParticipantTags.Num())]; };
+
+	// Decide the node types first, the last node is always an end node
+	TArray<ENodeType> NodeTypes;
+	TArray<int32> SpeechNodeIndices;
+	TArray<int32> SpeechOrEndNodeIndices;
+	NodeTypes.SetNum(NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+	{
+		const float Roll = Random.FRand();
+		ENodeType Type = ENodeType::Speech;
+		if (NodeIndex == NumNodes - 1 || Roll < Options.EndChance)
+		{
+			Type = ENodeType::End;
+		}
+		else if (Roll < Options.EndChance + Options.SelectorChance)
+		{
+			Type = ENodeType::Selector;
+		}
+		else if (Roll < Options.EndChance + Options.SelectorChance + Options.ProxyChance)
+		{
+			Type = ENodeType::Proxy;
+		}
+
+		NodeTypes[NodeIndex] = Type;
+		if (Type == ENodeType::Speech)
+		{
+			SpeechNodeIndices.Add(NodeIndex);
+		}
+		if (Type == ENodeType::Speech || Type == ENodeType::End)
+		{
+			SpeechOrEndNodeIndices.Add(NodeIndex);
+		}
+	}
+	if (SpeechNodeIndices.Num() == 0)
+	{
+		NodeTypes[0] = ENodeType::Speech;
+		SpeechNodeIndices.Add(0);
+		SpeechOrEndNodeIndices.Insert(0, 0);
+	}
+
+	// Selectors and proxies only point to speech/end nodes so that they can not form loops inside a step
+	auto AddChildren = [&](UDlgNode* Node, bool bOnlySpeechOrEnd)
+	{
+		for (int32 EdgeIndex = 0; EdgeIndex < FanOut; EdgeIndex++)
+		{
+			FDlgEdge Edge;
+			Edge.TargetIndex = bOnlySpeechOrEnd
+				? SpeechOrEndNodeIndices[Random.RandHelper(SpeechOrEndNodeIndices.Num())]
+				: Random.RandHelper(NumNodes);
+			Edge.SetText(FText::FromString(FString::Printf(TEXT("Option %d"), EdgeIndex)));
+			if (EdgeIndex > 0 && Random.FRand() < Options.ConditionDensity)
+			{
+				Edge.Conditions.Add(MakeCondition(Random, GetRandomParticipantTag(), NumNodes));
+			}
+			Node->AddNodeChild(Edge);
+		}
+	};
+
+	TArray<UDlgNode*> Nodes;
+	Nodes.Reserve(NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+	{
+		UDlgNode* Node = nullptr;
+		switch (NodeTypes[NodeIndex])
+		{
+			case ENodeType::Speech:
+			{
+				UDlgNode_Speech* Speech = NewObject<UDlgNode_Speech>(Dialogue, NAME_None, RF_Transient);
+				const FGameplayTag OwnerTag = GetRandomParticipantTag();
+				Speech->SetNodeParticipantTag(OwnerTag);
+
+				// Alternate between the interface and the reflection text arguments
+				FString Text = FString::Printf(TEXT("Line %d"), NodeIndex);
+				TArray<FDlgTextArgument> Arguments;
+				for (int32 ArgumentIndex = 0; ArgumentIndex < Options.NumTextArguments; ArgumentIndex++)
+				{
+					FDlgTextArgument Argument;
+					Argument.DisplayString = FString::Printf(TEXT("Arg%d"), ArgumentIndex);
+					Argument.ParticipantTag = GetRandomParticipantTag();
+					if (ArgumentIndex % 2 == 0)
+					{
+						Argument.Type = EDlgTextArgumentType::DialogueInt;
+						Argument.VariableName = NAME_IntValue;
+					}
+					else
+					{
+						Argument.Type = EDlgTextArgumentType::ClassInt;
+						Argument.VariableName = UDlgBenchmarkParticipant::GetMemberNameClassInt();
+					}
+					Text += FString::Printf(TEXT(" {%s}"), *Argument.DisplayString);
+					Arguments.Add(Argument);
+				}
+				Speech->SetNodeText(FText::FromString(Text), Arguments);
+
+				// Something for the events counters
+				FDlgEvent Event;
+				Event.ParticipantTag = OwnerTag;
+				Event.EventType = EDlgEventType::ModifyInt;
+				Event.EventName = NAME_IntValue;
+				Event.IntValue = 1;
+				Event.bDelta = true;
+				Speech->SetNodeEnterEvents({Event});
+
+				AddChildren(Speech, false);
+				Node = Speech;
+				break;
+			}
+
+			case ENodeType::Selector:
+			{
+				UDlgNode_Selector* Selector = NewObject<UDlgNode_Selector>(Dialogue, NAME_None, RF_Transient);
+				Selector->SetNodeParticipantTag(GetRandomParticipantTag());
+				Selector->SetSelectorType(Random.FRand() < 0.5f ? EDlgNodeSelectorType::First : EDlgNodeSelectorType::Random);
+				AddChildren(Selector, true);
+				Node = Selector;
+				break;
+			}
+
+			case ENodeType::Proxy:
+			{
+				UDlgNode_Proxy* Proxy = NewObject<UDlgNode_Proxy>(Dialogue, NAME_None, RF_Transient);
+				Proxy->SetNodeParticipantTag(GetRandomParticipantTag());
+				Proxy->SetTargetNodeIndex(SpeechNodeIndices[Random.RandHelper(SpeechNodeIndices.Num())]);
+				Node = Proxy;
+				break;
+			}
+
+			default:
+			{
+				UDlgNode_End* End = NewObject<UDlgNode_End>(Dialogue, NAME_None, RF_Transient);
+				End->SetNodeParticipantTag(GetRandomParticipantTag());
+				Node = End;
+				break;
+			}
+		}
+
+		Node->RegenerateGUID();
+		Nodes.Add(Node);
+	}
+
+	// The start node goes to the first speech node, the others through conditions
+	UDlgNode_Start* StartNode = NewObject<UDlgNode_Start>(Dialogue, NAME_None, RF_Transient);
+	StartNode->SetNodeParticipantTag(ParticipantTags[0]);
+	StartNode->RegenerateGUID();
+	{
+		FDlgEdge Edge;
+		Edge.TargetIndex = SpeechNodeIndices[0];
+		StartNode->AddNodeChild(Edge);
+	}
+
+	Dialogue->SetNodes(Nodes);
+	Dialogue->AddStartNode(StartNode);
+	Dialogue->UpdateAndRefreshData();
+	return Dialogue;
+}
+
+TArray<FGameplayTag> FDlgSyntheticDialogue::GetParticipantTags(int32 NumParticipants)
+{
+	const TArray<FGameplayTag> AllTags = {
+		TAG_Dlg_Hero, TAG_Dlg_Human, TAG_Dlg_Cat, TAG_Dlg_Frog, TAG_Dlg_Critter, TAG_Dlg_Object, TAG_Dlg_Other
+	};
+
+	TArray<FGameplayTag> Tags;
+	for (int32 Index = 0; Index < FMath::Clamp(NumParticipants, 1, AllTags.Num()); Index++)
+	{
+		Tags.Add(AllTags[Index]);
+	}
+	return Tags;
+}
+
+TMap<FGameplayTag, UObject*> FDlgSyntheticDialogue::CreateParticipants(const UDlgDialogue& Dialogue, FRandomStream* Random, UObject* Outer)
+{
+	Outer = Outer ? Outer : GetTransientPackage();
+
+	TMap<FGameplayTag, UObject*> Participants;
+	for (const FGameplayTag& ParticipantTag : Dialogue.GetParticipantTags())
+	{
+		UDlgBenchmarkParticipant* Participant = NewObject<UDlgBenchmarkParticipant>(Outer, NAME_None, RF_Transient);
+		Participant->Setup(ParticipantTag, Random);
+		Participants.Add(ParticipantTag, Participant);
+	}
+	return Participants;
+}
+
+FDlgTestDialogueBuilder::FDlgTestDialogueBuilder()
+	: Dialogue(NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient))
+	, ParticipantTag(FDlgSyntheticDialogue::GetParticipantTags(1)[0])
+{
+}
+
+int32 FDlgTestDialogueBuilder::AddNode(TSubclassOf<UDlgNode> NodeClass, const TArray<int32>& Targets)
+{
+	UDlgNode* Node = NewObject<UDlgNode>(Dialogue, NodeClass, NAME_None, RF_Transient);
+	Node->SetNodeParticipantTag(ParticipantTag);
+	Node->RegenerateGUID();
+	if (UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Node))
+	{
+		check(Targets.Num() == 1);
+		Proxy->SetTargetNodeIndex(Targets[0]);
+	}
+	else
+	{
+		for (const int32 TargetIndex : Targets)
+		{
+			FDlgEdge Edge;
+			Edge.TargetIndex = TargetIndex;
+			Node->AddNodeChild(Edge);
+		}
+	}
+
+	return Nodes.Add(Node);
+}
+
+UDlgDialogue* FDlgTestDialogueBuilder::Finish(int32 StartTargetIndex)
+{
+	UDlgNode_Start* StartNode = NewObject<UDlgNode_Start>(Dialogue, NAME_None, RF_Transient);
+	StartNode->SetNodeParticipantTag(ParticipantTag);
+	StartNode->RegenerateGUID();
+	{
+		FDlgEdge Edge;
+		Edge.TargetIndex = StartTargetIndex;
+		StartNode->AddNodeChild(Edge);
+	}
+
+	Dialogue->SetNodes(Nodes);
+	Dialogue->AddStartNode(StartNode);
+	Dialogue->UpdateAndRefreshData();
+	return Dialogue;
+}
+
+FDlgRandomWalkResult FDlgRandomWalk::Walk(
+	UDlgContext& Context,
+	UDlgDialogue* Dialogue,
+	const TMap<FGameplayTag, UObject*>& Participants,
+	FRandomStream& Random,
+	int32 MaxSteps
+)
+{
+	FDlgRandomWalkResult Result;
+	Result.NumWalks = 1;
+	Result.NumSteps = 1;
+
+	// The random selectors use the stream of the context, seed it from ours so that the walk only depends on Random
+	Context.SetRandomSeed(static_cast<int32>(Random.GetUnsignedInt()));
+
+	// The walk reads the options right after each step and nothing is played, it can also run outside of the game thread
+	Context.SetTimeSliceOptionsEvaluation(false);
+	Context.SetPrefetchReachableNodes(false);
+	if (!Context.Start(Dialogue, Participants))
+	{
+		Result.NumFailedToStart = 1;
+		return Result;
+	}
+
+	while (Result.NumSteps < MaxSteps)
+	{
+		const int32 NumOptions = Context.GetOptionsNum();
+		if (NumOptions == 0)
+		{
+			break;
+		}
+
+		Result.NumSteps++;
+		if (!Context.ChooseOption(Random.RandHelper(NumOptions)))
+		{
+			// Either the end node or a failure
+			break;
+		}
+	}
+
+	if (Cast<UDlgNode_End>(Context.GetActiveNode()) != nullptr)
+	{
+		Result.NumEnded = 1;
+	}
+	else if (Result.NumSteps >= MaxSteps)
+	{
+		Result.NumMaxStepsReached = 1;
+	}
+	else
+	{
+		Result.NumDeadEnds = 1;
+	}
+
+	return Result;
+}
+
+FDlgTestDialogueScope::FDlgTestDialogueScope(const FDlgSyntheticDialogueOptions& Options)
+	: FDlgTestDialogueScope(FDlgSyntheticDialogue::Generate(Options))
+{
+}
+
+FDlgTestDialogueScope::FDlgTestDialogueScope(UDlgDialogue* InDialogue)
+	: Dialogue(InDialogue)
+	, PreviousMemory(FDlgMemory::Get().GetHistoryMaps())
+{
+	ResetMemory();
+}
+
+FDlgTestDialogueScope::~FDlgTestDialogueScope()
+{
+	FDlgMemory::Get().SetHistoryMap(PreviousMemory);
+}
+
+void FDlgTestDialogueScope::ResetMemory() const
+{
+	FDlgMemory::Get().Empty();
+}
+
+UDlgContext* FDlgTestDialogueScope::NewContext(bool bTimeSlice) const
+{
+	UDlgContext* Context = NewObject<UDlgContext>(GetTransientPackage(), NAME_None, RF_Transient);
+	Context->SetTimeSliceOptionsEvaluation(bTimeSlice);
+	return Context;
+}
+
+TMap<FGameplayTag, UObject*> FDlgTestDialogueScope::CreateParticipants(FRandomStream* Random) const
+{
+	return FDlgSyntheticDialogue::CreateParticipants(*Dialogue, Random);
+}
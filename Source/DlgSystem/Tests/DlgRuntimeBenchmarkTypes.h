@@ -0,0 +1,312 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Math/RandomStream.h"
+#include "GameplayTagContainer.h"
+
+#include "DlgSystem/DlgDialogueParticipant.h"
+#include "DlgSystem/DlgMemory.h"
+
+#include "DlgRuntimeBenchmarkTypes.generated.h"
+
+class UDlgDialogue;
+class UDlgContext;
+class UDlgNode;
+
+// The answers of one mock participant, see FDlgSimulationFixture
+USTRUCT()
+struct DLGSYSTEM_API FDlgParticipantFixture
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	// The named conditions (CheckCondition) with a fixed answer, the rest are random
+	UPROPERTY()
+	TMap<FName, bool> Conditions;
+
+	// The values the participant starts each walk with
+	UPROPERTY()
+	TMap<FName, int32> Ints;
+
+	UPROPERTY()
+	TMap<FName, float> Floats;
+
+	UPROPERTY()
+	TMap<FName, bool> Bools;
+
+	UPROPERTY()
+	TMap<FName, FName> Names;
+};
+
+// How the mock participants of a simulation answer, read from a JSON file (see FDlgJsonParser)
+USTRUCT()
+struct DLGSYSTEM_API FDlgSimulationFixture
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	// Chance of a named condition without a fixed answer to be true
+	UPROPERTY()
+	float ConditionTrueChance = 0.5f;
+
+	// Key: the participant tag name
+	UPROPERTY()
+	TMap<FName, FDlgParticipantFixture> Participants;
+};
+
+
+/**
+ * Participant used by the runtime benchmarks and simulations.
+ * Everything is answered natively so that the measurements are about the dialogue runtime and not about blueprints.
+ */
+UCLASS()
+class DLGSYSTEM_API UDlgBenchmarkParticipant : public UObject, public IDlgDialogueParticipant
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @param InRandom					Answers the named conditions (CheckCondition), if nullptr they are always true. Not owned.
+	 * @param InConditionTrueChance	Chance of a named condition to be true
+	 */
+	void Setup(const FGameplayTag& InParticipantTag, FRandomStream* InRandom, float InConditionTrueChance = 0.5f)
+	{
+		ParticipantTag = InParticipantTag;
+		Random = InRandom;
+		ConditionTrueChance = InConditionTrueChance;
+	}
+
+	// Fixed answers and starting values, applied now and on every ResetValues
+	void SetFixture(const FDlgParticipantFixture& InFixture)
+	{
+		Fixture = InFixture;
+		ResetValues();
+	}
+
+	// Back to the values from the fixture, called between the walks of a simulation
+	void ResetValues()
+	{
+		Ints = Fixture.Ints;
+		Floats = Fixture.Floats;
+		Bools = Fixture.Bools;
+		Names = Fixture.Names;
+	}
+
+	int32 GetNumEventsReceived() const { return NumEventsReceived; }
+
+	//
+	// IDlgDialogueParticipant Interface
+	//
+
+	FGameplayTag GetParticipantTag_Implementation() const override { return ParticipantTag; }
+	FText GetParticipantDisplayName_Implementation(const FGameplayTag& ActiveSpeaker) const override { return FText::FromString(ParticipantTag.ToString()); }
+	ETextGender GetParticipantGender_Implementation() const override { return ETextGender::Neuter; }
+	UTexture2D* GetParticipantIcon_Implementation(const FGameplayTag& ActiveSpeaker, FName ActiveSpeakerState) const override { return nullptr; }
+
+	bool CheckCondition_Implementation(const UDlgContext* Context, FName ConditionName) const override
+	{
+		if (const bool* FixedAnswer = Fixture.Conditions.Find(ConditionName))
+		{
+			return *FixedAnswer;
+		}
+		return Random == nullptr || Random->FRand() < ConditionTrueChance;
+	}
+	float GetFloatValue_Implementation(FName ValueName) const override { return Floats.FindRef(ValueName); }
+	int32 GetIntValue_Implementation(FName ValueName) const override { return Ints.FindRef(ValueName); }
+	bool GetBoolValue_Implementation(FName ValueName) const override { return Bools.FindRef(ValueName); }
+	FName GetNameValue_Implementation(FName ValueName) const override { return Names.FindRef(ValueName); }
+
+	bool OnDialogueEvent_Implementation(UDlgContext* Context, FName EventName) override
+	{
+		NumEventsReceived++;
+		return true;
+	}
+	bool ModifyFloatValue_Implementation(FName ValueName, bool bDelta, float Value) override
+	{
+		float& Current = Floats.FindOrAdd(ValueName);
+		Current = bDelta ? Current + Value : Value;
+		NumEventsReceived++;
+		return true;
+	}
+	bool ModifyIntValue_Implementation(FName ValueName, bool bDelta, int32 Value) override
+	{
+		int32& Current = Ints.FindOrAdd(ValueName);
+		Current = bDelta ? Current + Value : Value;
+		NumEventsReceived++;
+		return true;
+	}
+	bool ModifyBoolValue_Implementation(FName ValueName, bool bNewValue) override
+	{
+		Bools.Add(ValueName, bNewValue);
+		NumEventsReceived++;
+		return true;
+	}
+	bool ModifyNameValue_Implementation(FName ValueName, FName NameValue) override
+	{
+		Names.Add(ValueName, NameValue);
+		NumEventsReceived++;
+		return true;
+	}
+
+public:
+	// Read by the EDlgConditionType::ClassIntVariable conditions and the EDlgTextArgumentType::ClassInt text arguments
+	UPROPERTY()
+	int32 ClassInt = 0;
+
+	static FName GetMemberNameClassInt() { return GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, ClassInt); }
+
+protected:
+	UPROPERTY()
+	FGameplayTag ParticipantTag;
+
+	TMap<FName, int32> Ints;
+	TMap<FName, float> Floats;
+	TMap<FName, bool> Bools;
+	TMap<FName, FName> Names;
+
+	FDlgParticipantFixture Fixture;
+	FRandomStream* Random = nullptr;
+	float ConditionTrueChance = 0.5f;
+	int32 NumEventsReceived = 0;
+};
+
+
+// Shape of a generated dialogue, see FDlgSyntheticDialogue
+struct DLGSYSTEM_API FDlgSyntheticDialogueOptions
+{
+	// Number of nodes besides the start node
+	int32 NumNodes = 100;
+
+	// Children of each speech and selector node
+	int32 FanOut = 3;
+
+	// Chance of an edge to have a condition, the first edge of each node never has one so there is always a way forward
+	float ConditionDensity = 0.5f;
+
+	// Text arguments in the text of each speech node
+	int32 NumTextArguments = 1;
+
+	// Chance of each node to be a selector, proxy or end node, the rest are speech nodes
+	float SelectorChance = 0.1f;
+	float ProxyChance = 0.05f;
+	float EndChance = 0.05f;
+
+	// At most 7, see GetParticipantTags
+	int32 NumParticipants = 2;
+
+	int32 Seed = 0;
+
+	FString ToString() const
+	{
+		return FString::Printf(
+			TEXT("Nodes = %d, FanOut = %d, ConditionDensity = %.2f, TextArguments = %d, Selector = %.2f, Proxy = %.2f, End = %.2f, Participants = %d, Seed = %d"),
+			NumNodes, FanOut, ConditionDensity, NumTextArguments, SelectorChance, ProxyChance, EndChance, NumParticipants, Seed
+		);
+	}
+};
+
+// Builds dialogues in memory, no assets, graphs or text files involved
+class DLGSYSTEM_API FDlgSyntheticDialogue
+{
+public:
+	// The same Options always generate the same dialogue
+	static UDlgDialogue* Generate(const FDlgSyntheticDialogueOptions& Options, UObject* Outer = nullptr);
+
+	// The participant tags used by the generated dialogues, from the native DlgSystem tags
+	static TArray<FGameplayTag> GetParticipantTags(int32 NumParticipants);
+
+	// Creates one UDlgBenchmarkParticipant for each participant of the Dialogue
+	static TMap<FGameplayTag, UObject*> CreateParticipants(const UDlgDialogue& Dialogue, FRandomStream* Random, UObject* Outer = nullptr);
+};
+
+// Builds a dialogue node by node, for the tests that need an exact shape. All the nodes belong to a single participant.
+class DLGSYSTEM_API FDlgTestDialogueBuilder
+{
+public:
+	FDlgTestDialogueBuilder();
+
+	// Adds a node with an edge to each of the Targets, a proxy gets the first target instead
+	int32 AddNode(TSubclassOf<UDlgNode> NodeClass, const TArray<int32>& Targets = {});
+
+	UDlgNode* GetNode(int32 NodeIndex) const { return Nodes[NodeIndex]; }
+	const FGameplayTag& GetParticipantTag() const { return ParticipantTag; }
+
+	// Gives the nodes to the dialogue with a start node that goes to StartTargetIndex
+	UDlgDialogue* Finish(int32 StartTargetIndex = 0);
+
+private:
+	UDlgDialogue* Dialogue = nullptr;
+	FGameplayTag ParticipantTag;
+	TArray<UDlgNode*> Nodes;
+};
+
+
+struct DLGSYSTEM_API FDlgRandomWalkResult
+{
+	int32 NumWalks = 0;
+	int64 NumSteps = 0;
+
+	// Each walk either reached an end node, failed to start, hit MaxSteps or got stuck in a dead end
+	int32 NumEnded = 0;
+	int32 NumFailedToStart = 0;
+	int32 NumMaxStepsReached = 0;
+
+	// Stopped on a node that is not an end node, because it had no satisfied option or because entering the next node failed
+	int32 NumDeadEnds = 0;
+
+	FDlgRandomWalkResult& operator+=(const FDlgRandomWalkResult& Other)
+	{
+		NumWalks += Other.NumWalks;
+		NumSteps += Other.NumSteps;
+		NumEnded += Other.NumEnded;
+		NumFailedToStart += Other.NumFailedToStart;
+		NumMaxStepsReached += Other.NumMaxStepsReached;
+		NumDeadEnds += Other.NumDeadEnds;
+		return *this;
+	}
+};
+
+// Drives a context by choosing random satisfied options
+class DLGSYSTEM_API FDlgRandomWalk
+{
+public:
+	// Starts the Context on the Dialogue, one step is the start and each ChooseOption after it
+	static FDlgRandomWalkResult Walk(UDlgContext& Context, UDlgDialogue* Dialogue, const TMap<FGameplayTag, UObject*>& Participants, FRandomStream& Random, int32 MaxSteps);
+};
+
+
+/**
+ * Common setup of the runtime tests: the dialogue to test with and an empty global memory (FDlgMemory).
+ * The random selectors and the visited nodes live in the global memory, so each run starts from the same state.
+ * The previous global memory is restored when the scope ends.
+ */
+class DLGSYSTEM_API FDlgTestDialogueScope
+{
+public:
+	// Generates the dialogue from the Options
+	explicit FDlgTestDialogueScope(const FDlgSyntheticDialogueOptions& Options);
+
+	// Uses an already built dialogue
+	explicit FDlgTestDialogueScope(UDlgDialogue* InDialogue);
+	~FDlgTestDialogueScope();
+
+	FDlgTestDialogueScope(const FDlgTestDialogueScope&) = delete;
+	FDlgTestDialogueScope& operator=(const FDlgTestDialogueScope&) = delete;
+
+	UDlgDialogue* GetDialogue() const { return Dialogue; }
+
+	// Empties the global memory, call it between the runs that are compared
+	void ResetMemory() const;
+
+	// A new context that is not started yet, the options are evaluated right away unless bTimeSlice
+	UDlgContext* NewContext(bool bTimeSlice = false) const;
+
+	// Participants for the dialogue, see FDlgSyntheticDialogue::CreateParticipants
+	TMap<FGameplayTag, UObject*> CreateParticipants(FRandomStream* Random = nullptr) const;
+
+private:
+	UDlgDialogue* Dialogue = nullptr;
+	TMap<FGuid, FDlgHistory> PreviousMemory;
+};
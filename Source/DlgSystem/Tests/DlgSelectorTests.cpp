@@ -0,0 +1,198 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Algo/Reverse.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgRuntimeBenchmarkTypes.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgMemory.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DlgSelectorTests
+{
+	static constexpr int32 SelectorIndex = 0;
+	static constexpr int32 NumOptions = 4;
+
+	// 0 Random selector -> 1, 2, 3, 4 Speech -> 0, each option of the speech nodes picks again
+	static UDlgDialogue* BuildDialogue(bool bCycle, bool bAvoidTwiceInARow)
+	{
+		FDlgTestDialogueBuilder Builder;
+		Builder.AddNode(UDlgNode_Selector::StaticClass(), {1, 2, 3, 4});
+		for (int32 Option = 0; Option < NumOptions; Option++)
+		{
+			Builder.AddNode(UDlgNode_Speech::StaticClass(), {SelectorIndex});
+		}
+
+		UDlgNode_Selector* Selector = CastChecked<UDlgNode_Selector>(Builder.GetNode(SelectorIndex));
+		Selector->SetSelectorType(EDlgNodeSelectorType::Random);
+		Selector->SetCycleThroughSatisfiedOptionsWithoutRepetition(bCycle);
+		Selector->SetAvoidPickingSameOptionTwiceInARow(bAvoidTwiceInARow);
+		return Builder.Finish(SelectorIndex);
+	}
+
+	// The speech nodes picked by the selector, the first one is picked by the start
+	static TArray<int32> Pick(const FDlgTestDialogueScope& Scope, int32 NumPicks, int32 Seed)
+	{
+		UDlgContext* Context = Scope.NewContext();
+		Context->SetRandomSeed(Seed);
+
+		TArray<int32> Picked;
+		bool bActive = Context->Start(Scope.GetDialogue(), Scope.CreateParticipants());
+		while (bActive)
+		{
+			Picked.Add(Context->GetActiveNodeIndex());
+			if (Picked.Num() >= NumPicks)
+			{
+				break;
+			}
+			bActive = Context->ChooseOption(0);
+		}
+		return Picked;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgSelectorCycleTest,
+	"DlgSystem.Runtime.Selector.Cycle",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgSelectorCycleTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgSelectorTests;
+	static constexpr int32 NumCycles = 5;
+
+	for (const bool bAvoidTwiceInARow : {false, true})
+	{
+		const FDlgTestDialogueScope Scope(BuildDialogue(true, bAvoidTwiceInARow));
+		const TArray<int32> Picked = Pick(Scope, NumOptions * NumCycles, 3);
+		TestEqual(TEXT("Picked every time"), Picked.Num(), NumOptions * NumCycles);
+
+		// Every cycle picks each option once
+		for (int32 Cycle = 0; Cycle < NumCycles; Cycle++)
+		{
+			TSet<int32> CyclePicks;
+			for (int32 Index = Cycle * NumOptions; Index < FMath::Min((Cycle + 1) * NumOptions, Picked.Num()); Index++)
+			{
+				CyclePicks.Add(Picked[Index]);
+			}
+			TestEqual(FString::Printf(TEXT("Cycle %d has no repetition"), Cycle), CyclePicks.Num(), NumOptions);
+		}
+
+		// Between two cycles only the avoid flag prevents a repetition, run it on the boundaries
+		if (bAvoidTwiceInARow)
+		{
+			for (int32 Index = 1; Index < Picked.Num(); Index++)
+			{
+				TestNotEqual(FString::Printf(TEXT("Cycle pick %d is not the previous one"), Index), Picked[Index], Picked[Index - 1]);
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgSelectorAvoidTwiceInARowTest,
+	"DlgSystem.Runtime.Selector.AvoidTwiceInARow",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgSelectorAvoidTwiceInARowTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgSelectorTests;
+	static constexpr int32 NumPicks = 100;
+
+	const FDlgTestDialogueScope Scope(BuildDialogue(false, true));
+	const TArray<int32> Picked = Pick(Scope, NumPicks, 11);
+	TestEqual(TEXT("Picked every time"), Picked.Num(), NumPicks);
+
+	TSet<int32> AllPicks(Picked);
+	TestEqual(TEXT("Every option is picked"), AllPicks.Num(), NumOptions);
+	for (int32 Index = 1; Index < Picked.Num(); Index++)
+	{
+		TestNotEqual(FString::Printf(TEXT("Pick %d is not the previous one"), Index), Picked[Index], Picked[Index - 1]);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgSelectorChildrenReorderedTest,
+	"DlgSystem.Runtime.Selector.ChildrenReordered",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgSelectorChildrenReorderedTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgSelectorTests;
+
+	const FDlgTestDialogueScope Scope(BuildDialogue(true, false));
+	UDlgDialogue* Dialogue = Scope.GetDialogue();
+	UDlgNode* Selector = Dialogue->GetMutableNodeFromIndex(SelectorIndex);
+	const FGuid SelectorGUID = Selector->GetGUID();
+	const auto CountPicked = [Dialogue, &SelectorGUID]()
+	{
+		const FDlgNodeSavedData& SavedData = FDlgMemory::Get().FindOrAddEntry(Dialogue->GetGUID()).GetNodeData(SelectorGUID);
+		int32 NumPicked = 0;
+		for (int32 EdgeIndex = 0; EdgeIndex < NumOptions; EdgeIndex++)
+		{
+			NumPicked += SavedData.IsEdgePicked(EdgeIndex) ? 1 : 0;
+		}
+		return NumPicked;
+	};
+
+	Pick(Scope, 2, 7);
+	TestEqual(TEXT("Two options picked in this cycle"), CountPicked(), 2);
+
+	// Same number of children, the bits would point to other nodes
+	TArray<FDlgEdge> Children = Selector->GetNodeChildren();
+	Algo::Reverse(Children);
+	Selector->SetNodeChildren(Children);
+
+	Pick(Scope, 1, 7);
+	TestEqual(TEXT("The cycle starts again after the children are reordered"), CountPicked(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgSelectorGUIDListMigrationTest,
+	"DlgSystem.Runtime.Selector.GUIDListMigration",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgSelectorGUIDListMigrationTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgSelectorTests;
+
+	const FDlgTestDialogueScope Scope(BuildDialogue(true, true));
+	const UDlgDialogue* Dialogue = Scope.GetDialogue();
+	const FGuid SelectorGUID = Dialogue->GetNodes()[SelectorIndex]->GetGUID();
+
+	// An old save where the nodes 1 and 3 were picked in this cycle, 3 last
+	FDlgMemory::Get().FindOrAddEntry(Dialogue->GetGUID()).GetNodeData(SelectorGUID).GUIDList = {
+		Dialogue->GetNodes()[1]->GetGUID(),
+		Dialogue->GetNodes()[3]->GetGUID()
+	};
+
+	// The rest of the cycle are the nodes 2 and 4, then the new cycle does not start with the node picked last
+	const TArray<int32> Picked = Pick(Scope, 3, 5);
+	TestEqual(TEXT("Picked every time"), Picked.Num(), 3);
+	if (Picked.Num() == 3)
+	{
+		TestTrue(TEXT("The cycle continues with the nodes not picked before"), TSet<int32>({Picked[0], Picked[1]}).Includes(TSet<int32>({2, 4})));
+		TestNotEqual(TEXT("The new cycle does not repeat the last pick"), Picked[2], Picked[1]);
+	}
+
+	const FDlgNodeSavedData& SavedData = FDlgMemory::Get().FindOrAddEntry(Dialogue->GetGUID()).GetNodeData(SelectorGUID);
+	TestEqual(TEXT("The GUID list is migrated"), SavedData.GUIDList.Num(), 0);
+	TestEqual(TEXT("The mask is made for the children"), SavedData.NumEdges, NumOptions);
+	TestEqual(TEXT("The last pick is remembered"), SavedData.LastPickedEdgeIndex, Picked.Num() == 3 ? Picked[2] - 1 : INDEX_NONE);
+	TestTrue(TEXT("The new cycle has the last pick"), Picked.Num() == 3 && SavedData.IsEdgePicked(Picked[2] - 1));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
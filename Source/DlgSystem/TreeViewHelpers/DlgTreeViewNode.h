@@ -69,6 +69,13 @@ public:
 			Child->SetParent(this->AsShared());
 		}
 	}
+	virtual void RemoveChild(const TSharedPtr<SelfType>& ChildNode)
+	{
+		if (Children.Remove(ChildNode) > 0)
+		{
+			ChildNode->ClearParent();
+		}
+	}
 	virtual void ClearChildren()
 	{
 		Children.Empty();
@@ -6,6 +6,7 @@
 #include "FileHelpers.h"
 #include "DlgSystem/DlgDialogue.h"
 #include "DlgSystem/DlgManager.h"
+#include "DlgSystemEditor/DlgEditorUtilities.h"
 
 
 class FDlgCommandletHelper
@@ -24,16 +25,10 @@ public:
 
 	static bool SaveAllDialogues()
 	{
-		TArray<UDlgDialogue*> Dialogues = UDlgManager::GetAllDialoguesFromMemory();
-		TArray<UPackage*> PackagesToSave;
-		for (UDlgDialogue* Dialogue : Dialogues)
+		return FDlgEditorUtilities::SaveDialogues(UDlgManager::GetAllDialoguesFromMemory(), [](const TArray<UPackage*>& PackagesToSave)
 		{
-			Dialogue->OnPreAssetSaved();
-			Dialogue->MarkPackageDirty();
-			PackagesToSave.Add(Dialogue->GetOutermost());
-		}
-
-		static constexpr bool bCheckDirty = false;
-		return UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, bCheckDirty);
+			static constexpr bool bCheckDirty = false;
+			return UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, bCheckDirty);
+		});
 	}
 };
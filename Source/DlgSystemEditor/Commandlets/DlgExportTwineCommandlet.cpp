@@ -15,6 +15,7 @@
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "UObject/Package.h"
 #include "FileHelpers.h"
+#include "Async/ParallelFor.h"
 
 #include "DlgSystem/DlgManager.h"
 #include "DlgSystem/Nodes/DlgNode_Speech.h"
@@ -67,6 +68,7 @@ int32 UDlgExportTwineCommandlet::Main(const FString& Params)
 	{
 		bFlatten = true;
 	}
+	bSingleThreaded = Switches.Contains(TEXT("SingleThreaded"));
 
 	// Set the output directory
 	const FString* OutputDirectoryVal = ParamVals.Find(FString(TEXT("OutputDirectory")));
@@ -105,7 +107,8 @@ int32 UDlgExportTwineCommandlet::Main(const FString& Params)
 	// Keep track of all created files so that we don't have duplicates
 	TSet<FString> CreateFiles;
 
-	// Export to twine
+	// Step 1. On the game thread, decide the file of each dialogue and gather everything that is not thread safe
+	TArray<FDlgTwineExportContext> Contexts;
 	const TArray<UDlgDialogue*> AllDialogues = UDlgManager::GetAllDialoguesFromMemory();
 	for (const UDlgDialogue* Dialogue : AllDialogues)
 	{
@@ -160,17 +163,15 @@ int32 UDlgExportTwineCommandlet::Main(const FString& Params)
 			FileSystemFilePath = FileSystemDirectoryPath / FileName + TEXT(".html");
 		}
 
-		// Compute minimum graph node positions
-		const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
-		MinimumGraphX = 0;
-		MinimumGraphY = 0;
+		FDlgTwineExportContext& Context = Contexts.AddDefaulted_GetRef();
+		Context.Dialogue = Dialogue;
+		Context.OriginalDialoguePath = OriginalDialoguePath;
+		Context.FileSystemFilePath = FileSystemFilePath;
 
+		// Compute minimum graph node positions
 		// TODO: multiple start nodes?
-		if (const UDialogueGraphNode* DialogueGraphNode = Cast<UDialogueGraphNode>(Dialogue->GetStartNodes()[0]->GetGraphNode()))
-		{
-			MinimumGraphX = FMath::Min(MinimumGraphX, DialogueGraphNode->NodePosX);
-			MinimumGraphY = FMath::Min(MinimumGraphY, DialogueGraphNode->NodePosY);
-		}
+		TArray<const UDlgNode*> Nodes(Dialogue->GetNodes());
+		Nodes.Add(Dialogue->GetStartNodes()[0]);
 		for (const UDlgNode* Node : Nodes)
 		{
 			const UDialogueGraphNode* DialogueGraphNode = Cast<UDialogueGraphNode>(Node->GetGraphNode());
@@ -179,39 +180,58 @@ int32 UDlgExportTwineCommandlet::Main(const FString& Params)
 				continue;
 			}
 
-			MinimumGraphX = FMath::Min(MinimumGraphX, DialogueGraphNode->NodePosX);
-			MinimumGraphY = FMath::Min(MinimumGraphY, DialogueGraphNode->NodePosY);
-		}
-		//UE_LOG(LogDlgExportTwineCommandlet, Verbose, TEXT("MinimumGraphX = %d, MinimumGraphY = %d"), MinimumGraphX, MinimumGraphY);
-
-		// TODO: multiple start nodes?
-
-		// Gather passages data
-		CurrentNodesAreas.Empty();
-		FString PassagesData;
-		PassagesData += CreateTwinePassageDataFromNode(*Dialogue, *Dialogue->GetStartNodes()[0], INDEX_NONE) + TEXT("\n");
+			Context.MinimumGraphX = FMath::Min(Context.MinimumGraphX, DialogueGraphNode->NodePosX);
+			Context.MinimumGraphY = FMath::Min(Context.MinimumGraphY, DialogueGraphNode->NodePosY);
 
-		// The rest of the nodes
-		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
-		{
-			PassagesData += CreateTwinePassageDataFromNode(*Dialogue, *Nodes[NodeIndex], NodeIndex) + TEXT("\n");
+			// TODO fix this
+			const TSharedPtr<SGraphNode> NodeWidget = DialogueGraphNode->GetNodeWidget();
+			if (NodeWidget.IsValid())
+			{
+				Context.NodeWidgetSizes.Add(Node, FIntPoint(NodeWidget->GetDesiredSize().X, NodeWidget->GetDesiredSize().Y));
+			}
 		}
+		//UE_LOG(LogDlgExportTwineCommandlet, Verbose, TEXT("MinimumGraphX = %d, MinimumGraphY = %d"), Context.MinimumGraphX, Context.MinimumGraphY);
+	}
 
-		// Export file
-		const FString TwineFileContent = CreateTwineStoryData(Dialogue->GetDialogueName(), Dialogue->GetGUID(), INDEX_NONE, PassagesData);
-		if (FFileHelper::SaveStringToFile(TwineFileContent, *FileSystemFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	// Step 2. Each dialogue is independent, build and write the files in parallel
+	const double StartTime = FPlatformTime::Seconds();
+	ParallelFor(Contexts.Num(), [this, &Contexts](int32 ContextIndex)
+	{
+		FDlgTwineExportContext& Context = Contexts[ContextIndex];
+		const FString TwineFileContent = CreateTwineStoryDataForDialogue(Context);
+		if (FFileHelper::SaveStringToFile(TwineFileContent, *Context.FileSystemFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
 		{
-			UE_LOG(LogDlgExportTwineCommandlet, Display, TEXT("Writing file = `%s` for Dialogue = `%s` "), *FileSystemFilePath, *OriginalDialoguePath);
+			UE_LOG(LogDlgExportTwineCommandlet, Display, TEXT("Writing file = `%s` for Dialogue = `%s` "), *Context.FileSystemFilePath, *Context.OriginalDialoguePath);
 		}
 		else
 		{
-			UE_LOG(LogDlgExportTwineCommandlet, Error, TEXT("FAILED to write file = `%s` for Dialogue = `%s`"), *FileSystemFilePath, *OriginalDialoguePath);
+			UE_LOG(LogDlgExportTwineCommandlet, Error, TEXT("FAILED to write file = `%s` for Dialogue = `%s`"), *Context.FileSystemFilePath, *Context.OriginalDialoguePath);
 		}
-	}
+	}, bSingleThreaded);
+	UE_LOG(LogDlgExportTwineCommandlet, Display, TEXT("Exported %d Dialogues in %.3f seconds"), Contexts.Num(), FPlatformTime::Seconds() - StartTime);
 
 	return 0;
 }
 
+FString UDlgExportTwineCommandlet::CreateTwineStoryDataForDialogue(FDlgTwineExportContext& Context)
+{
+	const UDlgDialogue& Dialogue = *Context.Dialogue;
+	const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+
+	// Gather passages data
+	// TODO: multiple start nodes?
+	FString PassagesData;
+	PassagesData += CreateTwinePassageDataFromNode(Context, Dialogue, *Dialogue.GetStartNodes()[0], INDEX_NONE) + TEXT("\n");
+
+	// The rest of the nodes
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		PassagesData += CreateTwinePassageDataFromNode(Context, Dialogue, *Nodes[NodeIndex], NodeIndex) + TEXT("\n");
+	}
+
+	return CreateTwineStoryData(Dialogue.GetDialogueName(), Dialogue.GetGUID(), INDEX_NONE, PassagesData);
+}
+
 
 FString UDlgExportTwineCommandlet::CreateTwineStoryData(const FString& Name, const FGuid& DialogueGUID, int32 StartNodeIndex, const FString& PassagesData)
 {
@@ -245,45 +265,71 @@ FString UDlgExportTwineCommandlet::CreateTwineStoryData(const FString& Name, con
 	);
 }
 
-bool UDlgExportTwineCommandlet::GetBoxThatConflicts(const FBox2D& Box, FBox2D& OutConflict)
+bool FDlgTwinePlacementGrid::FindConflict(const FBox2D& Box, FBox2D& OutConflict) const
 {
-	for (const FBox2D& CurrentBox : CurrentNodesAreas)
+	bool bFound = false;
+	const FIntPoint MinCell = GetCell(Box.Min);
+	const FIntPoint MaxCell = GetCell(Box.Max);
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
 	{
-		if (CurrentBox.Intersect(Box))
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
 		{
-			OutConflict = CurrentBox;
-			return true;
+			const TArray<int32>* BoxIndices = Cells.Find(FIntPoint(CellX, CellY));
+			if (BoxIndices == nullptr)
+			{
+				continue;
+			}
+
+			for (const int32 BoxIndex : *BoxIndices)
+			{
+				const FBox2D& CurrentBox = Boxes[BoxIndex];
+				if (CurrentBox.Intersect(Box) && (!bFound || CurrentBox.Max.Y > OutConflict.Max.Y))
+				{
+					OutConflict = CurrentBox;
+					bFound = true;
+				}
+			}
 		}
 	}
 
-	return false;
+	return bFound;
 }
 
-FIntPoint UDlgExportTwineCommandlet::GetNonConflictingPointFor(const FIntPoint& Point, const FIntPoint& Size, const FIntPoint& Padding)
+void FDlgTwinePlacementGrid::Add(const FBox2D& Box)
+{
+	const int32 BoxIndex = Boxes.Add(Box);
+	const FIntPoint MinCell = GetCell(Box.Min);
+	const FIntPoint MaxCell = GetCell(Box.Max);
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+		{
+			Cells.FindOrAdd(FIntPoint(CellX, CellY)).Add(BoxIndex);
+		}
+	}
+}
+
+FIntPoint FDlgTwinePlacementGrid::GetNonConflictingPointFor(const FIntPoint& Point, const FIntPoint& Size, const FIntPoint& Padding)
 {
 	FVector2D MinVector(Point + Padding);
 	FVector2D MaxVector(MinVector + Size);
 	FBox2D NewBox(MinVector, MaxVector);
 
 	FBox2D ConflictBox;
-	while (GetBoxThatConflicts(NewBox, ConflictBox))
+	while (FindConflict(NewBox, ConflictBox))
 	{
 		//UE_LOG(LogDlgExportTwineCommandlet, Warning, TEXT("Found conflict in rectangle: %s for Point: %s"), *ConflictRect.ToString(), *NewPoint.ToString());
-		// Assume the curent box is a child, adjust
-		FVector2D Center, Extent;
-		ConflictBox.GetCenterAndExtents(Center, Extent);
-
-		// Update on vertical
-		MinVector.Y += Extent.Y / 2.f;
+		// Every position above the bottom of the conflict box still overlaps it (touching counts as overlapping), go right under it
+		MinVector.Y = ConflictBox.Max.Y + 1.f;
 		MaxVector = MinVector + Size;
 		NewBox = FBox2D(MinVector, MaxVector);
 	}
 
-	CurrentNodesAreas.Add(NewBox);
+	Add(NewBox);
 	return MinVector.IntPoint();
 }
 
-FString UDlgExportTwineCommandlet::CreateTwinePassageDataFromNode(const UDlgDialogue& Dialogue, const UDlgNode& Node, int32 NodeIndex)
+FString UDlgExportTwineCommandlet::CreateTwinePassageDataFromNode(FDlgTwineExportContext& Context, const UDlgDialogue& Dialogue, const UDlgNode& Node, int32 NodeIndex)
 {
 	const UDialogueGraphNode* DialogueGraphNode = Cast<UDialogueGraphNode>(Node.GetGraphNode());
 	if (DialogueGraphNode == nullptr)
@@ -295,15 +341,10 @@ FString UDlgExportTwineCommandlet::CreateTwinePassageDataFromNode(const UDlgDial
 
 	const FString NodeName = GetNodeNameFromNode(Node, NodeIndex, bIsRootNode);
 	FString Tags;
-	FIntPoint Position = GraphNodeToTwineCanvas(DialogueGraphNode->NodePosX, DialogueGraphNode->NodePosY);
+	FIntPoint Position = Context.GraphNodeToTwineCanvas(DialogueGraphNode->NodePosX, DialogueGraphNode->NodePosY);
 
-	// TODO fix this
-	TSharedPtr<SGraphNode> NodeWidget = DialogueGraphNode->GetNodeWidget();
-	FIntPoint Size = SizeLarge;
-	if (NodeWidget.IsValid())
-	{
-		Size = FIntPoint(NodeWidget->GetDesiredSize().X, NodeWidget->GetDesiredSize().Y);
-	}
+	const FIntPoint* NodeWidgetSize = Context.NodeWidgetSizes.Find(&Node);
+	FIntPoint Size = NodeWidgetSize ? *NodeWidgetSize : SizeLarge;
 
 	FString NodeContent;
 	const FIntPoint Padding(20, 20);
@@ -312,7 +353,7 @@ FString UDlgExportTwineCommandlet::CreateTwinePassageDataFromNode(const UDlgDial
 		verify(NodeIndex == INDEX_NONE);
 		Tags += TagNodeStart;
 		Size = SizeSmall;
-		Position = GetNonConflictingPointFor(Position, Size, Padding);
+		Position = Context.PlacedNodes.GetNonConflictingPointFor(Position, Size, Padding);
 
 		NodeContent += CreateTwinePassageDataLinksFromEdges(Dialogue, Node.GetNodeChildren());
 		return CreateTwinePassageData(NodeIndex, NodeName, Tags, Position, Size, NodeContent);
@@ -323,8 +364,7 @@ FString UDlgExportTwineCommandlet::CreateTwinePassageDataFromNode(const UDlgDial
 	{
 		// Edges from this node do not matter
 		Tags += TagNodeVirtualParent;
-		Position = GetNonConflictingPointFor(Position, Size, Padding);
-		//CurrentNodesAreas.Add(FIntRect(Position + Padding, Position + Size + Padding));
+		Position = Context.PlacedNodes.GetNonConflictingPointFor(Position, Size, Padding);
 
 		const UDlgNode_Speech& NodeSpeech = DialogueGraphNode->GetDialogueNode<UDlgNode_Speech>();
 		NodeContent += EscapeHtml(NodeSpeech.GetNodeUnformattedText().ToString());
@@ -334,8 +374,7 @@ FString UDlgExportTwineCommandlet::CreateTwinePassageDataFromNode(const UDlgDial
 	if (DialogueGraphNode->IsSpeechNode())
 	{
 		Tags += TagNodeSpeech;
-		Position = GetNonConflictingPointFor(Position, Size, Padding);
-		//CurrentNodesAreas.Add(FIntRect(Position + Padding, Position + Size + Padding));
+		Position = Context.PlacedNodes.GetNonConflictingPointFor(Position, Size, Padding);
 
 		const UDlgNode_Speech& NodeSpeech = DialogueGraphNode->GetDialogueNode<UDlgNode_Speech>();
 		NodeContent += EscapeHtml(NodeSpeech.GetNodeUnformattedText().ToString());
@@ -347,8 +386,7 @@ FString UDlgExportTwineCommandlet::CreateTwinePassageDataFromNode(const UDlgDial
 		// Does not have any children/text
 		Tags += TagNodeEnd;
 		Size = SizeSmall;
-		Position = GetNonConflictingPointFor(Position, Size, Padding);
-		//CurrentNodesAreas.Add(FIntRect(Position + Padding, Position + Size + Padding));
+		Position = Context.PlacedNodes.GetNonConflictingPointFor(Position, Size, Padding);
 
 		NodeContent += TEXT("END");
 		return CreateTwinePassageData(NodeIndex, NodeName, Tags, Position, Size, NodeContent);
@@ -365,7 +403,7 @@ FString UDlgExportTwineCommandlet::CreateTwinePassageDataFromNode(const UDlgDial
 			Tags += TagNodeSelectorRandom;
 		}
 		Size = SizeSmall;
-		Position = GetNonConflictingPointFor(Position, Size, Padding);
+		Position = Context.PlacedNodes.GetNonConflictingPointFor(Position, Size, Padding);
 
 		NodeContent += TEXT("SELECTOR\n");
 		NodeContent += CreateTwinePassageDataLinksFromEdges(Dialogue, Node.GetNodeChildren(), true);
@@ -374,7 +412,7 @@ FString UDlgExportTwineCommandlet::CreateTwinePassageDataFromNode(const UDlgDial
 	if (DialogueGraphNode->IsSpeechSequenceNode())
 	{
 		Tags += TagNodeSpeechSequence;
-		Position = GetNonConflictingPointFor(Position, Size, Padding);
+		Position = Context.PlacedNodes.GetNonConflictingPointFor(Position, Size, Padding);
 
 		const UDlgNode_SpeechSequence& NodeSpeechSequence = DialogueGraphNode->GetDialogueNode<UDlgNode_SpeechSequence>();
 
@@ -14,6 +14,67 @@ class UDialogueGraphNode;
 struct FDlgEdge;
 
 
+/**
+ * Uniform grid of the passages already placed in a Twine story.
+ * Finding the overlaps of a new passage only looks at the passages from the cells it touches instead of at all of them.
+ */
+class FDlgTwinePlacementGrid
+{
+public:
+	/** Finds a placed box that intersects Box, if there are more returns the one that reaches the lowest. */
+	bool FindConflict(const FBox2D& Box, FBox2D& OutConflict) const;
+
+	void Add(const FBox2D& Box);
+
+	/**
+	 * Moves the passage down until it does not overlap any placed passage, then places it.
+	 * Each conflict moves the passage right under the conflicting box, the lowest position that can be free.
+	 */
+	FIntPoint GetNonConflictingPointFor(const FIntPoint& Point, const FIntPoint& Size, const FIntPoint& Padding);
+
+private:
+	static FIntPoint GetCell(const FVector2D& Position)
+	{
+		return FIntPoint(FMath::FloorToInt(Position.X / CellSize), FMath::FloorToInt(Position.Y / CellSize));
+	}
+
+private:
+	// Around the size of a large passage
+	static constexpr float CellSize = 200.f;
+
+	TArray<FBox2D> Boxes;
+
+	// Key: Cell
+	// Value: indices in Boxes of the boxes that touch the cell
+	TMap<FIntPoint, TArray<int32>> Cells;
+};
+
+/** The state of exporting one Dialogue, the dialogues are exported in parallel. */
+struct FDlgTwineExportContext
+{
+	const UDlgDialogue* Dialogue = nullptr;
+	FString OriginalDialoguePath;
+	FString FileSystemFilePath;
+
+	// used to compute the proper size
+	int32 MinimumGraphX = 0;
+	int32 MinimumGraphY = 0;
+
+	// The desired size of the graph node widgets that exist, gathered on the game thread
+	TMap<const UDlgNode*, FIntPoint> NodeWidgetSizes;
+
+	// Stop overlapping nodes
+	FDlgTwinePlacementGrid PlacedNodes;
+
+	FORCEINLINE FIntPoint GraphNodeToTwineCanvas(int32 PositionX, int32 PositionY) const
+	{
+		// Twine Graph canvas always starts from 0,0 - there is not negative position
+		const int32 NewX = FMath::Abs(MinimumGraphX) + PositionX;
+		const int32 NewY = FMath::Abs(MinimumGraphY) + PositionY;
+		return FIntPoint(NewX, NewY);
+	}
+};
+
 UCLASS()
 class UDlgExportTwineCommandlet : public UCommandlet
 {
@@ -29,24 +90,16 @@ public:
 
 	FString CreateTwineStoryData(const FString& Name, const FGuid& DialogueGuid, int32 StartNodeIndex, const FString& PassagesData);
 
-	FString CreateTwinePassageDataFromNode(const UDlgDialogue& Dialogue, const UDlgNode& Node, int32 NodeIndex);
+	// Builds the file content of the Dialogue, thread safe
+	FString CreateTwineStoryDataForDialogue(FDlgTwineExportContext& Context);
+
+	FString CreateTwinePassageDataFromNode(FDlgTwineExportContext& Context, const UDlgDialogue& Dialogue, const UDlgNode& Node, int32 NodeIndex);
 	FString CreateTwinePassageDataLinksFromEdges(const UDlgDialogue& Dialogue, const TArray<FDlgEdge>& Edges, bool bNoTextOnEdges = false);
 
 	FString CreateTwinePassageData(int32 Pid, const FString& Name, const FString& Tags, const FIntPoint& Position, const FIntPoint& Size, const FString& Content);
 
 	FString CreateTwineCustomCss();
 
-	FORCEINLINE FIntPoint GraphNodeToTwineCanvas(int32 PositionX, int32 PositionY)
-	{
-		// Twine Graph canvas always starts from 0,0 - there is not negative position
-		const int32 NewX = FMath::Abs(MinimumGraphX) + PositionX;
-		const int32 NewY = FMath::Abs(MinimumGraphY) + PositionY;
-		return FIntPoint(NewX, NewY);
-	}
-
-	bool GetBoxThatConflicts(const FBox2D& Box, FBox2D& OutConflict);
-	FIntPoint GetNonConflictingPointFor(const FIntPoint& InPoint, const FIntPoint& Size, const FIntPoint& Padding);
-
 	static FString CreateTwineTagColorsData();
 
 	FString GetNodeNameFromNode(const UDlgNode& Node, int32 NodeIndex, bool bIsRootNode = false);
@@ -81,12 +134,8 @@ protected:
 	// Flatten files to the same directory
 	bool bFlatten = false;
 
-	// used to compute the proper size
-	int32 MinimumGraphX = 0;
-	int32 MinimumGraphY = 0;
-
-	// Stop overlapping nodes
-	TArray<FBox2D> CurrentNodesAreas;
+	// Export the dialogues one by one on the game thread
+	bool bSingleThreaded = false;
 
 	// Maps from:
 	// Key: NodeTagName
@@ -13,6 +13,7 @@
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "UObject/Package.h"
 #include "FileHelpers.h"
+#include "Misc/FileHelper.h"
 
 #include "DlgSystem/DlgManager.h"
 #include "DlgSystem/Nodes/DlgNode_Speech.h"
@@ -78,6 +79,8 @@ int32 UDlgHumanReadableTextCommandlet::Main(const FString& Params)
 		bSaveAllDialogues = false;
 	}
 
+	bForce = Switches.Contains(TEXT("Force"));
+
 	if (Switches.Contains(TEXT("Export")))
 	{
 		bExport = true;
@@ -156,6 +159,14 @@ int32 UDlgHumanReadableTextCommandlet::Export()
 		JsonWriter.Write(FDlgDialogue_FormatHumanReadable::StaticStruct(), &ExportFormat);
 
 		const FString FileSystemFilePath = FileSystemDirectoryPath / FileName + FileExtension;
+
+		// Do not touch the file if it already has this content
+		if (!bForce && IsFileContentEqual(FileSystemFilePath, JsonWriter.GetContentHash()))
+		{
+			UE_LOG(LogDlgHumanReadableTextCommandlet, Display, TEXT("Skipping file = `%s` for Dialogue = `%s`, the content did not change"), *FileSystemFilePath, *OriginalDialoguePath);
+			continue;
+		}
+
 		if (JsonWriter.ExportToFile(FileSystemFilePath))
 		{
 			UE_LOG(LogDlgHumanReadableTextCommandlet, Display, TEXT("Writing file = `%s` for Dialogue = `%s` "), *FileSystemFilePath, *OriginalDialoguePath);
@@ -190,8 +201,12 @@ int32 UDlgHumanReadableTextCommandlet::Import()
 	{
 		UE_LOG(LogDlgHumanReadableTextCommandlet, Display, TEXT("Reading file = `%s` "), *File);
 
+		FString FileText;
 		FDlgJsonParser JsonParser;
-		JsonParser.InitializeParser(File);
+		if (FFileHelper::LoadFileToString(FileText, *File))
+		{
+			JsonParser.InitializeParserFromString(FileText);
+		}
 		if (!JsonParser.IsValidFile())
 		{
 			UE_LOG(LogDlgHumanReadableTextCommandlet, Error, TEXT("FAILED to read file = `%s`"), *File);
@@ -218,8 +233,21 @@ int32 UDlgHumanReadableTextCommandlet::Import()
 			continue;
 		}
 
-		// Import
+		// Nothing was edited since the export, do not import and save the Dialogue again
 		UDlgDialogue* Dialogue = *DialoguePtr;
+		FDlgDialogue_FormatHumanReadable CurrentFormat;
+		if (!bForce && ExportDialogueToHumanReadableFormat(*Dialogue, CurrentFormat))
+		{
+			FDlgJsonWriter JsonWriter;
+			JsonWriter.Write(FDlgDialogue_FormatHumanReadable::StaticStruct(), &CurrentFormat);
+			if (JsonWriter.GetContentHash() == IDlgWriter::HashText(FileText))
+			{
+				UE_LOG(LogDlgHumanReadableTextCommandlet, Display, TEXT("Skipping file = `%s`, the Dialogue already has this content"), *File);
+				continue;
+			}
+		}
+
+		// Import
 		if (ImportHumanReadableFormatIntoDialogue(HumanFormat, Dialogue))
 		{
 			PackagesToSave.Add(Dialogue->GetOutermost());
@@ -229,6 +257,17 @@ int32 UDlgHumanReadableTextCommandlet::Import()
 	return UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false) == true ? 0 : -1;
 }
 
+bool UDlgHumanReadableTextCommandlet::IsFileContentEqual(const FString& FilePath, uint64 ContentHash)
+{
+	FString FileText;
+	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*FilePath) || !FFileHelper::LoadFileToString(FileText, *FilePath))
+	{
+		return false;
+	}
+
+	return IDlgWriter::HashText(FileText) == ContentHash;
+}
+
 bool UDlgHumanReadableTextCommandlet::ExportDialogueToHumanReadableFormat(const UDlgDialogue& Dialogue, FDlgDialogue_FormatHumanReadable& OutFormat)
 {
 	OutFormat.DialogueName = Dialogue.GetDialogueFName();
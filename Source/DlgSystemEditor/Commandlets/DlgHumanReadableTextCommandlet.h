@@ -180,6 +180,9 @@ protected:
 
 	static bool ExportNodeToContext(const UDlgNode* Node, FDlgNodeContext_FormatHumanReadable& OutContext);
 	static void ExportNodeEdgesToHumanReadableFormat(const TArray<FDlgEdge>& Edges, TArray<FDlgEdge_FormatHumanReadable>& OutEdges);
+	// Does the file at FilePath exist and have the content with ContentHash (see IDlgWriter::GetContentHash)
+	static bool IsFileContentEqual(const FString& FilePath, uint64 ContentHash);
+
 	static bool SetGraphNodesNewEdgesText(UDialogueGraphNode* GraphNode, const TArray<FDlgEdge_FormatHumanReadable>& Edges, int32 NodeIndex, const UDlgDialogue* Dialogue);
 
 protected:
@@ -189,6 +192,9 @@ protected:
 	const UDlgSystemSettings* Settings = nullptr;
 
 	bool bSaveAllDialogues = false;
+
+	// Export/Import even the files whose content did not change
+	bool bForce = false;
 	bool bExport = false;
 	bool bImport = false;
 
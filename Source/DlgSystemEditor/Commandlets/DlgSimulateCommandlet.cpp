@@ -0,0 +1,401 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgSimulateCommandlet.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+#include "DlgSystem/DlgConditionCustom.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgEventCustom.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgMemory.h"
+#include "DlgSystem/DlgSystemSettings.h"
+#include "DlgSystem/DlgTextArgumentCustom.h"
+#include "DlgSystem/IO/DlgJsonParser.h"
+#include "DlgSystem/Logging/DlgLogger.h"
+#include "DlgSystem/Nodes/DlgNode_Proxy.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+
+
+DEFINE_LOG_CATEGORY(LogDlgSimulateCommandlet);
+
+UDlgSimulateCommandlet::UDlgSimulateCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UDlgSimulateCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogDlgSimulateCommandlet, Display, TEXT("Starting"));
+
+	// Parse command line - we're interested in the param vals
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	if (const FString* FixtureVal = ParamVals.Find(FString(TEXT("Fixture"))))
+	{
+		if (!LoadFixture(*FixtureVal))
+		{
+			return -1;
+		}
+	}
+	if (const FString* Val = ParamVals.Find(FString(TEXT("ConditionTrueChance"))))
+	{
+		Fixture.ConditionTrueChance = FCString::Atof(**Val);
+	}
+	if (const FString* Val = ParamVals.Find(FString(TEXT("Walks"))))
+	{
+		NumWalks = FMath::Max(1, FCString::Atoi(**Val));
+	}
+	if (const FString* Val = ParamVals.Find(FString(TEXT("MaxSteps"))))
+	{
+		MaxSteps = FMath::Max(1, FCString::Atoi(**Val));
+	}
+	if (const FString* Val = ParamVals.Find(FString(TEXT("Seed"))))
+	{
+		Seed = FCString::Atoi(**Val);
+	}
+	if (const FString* Val = ParamVals.Find(FString(TEXT("MinCoverage"))))
+	{
+		MinCoverage = FMath::Clamp(FCString::Atof(**Val), 0.f, 1.f);
+	}
+	if (const FString* Val = ParamVals.Find(FString(TEXT("MinStepsPerSecond"))))
+	{
+		MinStepsPerSecond = FCString::Atod(**Val);
+	}
+	bFailOnDeadEnds = Switches.Contains(TEXT("FailOnDeadEnds"));
+	const bool bSingleThreaded = Switches.Contains(TEXT("SingleThreaded"));
+
+	UDlgManager::LoadAllDialoguesIntoMemory();
+
+	// Filter the dialogues same as the editor batch operations
+	const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
+	const bool bOnlyInGameDialogues = Settings->bBatchOnlyInGameDialogues && !Switches.Contains(TEXT("AllDialogues"));
+	TArray<UDlgDialogue*> Dialogues;
+	for (UDlgDialogue* Dialogue : UDlgManager::GetAllDialoguesFromMemory())
+	{
+		if (bOnlyInGameDialogues && !Dialogue->IsInProjectDirectory())
+		{
+			continue;
+		}
+		Dialogues.Add(Dialogue);
+	}
+	UE_LOG(
+		LogDlgSimulateCommandlet, Display,
+		TEXT("Simulating %d Dialogues, Walks = %d, MaxSteps = %d, Seed = %d, ConditionTrueChance = %.2f, Fixture Participants = %d"),
+		Dialogues.Num(), NumWalks, MaxSteps, Seed, Fixture.ConditionTrueChance, Fixture.Participants.Num()
+	);
+
+	// The walks change the global dialogue memory, put it back at the end
+	const TMap<FGuid, FDlgHistory> PreviousMemory = FDlgMemory::Get().GetHistoryMaps();
+	FDlgMemory::Get().Empty();
+
+	// Step 1. Create the contexts, participants and memory entries on the game thread.
+	// The tasks must not move after this, the participants point to the random stream of their task
+	TArray<FDlgSimulationTask> Tasks;
+	Tasks.SetNum(Dialogues.Num());
+	TSet<FGuid> DialogueGUIDs;
+	for (int32 DialogueIndex = 0; DialogueIndex < Dialogues.Num(); DialogueIndex++)
+	{
+		FDlgSimulationTask& Task = Tasks[DialogueIndex];
+		CreateTask(Task, Dialogues[DialogueIndex]);
+
+		// Dialogues with the same GUID share the memory entry
+		bool bIsDuplicateGUID = false;
+		DialogueGUIDs.Add(Task.Dialogue->GetGUID(), &bIsDuplicateGUID);
+		Task.bCanWalkInParallel &= !bIsDuplicateGUID;
+	}
+
+	// Only after all the entries exist, adding an entry can move the others
+	for (FDlgSimulationTask& Task : Tasks)
+	{
+		Task.Memory = FDlgMemory::Get().GetEntry(Task.Dialogue->GetGUID());
+	}
+
+	// The runtime errors are expected (that is what we are looking for), only send them to the output log which is thread safe
+	FDlgLogger::Get().OnlyEnableOutputLog();
+
+	// Step 2. Each dialogue is independent, walk them in parallel, the rest on the game thread after
+	const double StartTime = FPlatformTime::Seconds();
+	ParallelFor(Tasks.Num(), [this, &Tasks](int32 TaskIndex)
+	{
+		if (Tasks[TaskIndex].bCanWalkInParallel)
+		{
+			WalkTask(Tasks[TaskIndex]);
+		}
+	}, bSingleThreaded);
+	for (FDlgSimulationTask& Task : Tasks)
+	{
+		if (!Task.bCanWalkInParallel)
+		{
+			WalkTask(Task);
+		}
+	}
+	const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+	FDlgLogger::Get().SyncWithSettings();
+	FDlgMemory::Get().SetHistoryMap(PreviousMemory);
+
+	return Report(Tasks, WallSeconds) ? 0 : -1;
+}
+
+bool UDlgSimulateCommandlet::LoadFixture(const FString& FilePath)
+{
+	FDlgJsonParser Parser(FilePath);
+	if (!Parser.IsValidFile())
+	{
+		UE_LOG(LogDlgSimulateCommandlet, Error, TEXT("Invalid -Fixture = `%s`, the file does not exist or is not valid JSON"), *FilePath);
+		return false;
+	}
+
+	Parser.ReadAllProperty(FDlgSimulationFixture::StaticStruct(), &Fixture);
+	UE_LOG(LogDlgSimulateCommandlet, Display, TEXT("Loaded Fixture = `%s`"), *FilePath);
+	return true;
+}
+
+void UDlgSimulateCommandlet::CreateTask(FDlgSimulationTask& Task, UDlgDialogue* Dialogue)
+{
+	Task.Dialogue = Dialogue;
+	Task.Context = NewObject<UDlgContext>(GetTransientPackage(), NAME_None, RF_Transient);
+	Task.Context->SetPrefetchReachableNodes(false);
+	FDlgMemory::Get().FindOrAddEntry(Dialogue->GetGUID());
+	// From the GUID so that the walks of a dialogue do not change when other dialogues are added or removed
+	Task.Random.Initialize(static_cast<int32>(HashCombine(GetTypeHash(Seed), GetTypeHash(Dialogue->GetGUID()))));
+	Task.bCanWalkInParallel = CanWalkInParallel(*Dialogue);
+	Task.VisitedNodes.Init(false, Dialogue->GetNodes().Num());
+	Task.SelectorLoops = FindSelectorLoops(*Dialogue);
+
+	Task.Participants = FDlgSyntheticDialogue::CreateParticipants(*Dialogue, &Task.Random);
+	for (const auto& KeyValue : Task.Participants)
+	{
+		UDlgBenchmarkParticipant* Participant = CastChecked<UDlgBenchmarkParticipant>(KeyValue.Value);
+		Participant->Setup(KeyValue.Key, &Task.Random, Fixture.ConditionTrueChance);
+		if (const FDlgParticipantFixture* ParticipantFixture = Fixture.Participants.Find(KeyValue.Key.GetTagName()))
+		{
+			Participant->SetFixture(*ParticipantFixture);
+		}
+	}
+}
+
+void UDlgSimulateCommandlet::WalkTask(FDlgSimulationTask& Task) const
+{
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 WalkIndex = 0; WalkIndex < NumWalks; WalkIndex++)
+	{
+		// Every walk is a new playthrough
+		*Task.Memory = {};
+		FDlgMemory::Get().MarkDirty(Task.Dialogue->GetGUID());
+		Task.Context->ClearHistoryOfThisContext();
+		for (const auto& KeyValue : Task.Participants)
+		{
+			CastChecked<UDlgBenchmarkParticipant>(KeyValue.Value)->ResetValues();
+		}
+
+		const FDlgRandomWalkResult Walk = FDlgRandomWalk::Walk(*Task.Context, Task.Dialogue, Task.Participants, Task.Random, MaxSteps);
+		Task.Walks += Walk;
+
+		for (const int32 NodeIndex : Task.Context->GetVisitedNodeIndices())
+		{
+			if (Task.VisitedNodes.IsValidIndex(NodeIndex))
+			{
+				Task.VisitedNodes[NodeIndex] = true;
+			}
+		}
+		if (Walk.NumDeadEnds > 0)
+		{
+			Task.DeadEndNodes.FindOrAdd(Task.Context->GetActiveNodeIndex())++;
+		}
+	}
+	Task.Seconds = FPlatformTime::Seconds() - StartTime;
+}
+
+bool UDlgSimulateCommandlet::Report(const TArray<FDlgSimulationTask>& Tasks, double WallSeconds) const
+{
+	bool bSuccess = true;
+	FDlgRandomWalkResult TotalWalks;
+	double TotalSeconds = 0.0;
+	int32 TotalNodes = 0;
+	int32 TotalVisitedNodes = 0;
+	int32 TotalSelectorLoops = 0;
+
+	for (const FDlgSimulationTask& Task : Tasks)
+	{
+		TotalWalks += Task.Walks;
+		TotalSeconds += Task.Seconds;
+		TotalNodes += Task.VisitedNodes.Num();
+		TotalVisitedNodes += Task.GetNumVisitedNodes();
+		TotalSelectorLoops += Task.SelectorLoops.Num();
+
+		const FString DialoguePath = Task.Dialogue->GetPathName();
+		UE_LOG(
+			LogDlgSimulateCommandlet, Display,
+			TEXT("Dialogue = `%s`: Coverage = %.1f%% (%d/%d nodes), Walks = %d (Ended = %d, Dead Ends = %d, Max Steps = %d, Failed To Start = %d), %.0f steps/s%s"),
+			*DialoguePath, Task.GetCoverage() * 100.f, Task.GetNumVisitedNodes(), Task.VisitedNodes.Num(),
+			Task.Walks.NumWalks, Task.Walks.NumEnded, Task.Walks.NumDeadEnds, Task.Walks.NumMaxStepsReached, Task.Walks.NumFailedToStart,
+			Task.GetStepsPerSecond(), Task.bCanWalkInParallel ? TEXT("") : TEXT(" (game thread)")
+		);
+
+		for (const TArray<int32>& Loop : Task.SelectorLoops)
+		{
+			FString LoopString;
+			for (const int32 NodeIndex : Loop)
+			{
+				LoopString += FString::Printf(TEXT("%d -> "), NodeIndex);
+			}
+			LoopString += FString::FromInt(Loop[0]);
+			UE_LOG(LogDlgSimulateCommandlet, Error, TEXT("Dialogue = `%s` has a selector/proxy loop: %s"), *DialoguePath, *LoopString);
+			bSuccess = false;
+		}
+
+		for (const auto& KeyValue : Task.DeadEndNodes)
+		{
+			UE_LOG(
+				LogDlgSimulateCommandlet, Warning, TEXT("Dialogue = `%s`: %d walks got stuck on node index %d"),
+				*DialoguePath, KeyValue.Value, KeyValue.Key
+			);
+		}
+		if (bFailOnDeadEnds && Task.Walks.NumDeadEnds > 0)
+		{
+			UE_LOG(LogDlgSimulateCommandlet, Error, TEXT("Dialogue = `%s` has dead ends"), *DialoguePath);
+			bSuccess = false;
+		}
+
+		if (Task.GetCoverage() < 1.f)
+		{
+			FString UnvisitedString;
+			for (int32 NodeIndex = 0; NodeIndex < Task.VisitedNodes.Num(); NodeIndex++)
+			{
+				if (!Task.VisitedNodes[NodeIndex])
+				{
+					UnvisitedString += UnvisitedString.IsEmpty() ? FString::FromInt(NodeIndex) : FString::Printf(TEXT(", %d"), NodeIndex);
+				}
+			}
+			UE_LOG(LogDlgSimulateCommandlet, Display, TEXT("Dialogue = `%s` never reached the node indices: %s"), *DialoguePath, *UnvisitedString);
+		}
+		if (Task.GetCoverage() < MinCoverage)
+		{
+			UE_LOG(
+				LogDlgSimulateCommandlet, Error, TEXT("Dialogue = `%s` Coverage = %.1f%% is below -MinCoverage = %.1f%%"),
+				*DialoguePath, Task.GetCoverage() * 100.f, MinCoverage * 100.f
+			);
+			bSuccess = false;
+		}
+	}
+
+	// Steps per second of one thread, the wall time one depends on the number of cores
+	const double StepsPerSecond = TotalSeconds > 0.0 ? TotalWalks.NumSteps / TotalSeconds : 0.0;
+	UE_LOG(
+		LogDlgSimulateCommandlet, Display,
+		TEXT("Finished: Dialogues = %d, Coverage = %.1f%% (%d/%d nodes), Selector Loops = %d, Walks = %d (Ended = %d, Dead Ends = %d, Max Steps = %d, Failed To Start = %d), ")
+		TEXT("Steps = %lld, %.0f steps/s per thread, %.0f steps/s wall, Time = %.3f seconds"),
+		Tasks.Num(), TotalNodes > 0 ? 100.f * TotalVisitedNodes / TotalNodes : 100.f, TotalVisitedNodes, TotalNodes, TotalSelectorLoops,
+		TotalWalks.NumWalks, TotalWalks.NumEnded, TotalWalks.NumDeadEnds, TotalWalks.NumMaxStepsReached, TotalWalks.NumFailedToStart,
+		TotalWalks.NumSteps, StepsPerSecond, WallSeconds > 0.0 ? TotalWalks.NumSteps / WallSeconds : 0.0, WallSeconds
+	);
+
+	if (MinStepsPerSecond > 0.0 && StepsPerSecond < MinStepsPerSecond)
+	{
+		UE_LOG(LogDlgSimulateCommandlet, Error, TEXT("%.0f steps/s per thread is below -MinStepsPerSecond = %.0f"), StepsPerSecond, MinStepsPerSecond);
+		bSuccess = false;
+	}
+
+	return bSuccess;
+}
+
+TArray<TArray<int32>> UDlgSimulateCommandlet::FindSelectorLoops(const UDlgDialogue& Dialogue)
+{
+	const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+
+	// The nodes a selector/proxy enters in the same step, only towards other selectors/proxies
+	const auto IsVirtualNode = [&Nodes](int32 NodeIndex)
+	{
+		return Nodes.IsValidIndex(NodeIndex) && (Nodes[NodeIndex]->IsA<UDlgNode_Selector>() || Nodes[NodeIndex]->IsA<UDlgNode_Proxy>());
+	};
+	TArray<TArray<int32>> VirtualChildren;
+	VirtualChildren.SetNum(Nodes.Num());
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		if (!IsVirtualNode(NodeIndex))
+		{
+			continue;
+		}
+
+		if (const UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Nodes[NodeIndex]))
+		{
+			if (IsVirtualNode(Proxy->GetTargetNodeIndex()))
+			{
+				VirtualChildren[NodeIndex].AddUnique(Proxy->GetTargetNodeIndex());
+			}
+			continue;
+		}
+		for (const FDlgEdge& Edge : Nodes[NodeIndex]->GetNodeChildren())
+		{
+			if (IsVirtualNode(Edge.TargetIndex))
+			{
+				VirtualChildren[NodeIndex].AddUnique(Edge.TargetIndex);
+			}
+		}
+	}
+
+	// DFS, each back edge closes a loop made of the nodes on the path since its target
+	enum class EVisitState : uint8 { NotVisited, OnPath, Done };
+	TArray<EVisitState> States;
+	States.Init(EVisitState::NotVisited, Nodes.Num());
+	TArray<TArray<int32>> Loops;
+	TArray<int32> Path;
+
+	TFunction<void(int32)> Visit = [&](int32 NodeIndex)
+	{
+		States[NodeIndex] = EVisitState::OnPath;
+		Path.Add(NodeIndex);
+		for (const int32 ChildIndex : VirtualChildren[NodeIndex])
+		{
+			if (States[ChildIndex] == EVisitState::OnPath)
+			{
+				const int32 LoopStart = Path.Find(ChildIndex);
+				Loops.Emplace(Path.GetData() + LoopStart, Path.Num() - LoopStart);
+			}
+			else if (States[ChildIndex] == EVisitState::NotVisited)
+			{
+				Visit(ChildIndex);
+			}
+		}
+		Path.Pop();
+		States[NodeIndex] = EVisitState::Done;
+	};
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		if (States[NodeIndex] == EVisitState::NotVisited && VirtualChildren[NodeIndex].Num() > 0)
+		{
+			Visit(NodeIndex);
+		}
+	}
+
+	return Loops;
+}
+
+bool UDlgSimulateCommandlet::CanWalkInParallel(const UDlgDialogue& Dialogue)
+{
+	// The custom objects are instanced inside the nodes
+	TArray<UObject*> Objects;
+	static constexpr bool bIncludeNestedObjects = true;
+	GetObjectsWithOuter(&Dialogue, Objects, bIncludeNestedObjects);
+	for (const UObject* Object : Objects)
+	{
+		if (Object->IsA<UDlgConditionCustom>() || Object->IsA<UDlgEventCustom>() || Object->IsA<UDlgTextArgumentCustom>())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
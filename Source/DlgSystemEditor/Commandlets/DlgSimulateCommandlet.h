@@ -0,0 +1,106 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "Math/RandomStream.h"
+
+#include "DlgSystem/Tests/DlgRuntimeBenchmarkTypes.h"
+
+#include "DlgSimulateCommandlet.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgSimulateCommandlet, All, All);
+
+class UDlgDialogue;
+class UDlgContext;
+struct FDlgHistory;
+
+
+// Everything one dialogue needs to be walked, only touched by the thread walking the dialogue
+struct FDlgSimulationTask
+{
+	UDlgDialogue* Dialogue = nullptr;
+	UDlgContext* Context = nullptr;
+	TMap<FGameplayTag, UObject*> Participants;
+
+	// The entry of the dialogue in FDlgMemory, created before the walks so that the memory map does not change while walking
+	FDlgHistory* Memory = nullptr;
+
+	// Answers the conditions of the participants, seeded per dialogue so the results do not depend on the threads
+	FRandomStream Random;
+
+	// False if the dialogue has custom conditions/events/text arguments, those can run anything so they stay on the game thread
+	bool bCanWalkInParallel = true;
+
+	// Result
+	FDlgRandomWalkResult Walks;
+	double Seconds = 0.0;
+
+	// Nodes entered by at least one walk
+	TBitArray<> VisitedNodes;
+
+	// Key: node index a walk got stuck on, Value: number of walks stuck there
+	TMap<int32, int32> DeadEndNodes;
+
+	// Chains of selector/proxy nodes that enter each other, the runtime terminates the dialogue when it enters one of them twice in one step
+	TArray<TArray<int32>> SelectorLoops;
+
+	int32 GetNumVisitedNodes() const { return VisitedNodes.CountSetBits(); }
+	float GetCoverage() const { return VisitedNodes.Num() > 0 ? static_cast<float>(GetNumVisitedNodes()) / VisitedNodes.Num() : 1.f; }
+	double GetStepsPerSecond() const { return Seconds > 0.0 ? Walks.NumSteps / Seconds : 0.0; }
+};
+
+
+/**
+ * Random walks all the Dialogues headlessly with mock participants (UDlgBenchmarkParticipant),
+ * reports the reachability coverage, the dead ends, the selector/proxy loops and the steps per second.
+ * Fails (returns non zero) if any selector loop is found or if any of the requested gates fail, so it can be used in CI.
+ *
+ * Usage:
+ *   -run=DlgSimulate [-Walks=1000] [-MaxSteps=200] [-Seed=0] [-ConditionTrueChance=0.5] [-Fixture=<Path.json>]
+ *                    [-MinCoverage=<0..1>] [-FailOnDeadEnds] [-MinStepsPerSecond=<Steps>] [-AllDialogues] [-SingleThreaded]
+ *
+ * -Walks is per dialogue, each walk starts from the start node with a fresh history and fresh participant values.
+ * -Fixture is a JSON FDlgSimulationFixture with the fixed condition answers and the starting values of the participants,
+ *  the conditions not in the fixture are answered by the RNG seeded from -Seed and the GUID of the dialogue.
+ * -ConditionTrueChance overrides the one from the fixture.
+ * -AllDialogues also walks the dialogues outside the game directory even if bBatchOnlyInGameDialogues is set.
+ */
+UCLASS()
+class UDlgSimulateCommandlet: public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDlgSimulateCommandlet();
+
+public:
+
+	//~ UCommandlet interface
+	int32 Main(const FString& Params) override;
+
+	// Finds the cycles between the selector and proxy nodes, as node indices, each loop once
+	static TArray<TArray<int32>> FindSelectorLoops(const UDlgDialogue& Dialogue);
+
+	// Does the dialogue only run DlgSystem code, no custom conditions/events/text arguments
+	static bool CanWalkInParallel(const UDlgDialogue& Dialogue);
+
+protected:
+	// Own methods
+	bool LoadFixture(const FString& FilePath);
+	void CreateTask(FDlgSimulationTask& Task, UDlgDialogue* Dialogue);
+	void WalkTask(FDlgSimulationTask& Task) const;
+
+	// Logs the results, returns false if any gate failed
+	bool Report(const TArray<FDlgSimulationTask>& Tasks, double WallSeconds) const;
+
+protected:
+	FDlgSimulationFixture Fixture;
+	int32 NumWalks = 1000;
+	int32 MaxSteps = 200;
+	int32 Seed = 0;
+
+	// Gates, disabled by default
+	float MinCoverage = 0.f;
+	bool bFailOnDeadEnds = false;
+	double MinStepsPerSecond = 0.0;
+};
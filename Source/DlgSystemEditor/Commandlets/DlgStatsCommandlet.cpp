@@ -1,17 +1,106 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 
 #include "DlgStatsCommandlet.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectHash.h"
 #include "DlgSystem/DlgManager.h"
 #include "DlgSystem/DlgDialogue.h"
 #include "DlgCommandletHelper.h"
 #include "DlgSystem/Nodes/DlgNode_SpeechSequence.h"
 #include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/Nodes/DlgNode_Proxy.h"
 #include "DlgSystem/DlgHelper.h"
+#include "DlgSystem/DlgCookStripping.h"
+#include "DlgSystem/IO/DlgJsonWriter.h"
 
 
 DEFINE_LOG_CATEGORY(LogDlgStatsCommandlet);
 
 
+FDlgStatsDialogue& FDlgStatsDialogue::operator+=(const FDlgStatsDialogue& Other)
+{
+	WordCount += Other.WordCount;
+	NumNodes += Other.NumNodes;
+	NumEdges += Other.NumEdges;
+	MaxFanOut = FMath::Max(MaxFanOut, Other.MaxFanOut);
+	LongestPath = FMath::Max(LongestPath, Other.LongestPath);
+	NumConditions += Other.NumConditions;
+	NumEvents += Other.NumEvents;
+	NumTextArguments += Other.NumTextArguments;
+	EstimatedMemoryBytes += Other.EstimatedMemoryBytes;
+	CookStrippedBytes += Other.CookStrippedBytes;
+
+	const auto AddByType = [](TMap<FString, int32>& To, const TMap<FString, int32>& From)
+	{
+		for (const auto& KeyValue : From)
+		{
+			To.FindOrAdd(KeyValue.Key) += KeyValue.Value;
+		}
+	};
+	AddByType(NodesByType, Other.NodesByType);
+	AddByType(ConditionsByType, Other.ConditionsByType);
+	AddByType(EventsByType, Other.EventsByType);
+	AddByType(TextArgumentsByType, Other.TextArgumentsByType);
+
+	return *this;
+}
+
+FDlgStatsCSVColumns::FDlgStatsCSVColumns(const TArray<FDlgStatsDialogue>& Stats)
+{
+	TSet<FString> NodeKeySet, ConditionKeySet, EventKeySet, TextArgumentKeySet;
+	for (const FDlgStatsDialogue& Stat : Stats)
+	{
+		for (const auto& KeyValue : Stat.NodesByType) { NodeKeySet.Add(KeyValue.Key); }
+		for (const auto& KeyValue : Stat.ConditionsByType) { ConditionKeySet.Add(KeyValue.Key); }
+		for (const auto& KeyValue : Stat.EventsByType) { EventKeySet.Add(KeyValue.Key); }
+		for (const auto& KeyValue : Stat.TextArgumentsByType) { TextArgumentKeySet.Add(KeyValue.Key); }
+	}
+
+	NodeKeys = NodeKeySet.Array();
+	NodeKeys.Sort();
+	ConditionKeys = ConditionKeySet.Array();
+	ConditionKeys.Sort();
+	EventKeys = EventKeySet.Array();
+	EventKeys.Sort();
+	TextArgumentKeys = TextArgumentKeySet.Array();
+	TextArgumentKeys.Sort();
+}
+
+namespace DlgStatsCommandlet
+{
+	template<typename TEnum>
+	static FString GetEnumValueName(TEnum Value)
+	{
+		return StaticEnum<TEnum>()->GetNameStringByValue(static_cast<int64>(Value));
+	}
+}
+
+FString FDlgStatsDialogue::GetCSVHeader(const FDlgStatsCSVColumns& Columns)
+{
+	FString Header = TEXT("DialoguePath,WordCount,NumNodes,NumEdges,MaxFanOut,LongestPath,NumConditions,NumEvents,NumTextArguments,EstimatedMemoryBytes,CookStrippedBytes");
+	for (const FString& Key : Columns.NodeKeys) { Header += TEXT(",Nodes.") + Key; }
+	for (const FString& Key : Columns.ConditionKeys) { Header += TEXT(",Conditions.") + Key; }
+	for (const FString& Key : Columns.EventKeys) { Header += TEXT(",Events.") + Key; }
+	for (const FString& Key : Columns.TextArgumentKeys) { Header += TEXT(",TextArguments.") + Key; }
+	return Header;
+}
+
+FString FDlgStatsDialogue::ToCSVRow(const FDlgStatsCSVColumns& Columns) const
+{
+	FString Row = FString::Printf(
+		TEXT("%s,%d,%d,%d,%d,%d,%d,%d,%d,%lld,%lld"),
+		*DialoguePath, WordCount, NumNodes, NumEdges, MaxFanOut, LongestPath, NumConditions, NumEvents, NumTextArguments, EstimatedMemoryBytes, CookStrippedBytes
+	);
+	for (const FString& Key : Columns.NodeKeys) { Row += FString::Printf(TEXT(",%d"), NodesByType.FindRef(Key)); }
+	for (const FString& Key : Columns.ConditionKeys) { Row += FString::Printf(TEXT(",%d"), ConditionsByType.FindRef(Key)); }
+	for (const FString& Key : Columns.EventKeys) { Row += FString::Printf(TEXT(",%d"), EventsByType.FindRef(Key)); }
+	for (const FString& Key : Columns.TextArgumentKeys) { Row += FString::Printf(TEXT(",%d"), TextArgumentsByType.FindRef(Key)); }
+	return Row;
+}
+
+
 UDlgStatsCommandlet::UDlgStatsCommandlet()
 {
 	IsClient = false;
@@ -30,57 +119,149 @@ int32 UDlgStatsCommandlet::Main(const FString& Params)
 	TArray<FString> Switches;
 	TMap<FString, FString> ParamVals;
 	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+	const bool bAllDialogues = Switches.Contains(TEXT("AllDialogues"));
+	const bool bSingleThreaded = Switches.Contains(TEXT("SingleThreaded"));
 
 	UDlgManager::LoadAllDialoguesIntoMemory();
 	const TArray<UDlgDialogue*> AllDialogues = UDlgManager::GetAllDialoguesFromMemory();
 
-	FDlgStatsDialogue TotalStats;
-	for (const UDlgDialogue* Dialogue : AllDialogues)
+	// Step 1. Filter and everything that needs the game thread
+	TArray<const UDlgDialogue*> Dialogues;
+	FDlgStatsReport Report;
+	for (UDlgDialogue* Dialogue : AllDialogues)
 	{
 		UPackage* Package = Dialogue->GetOutermost();
 		check(Package);
 		const FString OriginalDialoguePath = Package->GetPathName();
 
 		// Only count game dialogues
-		if (!FDlgHelper::IsPathInProjectDirectory(OriginalDialoguePath))
+		if (!bAllDialogues && !FDlgHelper::IsPathInProjectDirectory(OriginalDialoguePath))
 		{
 			UE_LOG(LogDlgStatsCommandlet, Warning, TEXT("Dialogue = `%s` is not in the game directory, ignoring"), *OriginalDialoguePath);
 			continue;
 		}
 
-		FDlgStatsDialogue DialogueStats;
-		GetStatsForDialogue(*Dialogue, DialogueStats);
-		TotalStats += DialogueStats;
-		UE_LOG(LogDlgStatsCommandlet, Display, TEXT("Dialogue = %s. Total Text Word count = %d"), *OriginalDialoguePath, DialogueStats.WordCount);
+		FDlgStatsDialogue& DialogueStats = Report.Dialogues.AddDefaulted_GetRef();
+		DialogueStats.DialoguePath = OriginalDialoguePath;
+		DialogueStats.EstimatedMemoryBytes = GetEstimatedMemoryBytes(*Dialogue);
+		DialogueStats.CookStrippedBytes = GetCookStrippedBytes(*Dialogue);
+		Dialogues.Add(Dialogue);
+	}
+
+	// Step 2. Each dialogue is independent
+	const double StartTime = FPlatformTime::Seconds();
+	ParallelFor(Dialogues.Num(), [this, &Dialogues, &Report](int32 DialogueIndex)
+	{
+		GetStatsForDialogue(*Dialogues[DialogueIndex], Report.Dialogues[DialogueIndex]);
+	}, bSingleThreaded);
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	Report.Dialogues.Sort([](const FDlgStatsDialogue& A, const FDlgStatsDialogue& B)
+	{
+		return A.EstimatedMemoryBytes > B.EstimatedMemoryBytes;
+	});
+	Report.Total.DialoguePath = TEXT("Total");
+	for (const FDlgStatsDialogue& DialogueStats : Report.Dialogues)
+	{
+		Report.Total += DialogueStats;
+		UE_LOG(LogDlgStatsCommandlet, Display,
+			TEXT("Dialogue = %s. Total Text Word count = %d, Nodes = %d, Edges = %d, Max Fan Out = %d, Longest Path = %d, ")
+			TEXT("Conditions = %d, Events = %d, Text Arguments = %d, Estimated Memory = %lld bytes, Cook Stripped = %lld bytes"),
+			*DialogueStats.DialoguePath, DialogueStats.WordCount, DialogueStats.NumNodes, DialogueStats.NumEdges, DialogueStats.MaxFanOut,
+			DialogueStats.LongestPath, DialogueStats.NumConditions, DialogueStats.NumEvents, DialogueStats.NumTextArguments,
+			DialogueStats.EstimatedMemoryBytes, DialogueStats.CookStrippedBytes
+		);
 	}
 
 	UE_LOG(LogDlgStatsCommandlet, Display,
 		LINE_TERMINATOR TEXT("Stats:") LINE_TERMINATOR
-		TEXT("Total Text Word Count = %d"),
-		TotalStats.WordCount);
+		TEXT("Dialogues = %d (%.3f seconds)") LINE_TERMINATOR
+		TEXT("Total Text Word Count = %d") LINE_TERMINATOR
+		TEXT("Total Nodes = %d, Edges = %d, Conditions = %d, Events = %d, Text Arguments = %d") LINE_TERMINATOR
+		TEXT("Max Fan Out = %d, Longest Path = %d, Total Estimated Memory = %lld bytes, Total Cook Stripped = %lld bytes"),
+		Report.Dialogues.Num(), Seconds,
+		Report.Total.WordCount,
+		Report.Total.NumNodes, Report.Total.NumEdges, Report.Total.NumConditions, Report.Total.NumEvents, Report.Total.NumTextArguments,
+		Report.Total.MaxFanOut, Report.Total.LongestPath, Report.Total.EstimatedMemoryBytes, Report.Total.CookStrippedBytes);
+
+	bool bSuccess = true;
+	if (const FString* JSONVal = ParamVals.Find(FString(TEXT("JSON"))))
+	{
+		bSuccess &= WriteJSON(Report, *JSONVal);
+	}
+	if (const FString* CSVVal = ParamVals.Find(FString(TEXT("CSV"))))
+	{
+		bSuccess &= WriteCSV(Report, *CSVVal);
+	}
 
-	return 0;
+	return bSuccess ? 0 : -1;
 }
 
 
-bool UDlgStatsCommandlet::GetStatsForDialogue(const UDlgDialogue& Dialogue, FDlgStatsDialogue& OutStats)
+bool UDlgStatsCommandlet::GetStatsForDialogue(const UDlgDialogue& Dialogue, FDlgStatsDialogue& OutStats) const
 {
 	// Root
 	for (const UDlgNode* StartNode : Dialogue.GetStartNodes())
 	{
 		OutStats.WordCount += GetNodeWordCount(*StartNode);
+		AddNodeStats(*StartNode, OutStats);
 	}
 
 	// Nodes
 	const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+	OutStats.NumNodes += Nodes.Num();
 	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
 	{
 		OutStats.WordCount += GetNodeWordCount(*Nodes[NodeIndex]);
+		AddNodeStats(*Nodes[NodeIndex], OutStats);
+		OutStats.NodesByType.FindOrAdd(Nodes[NodeIndex]->GetClass()->GetName())++;
 	}
 
+	OutStats.LongestPath = GetLongestPath(Dialogue);
 	return true;
 }
 
+void UDlgStatsCommandlet::AddNodeStats(const UDlgNode& Node, FDlgStatsDialogue& OutStats) const
+{
+	using namespace DlgStatsCommandlet;
+
+	const auto AddConditions = [&OutStats](const TArray<FDlgCondition>& Conditions)
+	{
+		OutStats.NumConditions += Conditions.Num();
+		for (const FDlgCondition& Condition : Conditions)
+		{
+			OutStats.ConditionsByType.FindOrAdd(GetEnumValueName(Condition.ConditionType))++;
+		}
+	};
+	const auto AddTextArguments = [&OutStats](const TArray<FDlgTextArgument>& TextArguments)
+	{
+		OutStats.NumTextArguments += TextArguments.Num();
+		for (const FDlgTextArgument& TextArgument : TextArguments)
+		{
+			OutStats.TextArgumentsByType.FindOrAdd(GetEnumValueName(TextArgument.Type))++;
+		}
+	};
+
+	AddConditions(Node.GetNodeEnterConditions());
+	AddTextArguments(Node.GetTextArguments());
+
+	OutStats.NumEvents += Node.GetNodeEnterEvents().Num();
+	for (const FDlgEvent& Event : Node.GetNodeEnterEvents())
+	{
+		OutStats.EventsByType.FindOrAdd(GetEnumValueName(Event.EventType))++;
+	}
+
+	// Edges
+	const TArray<FDlgEdge>& Children = Node.GetNodeChildren();
+	OutStats.NumEdges += Children.Num();
+	OutStats.MaxFanOut = FMath::Max(OutStats.MaxFanOut, Children.Num());
+	for (const FDlgEdge& Edge : Children)
+	{
+		AddConditions(Edge.Conditions);
+		AddTextArguments(Edge.GetTextArguments());
+	}
+}
+
 int32 UDlgStatsCommandlet::GetNodeWordCount(const UDlgNode& Node) const
 {
 	const UDlgNode* NodePtr = &Node;
@@ -118,3 +299,214 @@ int32 UDlgStatsCommandlet::GetStringWordCount(const FString& String) const
 	String.ParseIntoArray(Out, TEXT(" "), true);
 	return Out.Num();
 }
+
+int32 UDlgStatsCommandlet::GetLongestPath(const UDlgDialogue& Dialogue)
+{
+	const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+
+	// The nodes that can be entered after each node
+	TArray<TArray<int32>> Successors;
+	Successors.SetNum(Nodes.Num());
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		if (const UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Nodes[NodeIndex]))
+		{
+			Successors[NodeIndex].Add(Proxy->GetTargetNodeIndex());
+		}
+		for (const FDlgEdge& Edge : Nodes[NodeIndex]->GetNodeChildren())
+		{
+			Successors[NodeIndex].Add(Edge.TargetIndex);
+		}
+	}
+
+	// The nodes that can reach each other (a loop) are condensed into one component, a walk can enter all of them before leaving it.
+	// Tarjan's algorithm, iterative as the dialogues can be deep. A component is complete after all the components it reaches,
+	// so the longest walk from it is known as soon as it is complete, whatever the order of the nodes is.
+	struct FFrame
+	{
+		int32 NodeIndex = INDEX_NONE;
+		int32 NextSuccessor = 0;
+	};
+	TArray<int32> VisitOrder;
+	VisitOrder.Init(INDEX_NONE, Nodes.Num());
+	TArray<int32> LowLink;
+	LowLink.Init(INDEX_NONE, Nodes.Num());
+	TArray<int32> NodeComponent;
+	NodeComponent.Init(INDEX_NONE, Nodes.Num());
+	TBitArray<> OnStack(false, Nodes.Num());
+	TArray<int32> ComponentStack;
+	TArray<FFrame> Stack;
+	int32 NextVisitOrder = 0;
+
+	// Node count of the longest walk starting in each component
+	TArray<int32> LongestFromComponent;
+	TArray<int32> ComponentNodes;
+
+	const auto Visit = [&](int32 NodeIndex)
+	{
+		VisitOrder[NodeIndex] = LowLink[NodeIndex] = NextVisitOrder++;
+		OnStack[NodeIndex] = true;
+		ComponentStack.Add(NodeIndex);
+		Stack.Add({NodeIndex, 0});
+	};
+
+	int32 LongestPath = 0;
+	for (const UDlgNode* StartNode : Dialogue.GetStartNodes())
+	{
+		for (const FDlgEdge& StartEdge : StartNode->GetNodeChildren())
+		{
+			if (!Nodes.IsValidIndex(StartEdge.TargetIndex))
+			{
+				continue;
+			}
+
+			if (VisitOrder[StartEdge.TargetIndex] == INDEX_NONE)
+			{
+				Visit(StartEdge.TargetIndex);
+			}
+			while (Stack.Num() > 0)
+			{
+				FFrame& Top = Stack.Last();
+				const int32 TopNodeIndex = Top.NodeIndex;
+				const TArray<int32>& TopSuccessors = Successors[TopNodeIndex];
+				if (TopSuccessors.IsValidIndex(Top.NextSuccessor))
+				{
+					const int32 Successor = TopSuccessors[Top.NextSuccessor++];
+					if (!Nodes.IsValidIndex(Successor))
+					{
+						continue;
+					}
+					if (VisitOrder[Successor] == INDEX_NONE)
+					{
+						Visit(Successor);
+					}
+					else if (OnStack[Successor])
+					{
+						LowLink[TopNodeIndex] = FMath::Min(LowLink[TopNodeIndex], VisitOrder[Successor]);
+					}
+					continue;
+				}
+
+				Stack.Pop();
+				if (Stack.Num() > 0)
+				{
+					const int32 ParentNodeIndex = Stack.Last().NodeIndex;
+					LowLink[ParentNodeIndex] = FMath::Min(LowLink[ParentNodeIndex], LowLink[TopNodeIndex]);
+				}
+				if (LowLink[TopNodeIndex] != VisitOrder[TopNodeIndex])
+				{
+					continue;
+				}
+
+				// TopNodeIndex is the first visited node of its component, everything above it on the component stack belongs to it
+				const int32 ComponentIndex = LongestFromComponent.Num();
+				ComponentNodes.Reset();
+				int32 ComponentNodeIndex = INDEX_NONE;
+				do
+				{
+					ComponentNodeIndex = ComponentStack.Pop();
+					OnStack[ComponentNodeIndex] = false;
+					NodeComponent[ComponentNodeIndex] = ComponentIndex;
+					ComponentNodes.Add(ComponentNodeIndex);
+				}
+				while (ComponentNodeIndex != TopNodeIndex);
+
+				// The successors outside of the component are in the components completed before
+				int32 LongestSuccessor = 0;
+				for (const int32 NodeIndex : ComponentNodes)
+				{
+					for (const int32 Successor : Successors[NodeIndex])
+					{
+						if (Nodes.IsValidIndex(Successor) && NodeComponent[Successor] != ComponentIndex)
+						{
+							LongestSuccessor = FMath::Max(LongestSuccessor, LongestFromComponent[NodeComponent[Successor]]);
+						}
+					}
+				}
+				LongestFromComponent.Add(ComponentNodes.Num() + LongestSuccessor);
+			}
+
+			LongestPath = FMath::Max(LongestPath, LongestFromComponent[NodeComponent[StartEdge.TargetIndex]]);
+		}
+	}
+
+	return LongestPath;
+}
+
+int64 UDlgStatsCommandlet::GetEstimatedMemoryBytes(UDlgDialogue& Dialogue)
+{
+	// The nodes and their instanced objects, the graph is editor only
+	TArray<UObject*> Objects;
+	static constexpr bool bIncludeNestedObjects = true;
+	GetObjectsWithOuter(&Dialogue, Objects, bIncludeNestedObjects);
+	Objects.Add(&Dialogue);
+
+	int64 Bytes = 0;
+	for (UObject* Object : Objects)
+	{
+		if (Object->IsEditorOnly())
+		{
+			continue;
+		}
+
+		FArchiveCountMem CountMem(Object);
+		Bytes += CountMem.GetMax();
+	}
+
+	return Bytes;
+}
+
+int64 UDlgStatsCommandlet::GetCookStrippedBytes(UDlgDialogue& Dialogue)
+{
+	TArray<UObject*> Objects;
+	static constexpr bool bIncludeNestedObjects = true;
+	GetObjectsWithOuter(&Dialogue, Objects, bIncludeNestedObjects);
+	Objects.Add(&Dialogue);
+
+	int64 Bytes = 0;
+	for (UObject* Object : Objects)
+	{
+		if (!Object->IsEditorOnly())
+		{
+			Bytes += FDlgCookStripScope::GetStrippedBytes(*Object);
+		}
+	}
+
+	return Bytes;
+}
+
+bool UDlgStatsCommandlet::WriteJSON(const FDlgStatsReport& Report, const FString& FilePath) const
+{
+	FDlgJsonWriter Writer;
+	Writer.Write(FDlgStatsReport::StaticStruct(), &Report);
+	if (!Writer.ExportToFile(FilePath))
+	{
+		UE_LOG(LogDlgStatsCommandlet, Error, TEXT("FAILED to write the JSON stats to `%s`"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogDlgStatsCommandlet, Display, TEXT("Wrote the JSON stats to `%s`"), *FilePath);
+	return true;
+}
+
+bool UDlgStatsCommandlet::WriteCSV(const FDlgStatsReport& Report, const FString& FilePath) const
+{
+	TArray<FDlgStatsDialogue> AllStats = Report.Dialogues;
+	AllStats.Add(Report.Total);
+
+	const FDlgStatsCSVColumns Columns(AllStats);
+	FString CSV = FDlgStatsDialogue::GetCSVHeader(Columns) + LINE_TERMINATOR;
+	for (const FDlgStatsDialogue& Stats : AllStats)
+	{
+		CSV += Stats.ToCSVRow(Columns) + LINE_TERMINATOR;
+	}
+
+	if (!FFileHelper::SaveStringToFile(CSV, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogDlgStatsCommandlet, Error, TEXT("FAILED to write the CSV stats to `%s`"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogDlgStatsCommandlet, Display, TEXT("Wrote the CSV stats to `%s`"), *FilePath);
+	return true;
+}
@@ -10,22 +10,115 @@ DECLARE_LOG_CATEGORY_EXTERN(LogDlgStatsCommandlet, All, All);
 
 class UDlgDialogue;
 class UDlgNode;
+struct FDlgStatsCSVColumns;
 
 
+USTRUCT()
 struct FDlgStatsDialogue
 {
+	GENERATED_USTRUCT_BODY()
+
+public:
+	// Sums everything, except the max/longest values which keep the maximum
+	FDlgStatsDialogue& operator+=(const FDlgStatsDialogue& Other);
+
+	// Column names of ToCSVRow
+	static FString GetCSVHeader(const FDlgStatsCSVColumns& Columns);
+	FString ToCSVRow(const FDlgStatsCSVColumns& Columns) const;
+
 public:
+	UPROPERTY()
+	FString DialoguePath;
+
+	UPROPERTY()
 	int32 WordCount = 0;
 
-	FDlgStatsDialogue& operator+=(const FDlgStatsDialogue& Other)
-	{
-		WordCount += Other.WordCount;
-		return *this;
-	}
+	// Without the start nodes
+	UPROPERTY()
+	int32 NumNodes = 0;
+
+	// The children of all the nodes, including the start nodes
+	UPROPERTY()
+	int32 NumEdges = 0;
+
+	UPROPERTY()
+	int32 MaxFanOut = 0;
+
+	// Most different nodes a single walk from a start node can enter, proxies count as edges to their target. The conditions are ignored.
+	// Exact on the graph where each loop is condensed into one component, as a walk can enter all the nodes of a loop before leaving it
+	UPROPERTY()
+	int32 LongestPath = 0;
+
+	// Node enter conditions + edge conditions
+	UPROPERTY()
+	int32 NumConditions = 0;
+
+	UPROPERTY()
+	int32 NumEvents = 0;
+
+	// Node and edge text arguments
+	UPROPERTY()
+	int32 NumTextArguments = 0;
+
+	// Key: node class name, without the start nodes
+	UPROPERTY()
+	TMap<FString, int32> NodesByType;
+
+	// Key: the enum value name
+	UPROPERTY()
+	TMap<FString, int32> ConditionsByType;
+
+	UPROPERTY()
+	TMap<FString, int32> EventsByType;
+
+	UPROPERTY()
+	TMap<FString, int32> TextArgumentsByType;
 
+	// Serialized size of the dialogue and of the runtime objects inside it (nodes, custom conditions/events/text arguments), without the editor only objects
+	UPROPERTY()
+	int64 EstimatedMemoryBytes = 0;
+
+	// How much smaller the serialized dialogue and its nodes get when cooked with UDlgSystemSettings::bStripDialoguesOnCook
+	UPROPERTY()
+	int64 CookStrippedBytes = 0;
+};
+
+// The by type columns of the CSV, the union of the keys of all the Stats, sorted. Computed once for the header and all the rows
+struct FDlgStatsCSVColumns
+{
+	explicit FDlgStatsCSVColumns(const TArray<FDlgStatsDialogue>& Stats);
+
+	TArray<FString> NodeKeys;
+	TArray<FString> ConditionKeys;
+	TArray<FString> EventKeys;
+	TArray<FString> TextArgumentKeys;
+};
+
+// What -JSON writes
+USTRUCT()
+struct FDlgStatsReport
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY()
+	FDlgStatsDialogue Total;
+
+	// Sorted by EstimatedMemoryBytes, the most expensive first
+	UPROPERTY()
+	TArray<FDlgStatsDialogue> Dialogues;
 };
 
 
+/**
+ * Computes the word counts and the structural complexity of the game Dialogues, see FDlgStatsDialogue.
+ *
+ * Usage:
+ *   -run=DlgStats [-AllDialogues] [-JSON=<Path.json>] [-CSV=<Path.csv>] [-SingleThreaded]
+ *
+ * -AllDialogues also processes the dialogues outside the game directory.
+ * -JSON writes the FDlgStatsReport and -CSV one row per dialogue plus the total.
+ */
 UCLASS()
 class UDlgStatsCommandlet: public UCommandlet
 {
@@ -39,10 +132,23 @@ public:
 	//~ UCommandlet interface
 	int32 Main(const FString& Params) override;
 
-	bool GetStatsForDialogue(const UDlgDialogue& Dialogue, FDlgStatsDialogue& OutStats);
+	// Does not touch the UObject hash tables so it can run in parallel for different dialogues
+	bool GetStatsForDialogue(const UDlgDialogue& Dialogue, FDlgStatsDialogue& OutStats) const;
+	void AddNodeStats(const UDlgNode& Node, FDlgStatsDialogue& OutStats) const;
 	int32 GetNodeWordCount(const UDlgNode& Node) const;
 
 	int32 GetStringWordCount(const FString& String) const;
 	int32 GetFNameWordCount(const FName Name) const { return GetStringWordCount(Name.ToString()); }
 	int32 GetTextWordCount(const FText& Text) const { return GetStringWordCount(Text.ToString()); }
+
+	// See FDlgStatsDialogue::LongestPath
+	static int32 GetLongestPath(const UDlgDialogue& Dialogue);
+
+	// Game thread only
+	static int64 GetEstimatedMemoryBytes(UDlgDialogue& Dialogue);
+	static int64 GetCookStrippedBytes(UDlgDialogue& Dialogue);
+
+protected:
+	bool WriteJSON(const FDlgStatsReport& Report, const FString& FilePath) const;
+	bool WriteCSV(const FDlgStatsReport& Report, const FString& FilePath) const;
 };
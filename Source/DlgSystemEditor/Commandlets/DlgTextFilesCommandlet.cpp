@@ -0,0 +1,135 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgTextFilesCommandlet.h"
+
+#include "UObject/Package.h"
+#include "FileHelpers.h"
+
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgHelper.h"
+#include "DlgSystem/IO/DlgBatchIO.h"
+#include "DlgSystemEditor/DlgEditorUtilities.h"
+
+
+DEFINE_LOG_CATEGORY(LogDlgTextFilesCommandlet);
+
+UDlgTextFilesCommandlet::UDlgTextFilesCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UDlgTextFilesCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogDlgTextFilesCommandlet, Display, TEXT("Starting"));
+	const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
+
+	// Parse command line - we're interested in the param vals
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	const bool bExport = Switches.Contains(TEXT("Export"));
+	const bool bImport = Switches.Contains(TEXT("Import"));
+	const bool bDelete = Switches.Contains(TEXT("Delete"));
+	if (static_cast<int32>(bExport) + static_cast<int32>(bImport) + static_cast<int32>(bDelete) != 1)
+	{
+		UE_LOG(LogDlgTextFilesCommandlet, Error, TEXT("Did not choose exactly one operation. Either -Export OR -Import OR -Delete"));
+		return -1;
+	}
+
+	TextFormat = Settings->DialogueTextFormat;
+	if (const FString* TextFormatVal = ParamVals.Find(FString(TEXT("TextFormat"))))
+	{
+		EDlgDialogueTextFormat ParsedTextFormat = EDlgDialogueTextFormat::None;
+		if (!FDlgHelper::ConvertStringToEnum<EDlgDialogueTextFormat>(*TextFormatVal, TEXT("EDlgDialogueTextFormat"), ParsedTextFormat)
+			|| ParsedTextFormat == EDlgDialogueTextFormat::None
+			|| static_cast<int32>(ParsedTextFormat) >= static_cast<int32>(EDlgDialogueTextFormat::NumTextFormats))
+		{
+			UE_LOG(LogDlgTextFilesCommandlet, Error, TEXT("Invalid -TextFormat = `%s`. Expected JSON, Binary, DialogueDEPRECATED or All"), **TextFormatVal);
+			return -1;
+		}
+		TextFormat = ParsedTextFormat;
+	}
+	if (!bDelete && TextFormat == EDlgDialogueTextFormat::None)
+	{
+		UE_LOG(LogDlgTextFilesCommandlet, Error, TEXT("The DialogueTextFormat from the Dialogue Settings is None, provide one with -TextFormat=<Format>"));
+		return -1;
+	}
+
+	bForce = Switches.Contains(TEXT("Force"));
+	UDlgManager::LoadAllDialoguesIntoMemory();
+
+	// Filter the dialogues same as the editor batch operations
+	const bool bOnlyInGameDialogues = Settings->bBatchOnlyInGameDialogues && !Switches.Contains(TEXT("AllDialogues"));
+	TArray<UDlgDialogue*> Dialogues;
+	for (UDlgDialogue* Dialogue : UDlgManager::GetAllDialoguesFromMemory())
+	{
+		if (bOnlyInGameDialogues && !Dialogue->IsInProjectDirectory())
+		{
+			continue;
+		}
+		Dialogues.Add(Dialogue);
+	}
+	UE_LOG(LogDlgTextFilesCommandlet, Display, TEXT("Processing %d Dialogues"), Dialogues.Num());
+
+	if (bExport)
+		return Export(Dialogues);
+	if (bImport)
+		return Import(Dialogues);
+	if (bDelete)
+		return Delete(Dialogues);
+
+	return 0;
+}
+
+int32 UDlgTextFilesCommandlet::Export(const TArray<UDlgDialogue*>& Dialogues)
+{
+	if (bForce)
+	{
+		for (UDlgDialogue* Dialogue : Dialogues)
+		{
+			Dialogue->ClearTextFileContentHashes();
+		}
+	}
+
+	const FDlgBatchIOResult Result = FDlgBatchIO::ExportDialogues(Dialogues, TextFormat);
+	UE_LOG(LogDlgTextFilesCommandlet, Display, TEXT("Export finished: %s"), *Result.ToString());
+	return Result.IsSuccess() ? 0 : -1;
+}
+
+int32 UDlgTextFilesCommandlet::Import(const TArray<UDlgDialogue*>& Dialogues)
+{
+	const FDlgBatchIOResult Result = FDlgBatchIO::ImportDialogues(Dialogues, TextFormat);
+	UE_LOG(LogDlgTextFilesCommandlet, Display, TEXT("Import finished: %s"), *Result.ToString());
+
+	// Update graph, dialogue data -> graph, otherwise saving compiles the old graph over the imported data
+	for (UDlgDialogue* Dialogue : Dialogues)
+	{
+		Dialogue->ClearGraph();
+	}
+
+	// Save the imported data into the assets, this also writes back the text files as the import might have regenerated duplicate GUIDs
+	const bool bSaved = FDlgEditorUtilities::SaveDialogues(Dialogues, [](const TArray<UPackage*>& PackagesToSave)
+	{
+		static constexpr bool bCheckDirty = false;
+		return UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, bCheckDirty);
+	});
+	if (!bSaved)
+	{
+		UE_LOG(LogDlgTextFilesCommandlet, Error, TEXT("FAILED to save the Dialogue packages"));
+	}
+
+	return Result.IsSuccess() && bSaved ? 0 : -1;
+}
+
+int32 UDlgTextFilesCommandlet::Delete(const TArray<UDlgDialogue*>& Dialogues)
+{
+	const FDlgBatchIOResult Result = FDlgBatchIO::DeleteTextFiles(Dialogues);
+	UE_LOG(LogDlgTextFilesCommandlet, Display, TEXT("Delete finished: %s"), *Result.ToString());
+	return Result.IsSuccess() ? 0 : -1;
+}
@@ -0,0 +1,46 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "DlgSystem/DlgSystemSettings.h"
+
+#include "DlgTextFilesCommandlet.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgTextFilesCommandlet, All, All);
+
+class UDlgDialogue;
+
+/**
+ * Batch Exports/Imports/Deletes the text files of all the Dialogues, see FDlgBatchIO.
+ *
+ * Usage:
+ *   -run=DlgTextFiles -Export|-Import|-Delete [-TextFormat=JSON|Binary|DialogueDEPRECATED|All] [-AllDialogues] [-Force]
+ *
+ * -TextFormat defaults to the DialogueTextFormat from the Dialogue Settings.
+ * -AllDialogues also processes the dialogues outside the game directory even if bBatchOnlyInGameDialogues is set.
+ * -Force rewrites the text files even if their content did not change since the last export.
+ * -Import saves the dialogue packages after reading the text files.
+ */
+UCLASS()
+class UDlgTextFilesCommandlet: public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDlgTextFilesCommandlet();
+
+public:
+
+	//~ UCommandlet interface
+	int32 Main(const FString& Params) override;
+
+protected:
+	// Own methods
+	int32 Export(const TArray<UDlgDialogue*>& Dialogues);
+	int32 Import(const TArray<UDlgDialogue*>& Dialogues);
+	int32 Delete(const TArray<UDlgDialogue*>& Dialogues);
+
+protected:
+	EDlgDialogueTextFormat TextFormat = EDlgDialogueTextFormat::None;
+	bool bForce = false;
+};
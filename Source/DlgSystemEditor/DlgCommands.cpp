@@ -150,6 +150,14 @@ void FDlgCommands::RegisterCommands()
 		EUserInterfaceActionType::Button,
 		FInputChord(EModifierKey::Control, EKeys::H)
 	);
+
+	UI_COMMAND(
+		AutoPositionSelectedNodes,
+		"Auto Position Selected Nodes",
+		"Arranges the selected nodes in layers following the links between them, the other nodes are not moved",
+		EUserInterfaceActionType::Button,
+		FInputChord()
+	);
 }
 
 #undef LOCTEXT_NAMESPACE
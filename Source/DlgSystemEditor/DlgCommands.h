@@ -76,4 +76,7 @@ public:
 
 	// UnHide all nodes
 	TSharedPtr<FUICommandInfo> UnHideAllNodes;
+
+	// Auto position the selected nodes
+	TSharedPtr<FUICommandInfo> AutoPositionSelectedNodes;
 };
@@ -16,24 +16,14 @@
 #include "Editor/IDlgEditor.h"
 #include "Editor/Nodes/DialogueGraphNode.h"
 #include "Editor/Nodes/DialogueGraphNode_Edge.h"
+#include "Editor/Graph/DlgGraphLayout.h"
 #include "DlgSystem/DlgHelper.h"
 #include "DlgSystem/DlgManager.h"
+#include "DlgSystem/IO/DlgBatchIO.h"
 #include "Factories/DlgClassViewerFilters.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "K2Node_Event.h"
 
-/** Useful for auto positioning */
-struct NodeWithParentPosition
-{
-	NodeWithParentPosition() {}
-	NodeWithParentPosition(UDialogueGraphNode* InNode, const int32 InParentNodeX, const int32 InParentNodeY) :
-		Node(InNode), ParentNodeX(InParentNodeX), ParentNodeY(InParentNodeY) {}
-
-	UDialogueGraphNode* Node = nullptr;
-	int32 ParentNodeX = 0;
-	int32 ParentNodeY = 0;
-};
-
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FDlgEditorUtilities
 void FDlgEditorUtilities::LoadAllDialoguesAndCheckGUIDs()
@@ -404,155 +394,103 @@ void FDlgEditorUtilities::AutoPositionGraphNodes(
 	bool bIsDirectionVertical
 )
 {
-	TSet<UDialogueGraphNode*> VisitedNodes;
-	VisitedNodes.Add(RootNode);
-	TQueue<NodeWithParentPosition> Queue;
-	verify(Queue.Enqueue(NodeWithParentPosition(RootNode, 0, 0)));
+	// The root node stays one row (or column) away from the origin, same as it always was
+	const FIntPoint RootPosition = bIsDirectionVertical ? FIntPoint(0, OffsetBetweenRowsY) : FIntPoint(OffsetBetweenColumnsX, 0);
+	LayoutGraphNodes(GraphNodes, RootNode, RootPosition, OffsetBetweenColumnsX, OffsetBetweenRowsY, bIsDirectionVertical);
+}
 
-	// Find first node with children so that we do not get all the graph with orphan nodes
+void FDlgEditorUtilities::AutoPositionSelectedGraphNodes(
+	const TArray<UDialogueGraphNode*>& GraphNodes,
+	int32 OffsetBetweenColumnsX,
+	int32 OffsetBetweenRowsY,
+	bool bIsDirectionVertical
+)
+{
+	if (GraphNodes.Num() == 0)
 	{
-		UDialogueGraphNode* Node = RootNode;
-		int32 Index = 0;
-		while (Index < GraphNodes.Num() && Node->GetOutputPin()->LinkedTo.Num() == 0)
-		{
-			Node = GraphNodes[Index];
-			Index++;
-		}
-		if (Node != RootNode)
-		{
-			NodeWithParentPosition ParentPosition;
-			if (bIsDirectionVertical)
-			{
-				ParentPosition = NodeWithParentPosition(Node, 0, OffsetBetweenRowsY);
-			}
-			else
-			{
-				ParentPosition = NodeWithParentPosition(Node, OffsetBetweenColumnsX, 0);
-			}
-
-			verify(Queue.Enqueue(ParentPosition));
-		}
+		return;
 	}
 
-	// Just some BFS
-	while (!Queue.IsEmpty())
+	// Keep the top left corner of the selection where it is
+	FIntPoint TopLeft = GraphNodes[0]->GetPosition();
+	for (const UDialogueGraphNode* GraphNode : GraphNodes)
 	{
-		NodeWithParentPosition NodeWithPosition;
-		verify(Queue.Dequeue(NodeWithPosition));
-		UDialogueGraphNode* Node = NodeWithPosition.Node;
+		TopLeft = TopLeft.ComponentMin(GraphNode->GetPosition());
+	}
+	LayoutGraphNodes(GraphNodes, nullptr, TopLeft, OffsetBetweenColumnsX, OffsetBetweenRowsY, bIsDirectionVertical);
+}
 
-		if (bIsDirectionVertical)
-		{
-			// Position this node at the same level only one row further (down)
-			Node->SetPosition(
-				NodeWithPosition.ParentNodeX,
-				NodeWithPosition.ParentNodeY + OffsetBetweenRowsY
-			);
-		}
-		else
-		{
-			// Position this node at the same level only one column further (to the right)
-			Node->SetPosition(
-				NodeWithPosition.ParentNodeX + OffsetBetweenColumnsX,
-				NodeWithPosition.ParentNodeY
-			);
-		}
+void FDlgEditorUtilities::LayoutGraphNodes(
+	const TArray<UDialogueGraphNode*>& GraphNodes,
+	const UDialogueGraphNode* AnchorNode,
+	const FIntPoint& AnchorPosition,
+	int32 OffsetBetweenColumnsX,
+	int32 OffsetBetweenRowsY,
+	bool bIsDirectionVertical
+)
+{
+	if (GraphNodes.Num() == 0)
+	{
+		return;
+	}
 
-		// Gather the list of unvisited child nodes, useful for not drawing weird children
-		TArray<UDialogueGraphNode*> ChildNodesUnvisited;
-		for (UDialogueGraphNode* ChildNode : Node->GetChildNodes())
+	// The layout prefers the vertices added first as sources, add the anchor, then the roots and then the rest
+	TArray<UDialogueGraphNode*> OrderedGraphNodes;
+	OrderedGraphNodes.Reserve(GraphNodes.Num());
+	if (AnchorNode)
+	{
+		OrderedGraphNodes.Add(const_cast<UDialogueGraphNode*>(AnchorNode));
+	}
+	for (UDialogueGraphNode* GraphNode : GraphNodes)
+	{
+		if (GraphNode != AnchorNode && GraphNode->IsRootNode())
 		{
-			// Prevent double visiting
-			if (!VisitedNodes.Contains(ChildNode))
-			{
-				ChildNodesUnvisited.Add(ChildNode);
-			}
+			OrderedGraphNodes.Add(GraphNode);
 		}
-
-		// Adjust
-		int32 ChildOffsetPos;
-		if (bIsDirectionVertical)
+	}
+	for (UDialogueGraphNode* GraphNode : GraphNodes)
+	{
+		if (GraphNode != AnchorNode && !GraphNode->IsRootNode())
 		{
-			// Adjust for the number of nodes, so that we are left, down by half
-			int32 ChildOffsetPosX = Node->NodePosX;
-			if (ChildNodesUnvisited.Num() > 1) // only adjust X position if we have more than one child
-			{
-				ChildOffsetPosX -= OffsetBetweenColumnsX * ChildNodesUnvisited.Num() / 2;
-			}
-
-			ChildOffsetPos = ChildOffsetPosX;
-		}
-		else
-		{
-			// Adjust for the number of nodes, so that we are right above (top) by half
-			int32 ChildOffsetPosY = Node->NodePosY;
-			if (ChildNodesUnvisited.Num() > 1) // only adjust Y position if we have more than one child
-			{
-				ChildOffsetPosY -= OffsetBetweenRowsY * ChildNodesUnvisited.Num() / 2;
-			}
-
-			ChildOffsetPos = ChildOffsetPosY;
+			OrderedGraphNodes.Add(GraphNode);
 		}
+	}
 
-		// Position children
-		for (int32 ChildIndex = 0, ChildNum = ChildNodesUnvisited.Num(); ChildIndex < ChildNum; ChildIndex++)
+	// Only the links between the GraphNodes are part of the layout
+	FDlgGraphLayout Layout;
+	TMap<const UDialogueGraphNode*, int32> GraphNodeToVertex;
+	GraphNodeToVertex.Reserve(OrderedGraphNodes.Num());
+	for (const UDialogueGraphNode* GraphNode : OrderedGraphNodes)
+	{
+		GraphNodeToVertex.Add(GraphNode, Layout.AddVertex(GraphNode->GetNodeSize()));
+	}
+	for (const UDialogueGraphNode* GraphNode : OrderedGraphNodes)
+	{
+		const int32 Vertex = GraphNodeToVertex.FindChecked(GraphNode);
+		for (const UDialogueGraphNode* ChildNode : GraphNode->GetChildNodes())
 		{
-			UDialogueGraphNode* ChildNode = ChildNodesUnvisited[ChildIndex];
-			if (bIsDirectionVertical)
-			{
-				ChildNode->SetPosition(ChildOffsetPos, Node->NodePosY);
-			}
-			else
+			if (const int32* ChildVertex = GraphNodeToVertex.Find(ChildNode))
 			{
-				ChildNode->SetPosition(Node->NodePosX, ChildOffsetPos);
+				Layout.AddEdge(Vertex, *ChildVertex);
 			}
-
-			VisitedNodes.Add(ChildNode);
-
-			NodeWithParentPosition ParentPosition;
-			if (bIsDirectionVertical)
-			{
-				ParentPosition = NodeWithParentPosition(ChildNode, ChildOffsetPos, Node->NodePosY);
-				ChildOffsetPos += OffsetBetweenColumnsX + ChildNode->EstimateNodeWidth();
-			}
-			else
-			{
-				// Next child on this level will set X aka columns to Node->NodePosX + OffsetBetweenColumnsX
-				// And Y aka row will be the same as this parent node, so it will be ChildOffsetPosY
-				ParentPosition = NodeWithParentPosition(ChildNode, Node->NodePosX + ChildNode->EstimateNodeWidth() * 1.5, ChildOffsetPos);
-				ChildOffsetPos += OffsetBetweenRowsY;
-			}
-
-			Queue.Enqueue(ParentPosition);
 		}
 	}
 
-	// Fix position of orphans (nodes/node group with no parents)
-	if (GraphNodes.Num() != VisitedNodes.Num())
+	FDlgGraphLayoutSettings LayoutSettings;
+	LayoutSettings.bIsDirectionVertical = bIsDirectionVertical;
+	LayoutSettings.GapInsideLayer = bIsDirectionVertical ? OffsetBetweenColumnsX : OffsetBetweenRowsY;
+	LayoutSettings.GapBetweenLayers = bIsDirectionVertical ? OffsetBetweenRowsY : OffsetBetweenColumnsX;
+	const FDlgGraphLayoutStats Stats = Layout.Compute(LayoutSettings);
+
+	// The anchor node (or the top left of the layout) ends up at the AnchorPosition
+	const FIntPoint Offset = AnchorNode ? AnchorPosition - Layout.GetVertexPosition(0) : AnchorPosition;
+	for (int32 Vertex = 0; Vertex < OrderedGraphNodes.Num(); Vertex++)
 	{
-		TSet<UDialogueGraphNode*> NodesSet(GraphNodes);
-		// Nodes that are in the graph but not in the visited nodes set
-		TSet<UDialogueGraphNode*> OrphanedNodes = NodesSet.Difference(VisitedNodes);
-		for (UDialogueGraphNode* Node : OrphanedNodes)
-		{
-			// Finds the highest bottom left point
-			const FVector2D NodePos = Node->GetGraph()->GetGoodPlaceForNewNode();
-			if (bIsDirectionVertical)
-			{
-				Node->SetPosition(
-					NodePos.X,
-					NodePos.Y + OffsetBetweenRowsY
-				);
-			}
-			else
-			{
-				Node->SetPosition(
-					NodePos.X + OffsetBetweenColumnsX,
-					NodePos.Y
-				);
-			}
-		}
+		const FIntPoint Position = Layout.GetVertexPosition(Vertex) + Offset;
+		OrderedGraphNodes[Vertex]->SetPosition(Position.X, Position.Y);
 	}
+
+	UE_LOG(LogDlgSystemEditor, Log, TEXT("Auto positioned the graph nodes: %s"), *Stats.ToString());
 }
 
 bool FDlgEditorUtilities::CanConvertSpeechNodesToSpeechSequence(
@@ -830,7 +768,7 @@ void FDlgEditorUtilities::RemapOldIndicesWithNewAndUpdateGUID(
 		return;
 	}
 
-	const UDlgDialogue* Dialogue = GraphNodes[0]->GetDialogue();
+	UDlgDialogue* Dialogue = GraphNodes[0]->GetDialogue();
 	const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
 
 	// helper function to set the new IntValue on the condition if it exists in the history and it is different
@@ -895,6 +833,9 @@ void FDlgEditorUtilities::RemapOldIndicesWithNewAndUpdateGUID(
 
 		GraphNode->CheckDialogueNodeSyncWithGraphNode(true);
 	}
+
+	// The proxy targets changed, the resolved indices and the collapsed proxy chains are computed from them
+	Dialogue->RebuildResolvedNodeIndices();
 }
 
 UDlgDialogue* FDlgEditorUtilities::GetDialogueFromGraphNode(const UEdGraphNode* GraphNode)
@@ -916,7 +857,7 @@ UDlgDialogue* FDlgEditorUtilities::GetDialogueFromGraphNode(const UEdGraphNode*
 bool FDlgEditorUtilities::SaveAllDialogues()
 {
 	const TArray<UDlgDialogue*> Dialogues = UDlgManager::GetAllDialoguesFromMemory();
-	TArray<UPackage*> PackagesToSave;
+	TArray<UDlgDialogue*> DialoguesToSave;
 	const bool bBatchOnlyInGameDialogues = GetDefault<UDlgSystemSettings>()->bBatchOnlyInGameDialogues;
 
 	for (UDlgDialogue* Dialogue : Dialogues)
@@ -927,20 +868,67 @@ bool FDlgEditorUtilities::SaveAllDialogues()
 			continue;
 		}
 
+		DialoguesToSave.Add(Dialogue);
+	}
+
+	return SaveDialogues(DialoguesToSave, [](const TArray<UPackage*>& PackagesToSave)
+	{
+		static constexpr bool bCheckDirty = false;
+		static constexpr bool bPromptToSave = false;
+		return FEditorFileUtils::PromptForCheckoutAndSave(PackagesToSave, bCheckDirty, bPromptToSave) == FEditorFileUtils::EPromptReturnCode::PR_Success;
+	});
+}
+
+bool FDlgEditorUtilities::SaveDialogues(const TArray<UDlgDialogue*>& Dialogues, TFunctionRef<bool(const TArray<UPackage*>&)> SavePackages)
+{
+	const EDlgDialogueTextFormat TextFormat = GetDefault<UDlgSystemSettings>()->DialogueTextFormat;
+	TArray<UPackage*> PackagesToSave;
+	bool bSuccess = true;
+
+	// Saving would export each dialogue serially from PreSave, export all of them in parallel instead
+	FDlgBatchIO::FScopedDeferExport DeferExport;
+
+	// Compile, graph data -> dialogue data
+	for (UDlgDialogue* Dialogue : Dialogues)
+	{
+		Dialogue->OnPreAssetSaved();
 		Dialogue->MarkPackageDirty();
 		PackagesToSave.Add(Dialogue->GetOutermost());
 	}
 
-	static constexpr bool bCheckDirty = false;
-	static constexpr bool bPromptToSave = false;
-	return FEditorFileUtils::PromptForCheckoutAndSave(PackagesToSave, bCheckDirty, bPromptToSave) == FEditorFileUtils::EPromptReturnCode::PR_Success;
+	// Export before saving so that the content hashes of the text files are saved with the packages
+	if (TextFormat != EDlgDialogueTextFormat::None)
+	{
+		bSuccess &= FDlgBatchIO::ExportDialogues(Dialogues, TextFormat).IsSuccess();
+	}
+
+	// Already compiled above, the dialogues that had the compilation disabled before keep it disabled
+	TArray<UDlgDialogue*> CompileDisabledDialogues;
+	for (UDlgDialogue* Dialogue : Dialogues)
+	{
+		if (Dialogue->IsCompileDialogueEnabled())
+		{
+			Dialogue->DisableCompileDialogue();
+			CompileDisabledDialogues.Add(Dialogue);
+		}
+	}
+
+	bSuccess &= SavePackages(PackagesToSave);
+
+	for (UDlgDialogue* Dialogue : CompileDisabledDialogues)
+	{
+		Dialogue->EnableCompileDialogue();
+	}
+
+	return bSuccess;
 }
 
 bool FDlgEditorUtilities::DeleteAllDialoguesTextFiles()
 {
 	const TArray<UDlgDialogue*> Dialogues = UDlgManager::GetAllDialoguesFromMemory();
 	const bool bBatchOnlyInGameDialogues = GetDefault<UDlgSystemSettings>()->bBatchOnlyInGameDialogues;
-	for (const UDlgDialogue* Dialogue : Dialogues)
+	TArray<UDlgDialogue*> DialoguesToDelete;
+	for (UDlgDialogue* Dialogue : Dialogues)
 	{
 		// Ignore, not in game directory
 		if (bBatchOnlyInGameDialogues && !Dialogue->IsInProjectDirectory())
@@ -948,10 +936,10 @@ bool FDlgEditorUtilities::DeleteAllDialoguesTextFiles()
 			continue;
 		}
 
-		Dialogue->DeleteAllTextFiles();
+		DialoguesToDelete.Add(Dialogue);
 	}
 
-	return true;
+	return FDlgBatchIO::DeleteTextFiles(DialoguesToDelete).IsSuccess();
 }
 
 bool FDlgEditorUtilities::PickChildrenOfClass(const FText& TitleText, UClass*& OutChosenClass, UClass* Class)
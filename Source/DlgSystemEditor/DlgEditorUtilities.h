@@ -20,6 +20,7 @@ enum class EDlgBlueprintOpenType : uint8
 // FDlgEditorUtilities
 
 class UDlgDialogue;
+class UPackage;
 class UEdGraphSchema;
 class UDlgNode;
 class UEdGraph;
@@ -113,9 +114,9 @@ public:
 	}
 
 	/**
-	 * Automatically reposition all the nodes in the graph.
+	 * Automatically reposition all the nodes in the graph with a layered layout (see FDlgGraphLayout).
 	 *
-	 * @param	RootNode				The Node that is considered the node
+	 * @param	RootNode				The Node that is considered the node, it always ends up at the same position
 	 * @param	GraphNodes				The rest of the graph nodes
 	 * @param	OffsetBetweenColumnsX   The offset between nodes on the X axis
 	 * @param	OffsetBetweenRowsY		The offset between nodes on the Y axis
@@ -129,6 +130,17 @@ public:
 		bool bIsDirectionVertical
 	);
 
+	/**
+	 * Same as AutoPositionGraphNodes only that just the GraphNodes (and the links between them) are repositioned.
+	 * The top left corner of the GraphNodes stays the same.
+	 */
+	static void AutoPositionSelectedGraphNodes(
+		const TArray<UDialogueGraphNode*>& GraphNodes,
+		int32 OffsetBetweenColumnsX,
+		int32 OffsetBetweenRowsY,
+		bool bIsDirectionVertical
+	);
+
 	/**
 	 * Tells us if the selected nodes can be converted to a speech sequence node.
 	 *
@@ -213,7 +225,7 @@ public:
 	/**
 	 * Replaces all references to old Node indices from the provided GraphNodes with new indices.
 	 * This can happen inside Conditions of type WasNodeVisited and HasSatisfiedChild because the NodeIndex is a weak reference.
-	 * Also sets the correct GUID to nodes that reference the GUID
+	 * Also sets the correct GUID to nodes that reference the GUID and rebuilds the resolved node indices of the Dialogue.
 	 *
 	 * @param	GraphNodes			The nodes we are replacing the old references
 	 * @param	OldToNewIndexMap	Map that tells us the mapping from old index to new index. Maps from old index -> new index
@@ -226,10 +238,14 @@ public:
 	// Gets the Dialogue for the provided UEdGraphNode
 	static UDlgDialogue* GetDialogueFromGraphNode(const UEdGraphNode* GraphNode);
 
-	// Save all the dialogues.
+	// Save all the dialogues, see SaveDialogues.
 	// @return True on success or false on failure.
 	static bool SaveAllDialogues();
 
+	// Compiles the Dialogues, exports their text files in parallel (see FDlgBatchIO) then saves their packages with SavePackages.
+	// @return True on success or false on failure.
+	static bool SaveDialogues(const TArray<UDlgDialogue*>& Dialogues, TFunctionRef<bool(const TArray<UPackage*>&)> SavePackages);
+
 	// Deletes all teh dialogues text files
 	// @return True on success or false on failure.
 	static bool DeleteAllDialoguesTextFiles();
@@ -277,5 +293,15 @@ private:
 	// Get the DialogueEditor for given object, if it exists
 	static TSharedPtr<class IDlgEditor> GetDialogueEditorForGraph(const UEdGraph* Graph);
 
+	// Used by the AutoPosition methods, the AnchorNode (or the top left of the layout if there is no AnchorNode) is moved to AnchorPosition
+	static void LayoutGraphNodes(
+		const TArray<UDialogueGraphNode*>& GraphNodes,
+		const UDialogueGraphNode* AnchorNode,
+		const FIntPoint& AnchorPosition,
+		int32 OffsetBetweenColumnsX,
+		int32 OffsetBetweenRowsY,
+		bool bIsDirectionVertical
+	);
+
 	FDlgEditorUtilities() = delete;
 };
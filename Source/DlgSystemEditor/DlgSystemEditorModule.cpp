@@ -39,6 +39,7 @@
 #include "DlgSystem/IDlgSystemModule.h"
 #include "DlgSystem/DlgParticipantTag.h"
 
+#include "DlgSystem/IO/DlgClassNameIndex.h"
 #include "DlgSystem/IO/DlgConfigWriter.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 
@@ -285,6 +286,16 @@ void FDlgSystemEditorModule::ShutdownModule()
 	{
 		FEditorDelegates::EndPIE.Remove(OnEndPIEHandle);
 	}
+#if NY_ENGINE_VERSION < 500
+	if (OnObjectsReplacedHandle.IsValid())
+	{
+		if (GEditor)
+		{
+			GEditor->OnObjectsReplaced().Remove(OnObjectsReplacedHandle);
+		}
+		OnObjectsReplacedHandle.Reset();
+	}
+#endif
 	if (OnPostEngineInitHandle.IsValid())
 	{
 		FCoreDelegates::OnPostEngineInit.Remove(OnPostEngineInitHandle);
@@ -337,6 +348,14 @@ void FDlgSystemEditorModule::HandleOnPostEngineInit()
 {
 	bIsEngineInitialized = true;
 	UE_LOG(LogDlgSystemEditor, Log, TEXT("DlgSystemEditorModule::HandleOnPostEngineInit"));
+
+#if NY_ENGINE_VERSION < 500
+	// Blueprint compile replaces the old class with a new one, the runtime module binds FCoreUObjectDelegates::OnObjectsReplaced on 5.0+
+	if (GEditor)
+	{
+		OnObjectsReplacedHandle = GEditor->OnObjectsReplaced().AddRaw(&FDlgClassNameIndex::Get(), &FDlgClassNameIndex::HandleObjectsReplaced);
+	}
+#endif
 }
 
 void FDlgSystemEditorModule::HandleOnBeginPIE(bool bIsSimulating)
@@ -105,6 +105,7 @@ private:
 	FDelegateHandle OnBeginPIEHandle;
 	FDelegateHandle OnPostPIEStartedHandle; // after BeginPlay() has been called
 	FDelegateHandle OnEndPIEHandle;
+	FDelegateHandle OnObjectsReplacedHandle; // only used before 5.0, see FDlgClassNameIndex
 
 	// Flags
 	bool bIsEngineInitialized = false;
@@ -23,11 +23,9 @@ void FDlgCompilerContext::Compile()
 	}
 
 	ResultDialogueNodes.Empty();
-	VisitedNodes.Empty();
-	Queue.Empty();
 	IndicesHistory.Empty();
-	NodesPath.Empty();
-	NextAvailableIndex = 0;
+	PlannedNodes.Empty();
+	PlannedNodeIndices.Empty();
 
 	// The code below tries to reconstruct the Dialogue Nodes from the Graph Nodes (aka compile).
 	// The tricky part of the reconstructing (the Dialogue Nodes) is the node indices, because it takes
@@ -40,8 +38,20 @@ void FDlgCompilerContext::Compile()
 	// Step 1. Find the roots and set the start nodes
 	GraphNodeRoots = DialogueGraph->GetRootGraphNodes();
 	check(GraphNodeRoots.Num() > 0);
-
 	OrderRootGraphNodes();
+
+	// Most edits (moving nodes, adding/removing a link) keep most of the indices the same, only update what changed
+	if (TryCompileIncremental(DialogueGraph))
+	{
+		return;
+	}
+
+	// Full compile, walk everything again and reassign all the indices
+	VisitedNodes.Empty();
+	Queue.Empty();
+	NodesPath.Empty();
+	NextAvailableIndex = 0;
+
 	TArray<UDlgNode*> StartNodes;
 	for (UDialogueGraphNode_Root* RootNode : GraphNodeRoots)
 	{
@@ -76,11 +86,195 @@ void FDlgCompilerContext::Compile()
 	// Step 6. Fix old indices and update GUID for the Conditions
 	FixBrokenOldIndicesAndUpdateGUID();
 
+	DialogueGraph->SetLastCompiledStructureHash(ComputeStructureHash());
 	Dialogue->PostEditChange();
 
 	FDlgEditorUtilities::RefreshDialogueEditorForGraph(DialogueGraph);
 }
 
+void FDlgCompilerContext::PlanGraphNodeIndices()
+{
+	VisitedNodes.Empty();
+	Queue.Empty();
+	NodesPath.Empty();
+	NodeDepth = 0;
+	NodesNumberUntilDepthIncrease = 1;
+	NodesNumberNextDepth = 0;
+
+	// Same as CompileGraphNode only that the indices are just recorded
+	auto PlanGraphNode = [this](UDialogueGraphNode* GraphNode)
+	{
+		GraphNode->SortChildrenBasedOnXLocation();
+		GraphNode->CheckDialogueNodeSyncWithGraphNode();
+		GraphNode->SetNodeDepth(NodeDepth);
+		NodeUnvisitedChildrenNum = 0;
+
+		for (UDialogueGraphNode* ChildNode : GraphNode->GetChildNodes())
+		{
+			if (VisitedNodes.Contains(ChildNode))
+			{
+				continue;
+			}
+
+			verify(Queue.Enqueue(ChildNode));
+			VisitedNodes.Add(ChildNode);
+			NodesPath.Add(ChildNode, GraphNode);
+			NodeUnvisitedChildrenNum++;
+			PlannedNodeIndices.Add(ChildNode, PlannedNodes.Add(ChildNode));
+		}
+
+		UpdateNodeDepth();
+	};
+
+	for (UDialogueGraphNode_Root* RootNode : GraphNodeRoots)
+	{
+		VisitedNodes.Add(RootNode);
+		PlannedNodeIndices.Add(RootNode, INDEX_NONE);
+		PlanGraphNode(RootNode);
+	}
+
+	while (!Queue.IsEmpty())
+	{
+		UDialogueGraphNode* GraphNode;
+		verify(Queue.Dequeue(GraphNode));
+		PlanGraphNode(GraphNode);
+	}
+}
+
+bool FDlgCompilerContext::TryCompileIncremental(UDialogueGraph* DialogueGraph)
+{
+	PlanGraphNodeIndices();
+
+	// Orphans get their indices from PruneIsolatedNodes and new nodes need a GUID, leave those to the full compile.
+	// NOTE: nothing was modified until here besides the children order and the depths, which the full compile sets the same way.
+	if (VisitedNodes.Num() != DialogueGraphNodes.Num())
+	{
+		return false;
+	}
+	for (const UDialogueGraphNode* GraphNode : DialogueGraphNodes)
+	{
+		if (!GraphNode->GetDialogueNode().HasGUID())
+		{
+			return false;
+		}
+	}
+
+	// Step 1. Start nodes
+	TArray<UDlgNode*> StartNodes;
+	for (UDialogueGraphNode_Root* RootNode : GraphNodeRoots)
+	{
+		StartNodes.Add(RootNode->GetMutableDialogueNode());
+	}
+	const bool bStartNodesChanged = Dialogue->GetStartNodes() != StartNodes;
+	if (bStartNodesChanged)
+	{
+		Dialogue->SetStartNodes(StartNodes);
+	}
+
+	// Step 2. Only the nodes that moved in the BFS order get a new index
+	const TArray<UDlgNode*>& CurrentDialogueNodes = Dialogue->GetNodes();
+	bool bNodesChanged = CurrentDialogueNodes.Num() != PlannedNodes.Num();
+	ResultDialogueNodes.Reserve(PlannedNodes.Num());
+	for (int32 NodeIndex = 0, NodesNum = PlannedNodes.Num(); NodeIndex < NodesNum; NodeIndex++)
+	{
+		UDialogueGraphNode* GraphNode = PlannedNodes[NodeIndex];
+		if (GraphNode->GetDialogueNodeIndex() != NodeIndex)
+		{
+			IndicesHistory.Add(GraphNode->GetDialogueNodeIndex(), NodeIndex);
+			GraphNode->SetDialogueNodeIndex(NodeIndex);
+		}
+
+		UDlgNode* DialogueNode = GraphNode->GetMutableDialogueNode();
+		ResultDialogueNodes.Add(DialogueNode);
+		bNodesChanged |= !CurrentDialogueNodes.IsValidIndex(NodeIndex) || CurrentDialogueNodes[NodeIndex] != DialogueNode;
+	}
+
+	// Step 3. Only the edges that do not point to the planned index are updated
+	bool bEdgesChanged = false;
+	auto UpdateEdgesTargetIndex = [this, &bEdgesChanged](UDialogueGraphNode* GraphNode)
+	{
+		const TArray<FDlgEdge>& NodeEdges = GraphNode->GetDialogueNode().GetNodeChildren();
+		const TArray<UDialogueGraphNode*> ChildNodes = GraphNode->GetChildNodes();
+		const TArray<UDialogueGraphNode_Edge*> ChildEdgeNodes = GraphNode->GetChildEdgeNodes();
+		for (int32 ChildIndex = 0, ChildrenNum = ChildNodes.Num(); ChildIndex < ChildrenNum; ChildIndex++)
+		{
+			const int32 PlannedIndex = PlannedNodeIndices.FindChecked(ChildNodes[ChildIndex]);
+			if (NodeEdges[ChildIndex].TargetIndex != PlannedIndex || ChildEdgeNodes[ChildIndex]->GetDialogueEdge().TargetIndex != PlannedIndex)
+			{
+				GraphNode->SetEdgeTargetIndexAt(ChildIndex, PlannedIndex);
+				bEdgesChanged = true;
+			}
+		}
+	};
+	for (UDialogueGraphNode_Root* RootNode : GraphNodeRoots)
+	{
+		UpdateEdgesTargetIndex(RootNode);
+	}
+	for (UDialogueGraphNode* GraphNode : PlannedNodes)
+	{
+		UpdateEdgesTargetIndex(GraphNode);
+	}
+
+	// Step 4. Update the dialogue data, the conditions GUID are only updated here so always do it
+	if (bNodesChanged)
+	{
+		Dialogue->EmptyNodesGUIDToIndexMap();
+		Dialogue->SetNodes(ResultDialogueNodes);
+	}
+	FixBrokenOldIndicesAndUpdateGUID();
+
+	// Same structure as the last compile, nothing to refresh.
+	// The hash catches the edits that do not move any index, like a new link to a node that already had the right index.
+	const uint32 StructureHash = ComputeStructureHash();
+	if (!bStartNodesChanged && !bNodesChanged && !bEdgesChanged && IndicesHistory.Num() == 0
+		&& StructureHash == DialogueGraph->GetLastCompiledStructureHash())
+	{
+		return true;
+	}
+
+	// Step 5. Categorization and warnings depend on the paths through the graph, redo them
+	SetEdgesCategorization();
+	for (UDialogueGraphNode* GraphNode : DialogueGraphNodes)
+	{
+		GraphNode->ApplyCompilerWarnings();
+		GraphNode->CheckDialogueNodeSyncWithGraphNode(true);
+	}
+
+	DialogueGraph->SetLastCompiledStructureHash(StructureHash);
+	Dialogue->PostEditChange();
+
+	FDlgEditorUtilities::RefreshDialogueEditorForGraph(DialogueGraph);
+	return true;
+}
+
+uint32 FDlgCompilerContext::ComputeStructureHash() const
+{
+	uint32 Hash = GetTypeHash(Dialogue->GetNodes().Num());
+	auto HashGraphNode = [&Hash](const UDialogueGraphNode* GraphNode)
+	{
+		const TArray<FDlgEdge>& NodeEdges = GraphNode->GetDialogueNode().GetNodeChildren();
+		Hash = HashCombine(Hash, GetTypeHash(GraphNode));
+		Hash = HashCombine(Hash, GetTypeHash(GraphNode->GetDialogueNodeIndex()));
+		Hash = HashCombine(Hash, GetTypeHash(NodeEdges.Num()));
+		for (const FDlgEdge& Edge : NodeEdges)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Edge.TargetIndex));
+		}
+	};
+
+	// Walk in the Dialogue.Nodes order so that the hash does not depend on the order of the graph nodes
+	for (const UDialogueGraphNode_Root* RootNode : GraphNodeRoots)
+	{
+		HashGraphNode(RootNode);
+	}
+	for (const UDlgNode* DialogueNode : Dialogue->GetNodes())
+	{
+		HashGraphNode(CastChecked<UDialogueGraphNode>(DialogueNode->GetGraphNode()));
+	}
+
+	return Hash;
+}
+
 void FDlgCompilerContext::OrderRootGraphNodes()
 {
 	// order based on position
@@ -93,7 +287,11 @@ void FDlgCompilerContext::OrderRootGraphNodes()
 void FDlgCompilerContext::PreCompileGraphNode(UDialogueGraphNode* GraphNode)
 {
 	// Sort connections/children so that they're organized the same as user can see in the editor.
-	GraphNode->SortChildrenBasedOnXLocation();
+	// Nodes visited by PlanGraphNodeIndices are already sorted.
+	if (!PlannedNodeIndices.Contains(GraphNode))
+	{
+		GraphNode->SortChildrenBasedOnXLocation();
+	}
 	GraphNode->CheckDialogueNodeSyncWithGraphNode();
 	GraphNode->SetNodeDepth(NodeDepth);
 	NodeUnvisitedChildrenNum = 0;
@@ -113,7 +311,11 @@ void FDlgCompilerContext::PostCompileGraphNode(UDialogueGraphNode* GraphNode)
 		DialogueNode->RegenerateGUID();
 	}
 
-	// Update depth
+	UpdateNodeDepth();
+}
+
+void FDlgCompilerContext::UpdateNodeDepth()
+{
 	// BFS has the property that unvisited nodes in the queue all have depths that never decrease,
 	// and increase by at most 1.
 	--NodesNumberUntilDepthIncrease;
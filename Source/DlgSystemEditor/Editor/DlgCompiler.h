@@ -9,6 +9,7 @@ class UDialogueGraphNode_Root;
 class UDlgNode;
 class UDlgDialogue;
 class UDialogueGraphNode;
+class UDialogueGraph;
 class UDlgSystemSettings;
 
 class DLGSYSTEMEDITOR_API FDlgCompilerContext
@@ -20,10 +21,32 @@ public:
 	: Dialogue(InDialogue), Settings(InSettings), MessageLog(InMessageLog)
 	{}
 
-	/** Compile the Dialogue from its graph nodes */
+	/**
+	 * Compile the Dialogue from its graph nodes.
+	 * If possible only the changed parts of the Dialogue are updated (see TryCompileIncremental), otherwise everything is rebuilt.
+	 */
 	void Compile();
 
 private:
+	/**
+	 * Walks the graph the same way the full compile does (same order, same sorting of children, same depths) but without modifying any index.
+	 * Fills PlannedNodes, PlannedNodeIndices, VisitedNodes and NodesPath.
+	 */
+	void PlanGraphNodeIndices();
+
+	/**
+	 * Compares the result of PlanGraphNodeIndices with the current Dialogue data and only patches what is different:
+	 * the moved node indices, the edges that point to them, the start nodes and the Dialogue.Nodes Array.
+	 * If the structure is the same as at the last compile the Dialogue is not refreshed at all.
+	 * Returns false if the graph has something only the full compile handles (orphan nodes, nodes without a GUID).
+	 */
+	bool TryCompileIncremental(UDialogueGraph* DialogueGraph);
+
+	/** Hash of the graph structure (node order, node indices and edge targets), compared between compiles. */
+	uint32 ComputeStructureHash() const;
+
+	/** Updates the BFS depth tracking after a node was compiled. */
+	void UpdateNodeDepth();
 
 	/** Reorders start nodes based on their position */
 	void OrderRootGraphNodes();
@@ -92,6 +115,15 @@ private:
 	/** The root graph nodes. */
 	TArray<UDialogueGraphNode_Root*> GraphNodeRoots;
 
+	/** The non root graph nodes in the order PlanGraphNodeIndices visited them, aka the new Dialogue.Nodes Array. */
+	TArray<UDialogueGraphNode*> PlannedNodes;
+
+	/**
+	 * The planned index of each visited graph node, INDEX_NONE for the root nodes.
+	 * Nodes in here already had their children sorted this compile.
+	 */
+	TMap<const UDialogueGraphNode*, int32> PlannedNodeIndices;
+
 	/**
 	 * Keep track of paths. Use pointers as the indices change at compile time.
 	 * Key: Node
@@ -583,6 +583,12 @@ void FDlgEditor::BindEditorCommands()
 		FExecuteAction::CreateRaw(this, &Self::OnCommandUnHideAllNodes)
 	);
 
+	GraphEditorCommands->MapAction(
+		DialogueCommands.AutoPositionSelectedNodes,
+		FExecuteAction::CreateRaw(this, &Self::OnCommandAutoPositionSelectedNodes),
+		FCanExecuteAction::CreateLambda([this] { return GetSelectedNodes().Num() > 0; })
+	);
+
 	// Toolikit/Toolbar commands/Menu Commands
 	// Undo Redo menu options
 	ToolkitCommands->MapAction(
@@ -1318,6 +1324,43 @@ void FDlgEditor::OnCommandUnHideAllNodes()
 	}
 }
 
+void FDlgEditor::OnCommandAutoPositionSelectedNodes() const
+{
+	TArray<UDialogueGraphNode*> SelectedGraphNodes;
+	for (UObject* Object : GetSelectedNodes())
+	{
+		if (UDialogueGraphNode* GraphNode = Cast<UDialogueGraphNode>(Object))
+		{
+			SelectedGraphNodes.Add(GraphNode);
+		}
+	}
+	if (SelectedGraphNodes.Num() == 0)
+	{
+		return;
+	}
+
+	// The selection has no order, use the one the user sees
+	SelectedGraphNodes.Sort([](const UDialogueGraphNode& A, const UDialogueGraphNode& B)
+	{
+		return A.NodePosX != B.NodePosX ? A.NodePosX < B.NodePosX : A.NodePosY < B.NodePosY;
+	});
+
+	const FScopedTransaction Transaction(LOCTEXT("AutoPositionSelectedNodes", "Dialogue Editor: Auto Position Nodes"));
+	for (UDialogueGraphNode* GraphNode : SelectedGraphNodes)
+	{
+		GraphNode->Modify();
+	}
+
+	// Same direction as UDialogueGraph::AutoPositionGraphNodes
+	static constexpr bool bIsDirectionVertical = true;
+	FDlgEditorUtilities::AutoPositionSelectedGraphNodes(
+		SelectedGraphNodes,
+		GetSettings().OffsetBetweenColumnsX,
+		GetSettings().OffsetBetweenRowsY,
+		bIsDirectionVertical
+	);
+}
+
 void FDlgEditor::OnCommandDialogueReload() const
 {
 	// Ignore
@@ -264,6 +264,9 @@ private:
 	// Unhide all nodes.
 	void OnCommandUnHideAllNodes();
 
+	// Auto position the selected nodes.
+	void OnCommandAutoPositionSelectedNodes() const;
+
 	//
 	// Toolbar commands
 	//
@@ -206,7 +206,7 @@ void UDialogueGraph::LinkGraphNodeToChildren(
 void UDialogueGraph::AutoPositionGraphNodes() const
 {
 	static constexpr bool bIsDirectionVertical = true;
-	// TODO: multiple start node support
+	// All the start nodes are laid out, the first one is the anchor of the layout
 	UDialogueGraphNode_Root* RootNode = GetRootGraphNodes()[0];
 	const TArray<UDialogueGraphNode*> DialogueGraphNodes = GetAllDialogueGraphNodes();
 	const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
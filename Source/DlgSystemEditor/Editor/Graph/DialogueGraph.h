@@ -75,6 +75,10 @@ public:
 	/** Helper method to get directly the Dialogue Graph Schema */
 	const UDialogueGraphSchema* GetDialogueGraphSchema() const;
 
+	/** The structure hash of this graph at the last compile, see FDlgCompilerContext::ComputeStructureHash. 0 means unknown. */
+	uint32 GetLastCompiledStructureHash() const { return LastCompiledStructureHash; }
+	void SetLastCompiledStructureHash(uint32 InHash) { LastCompiledStructureHash = InHash; }
+
 private:
 	UDialogueGraph(const FObjectInitializer& ObjectInitializer);
 
@@ -84,4 +88,9 @@ private:
 		const UDlgNode& NodeDialogue,
 		UDialogueGraphNode* NodeGraph
 	) const;
+
+private:
+	// Not serialized and not part of the undo/redo transactions, it is only a hint,
+	// the compile also compares the graph against the Dialogue data.
+	uint32 LastCompiledStructureHash = 0;
 };
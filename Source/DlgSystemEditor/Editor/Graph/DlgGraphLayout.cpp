@@ -0,0 +1,363 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgGraphLayout.h"
+
+#include "HAL/PlatformTime.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FDlgGraphLayout::AddVertex(const FIntPoint& Size)
+{
+	OutEdges.AddDefaulted();
+	return Sizes.Add(Size);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgGraphLayout::AddEdge(int32 FromVertex, int32 ToVertex)
+{
+	check(Sizes.IsValidIndex(FromVertex) && Sizes.IsValidIndex(ToVertex));
+	if (FromVertex != ToVertex)
+	{
+		OutEdges[FromVertex].AddUnique(ToVertex);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+FDlgGraphLayoutStats FDlgGraphLayout::Compute(const FDlgGraphLayoutSettings& Settings)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	FDlgGraphLayoutStats Stats;
+	Stats.NumVertices = Sizes.Num();
+	for (const TArray<int32>& Edges : OutEdges)
+	{
+		Stats.NumEdges += Edges.Num();
+	}
+
+	Positions.Empty();
+	if (Sizes.Num() > 0)
+	{
+		RemoveCycles(Stats);
+		AssignLayers();
+		Stats.NumLayers = Layers.Num();
+		MinimizeCrossings(Settings, Stats);
+		AssignCoordinates(Settings);
+	}
+
+	Stats.Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	return Stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgGraphLayout::RemoveCycles(FDlgGraphLayoutStats& Stats)
+{
+	const int32 NumVertices = Sizes.Num();
+	Children.Empty(NumVertices);
+	Children.SetNum(NumVertices);
+	Parents.Empty(NumVertices);
+	Parents.SetNum(NumVertices);
+
+	auto AddAcyclicEdge = [this](int32 FromVertex, int32 ToVertex)
+	{
+		if (!Children[FromVertex].Contains(ToVertex))
+		{
+			Children[FromVertex].Add(ToVertex);
+			Parents[ToVertex].Add(FromVertex);
+		}
+	};
+
+	// Iterative DFS, an edge to a vertex that is still on the stack closes a cycle so it is reversed
+	enum class EVisitState : uint8 { NotVisited, OnStack, Done };
+	TArray<EVisitState> VisitState;
+	VisitState.Init(EVisitState::NotVisited, NumVertices);
+
+	// Key: vertex, Value: index of the next out edge to look at
+	TArray<TPair<int32, int32>> Stack;
+	for (int32 StartVertex = 0; StartVertex < NumVertices; StartVertex++)
+	{
+		if (VisitState[StartVertex] != EVisitState::NotVisited)
+		{
+			continue;
+		}
+
+		VisitState[StartVertex] = EVisitState::OnStack;
+		Stack.Emplace(StartVertex, 0);
+		while (Stack.Num() > 0)
+		{
+			const int32 Vertex = Stack.Last().Key;
+			const int32 EdgeIndex = Stack.Last().Value++;
+			if (!OutEdges[Vertex].IsValidIndex(EdgeIndex))
+			{
+				VisitState[Vertex] = EVisitState::Done;
+				Stack.Pop();
+				continue;
+			}
+
+			const int32 ChildVertex = OutEdges[Vertex][EdgeIndex];
+			if (VisitState[ChildVertex] == EVisitState::OnStack)
+			{
+				AddAcyclicEdge(ChildVertex, Vertex);
+				Stats.NumReversedEdges++;
+				continue;
+			}
+
+			AddAcyclicEdge(Vertex, ChildVertex);
+			if (VisitState[ChildVertex] == EVisitState::NotVisited)
+			{
+				VisitState[ChildVertex] = EVisitState::OnStack;
+				Stack.Emplace(ChildVertex, 0);
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgGraphLayout::AssignLayers()
+{
+	// Longest path layering in topological order (Kahn), sources are on layer 0
+	const int32 NumVertices = Sizes.Num();
+	TArray<int32> InDegree;
+	InDegree.SetNumUninitialized(NumVertices);
+	VertexLayer.Init(0, NumVertices);
+
+	TArray<int32> TopologicalOrder;
+	TopologicalOrder.Reserve(NumVertices);
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		InDegree[Vertex] = Parents[Vertex].Num();
+		if (InDegree[Vertex] == 0)
+		{
+			TopologicalOrder.Add(Vertex);
+		}
+	}
+
+	int32 NumLayers = 1;
+	for (int32 Index = 0; Index < TopologicalOrder.Num(); Index++)
+	{
+		const int32 Vertex = TopologicalOrder[Index];
+		for (const int32 ChildVertex : Children[Vertex])
+		{
+			VertexLayer[ChildVertex] = FMath::Max(VertexLayer[ChildVertex], VertexLayer[Vertex] + 1);
+			NumLayers = FMath::Max(NumLayers, VertexLayer[ChildVertex] + 1);
+			if (--InDegree[ChildVertex] == 0)
+			{
+				TopologicalOrder.Add(ChildVertex);
+			}
+		}
+	}
+	check(TopologicalOrder.Num() == NumVertices);
+
+	// The initial order inside the layers is the topological (breadth first like) order
+	Layers.Empty(NumLayers);
+	Layers.SetNum(NumLayers);
+	for (const int32 Vertex : TopologicalOrder)
+	{
+		Layers[VertexLayer[Vertex]].Add(Vertex);
+	}
+
+	VertexOrder.SetNumUninitialized(NumVertices);
+	for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+	{
+		UpdateVertexOrder(LayerIndex);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgGraphLayout::MinimizeCrossings(const FDlgGraphLayoutSettings& Settings, FDlgGraphLayoutStats& Stats)
+{
+	int32 BestCrossings = CountCrossings();
+	Stats.NumCrossingsInitial = BestCrossings;
+
+	TArray<TArray<int32>> BestLayers = Layers;
+	for (int32 Sweep = 0; Sweep < Settings.CrossingMinimizationSweeps && BestCrossings > 0; Sweep++)
+	{
+		for (int32 LayerIndex = 1; LayerIndex < Layers.Num(); LayerIndex++)
+		{
+			SortLayerByBarycenter(LayerIndex, true);
+		}
+		for (int32 LayerIndex = Layers.Num() - 2; LayerIndex >= 0; LayerIndex--)
+		{
+			SortLayerByBarycenter(LayerIndex, false);
+		}
+
+		// Barycenter sweeps can also make it worse, only keep improvements
+		const int32 Crossings = CountCrossings();
+		if (Crossings < BestCrossings)
+		{
+			BestCrossings = Crossings;
+			BestLayers = Layers;
+		}
+	}
+
+	Layers = MoveTemp(BestLayers);
+	for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); LayerIndex++)
+	{
+		UpdateVertexOrder(LayerIndex);
+	}
+	Stats.NumCrossings = BestCrossings;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgGraphLayout::SortLayerByBarycenter(int32 LayerIndex, bool bUseParents)
+{
+	TArray<int32>& Layer = Layers[LayerIndex];
+	const int32 LayerNum = Layer.Num();
+
+	// Key: barycenter as a fraction of the neighbour layer, so that neighbours from layers of different sizes can be mixed
+	TArray<TPair<double, int32>> Barycenters;
+	Barycenters.Reserve(LayerNum);
+	for (int32 Index = 0; Index < LayerNum; Index++)
+	{
+		const int32 Vertex = Layer[Index];
+		const TArray<int32>& Neighbours = bUseParents ? Parents[Vertex] : Children[Vertex];
+
+		double Sum = 0.0;
+		for (const int32 Neighbour : Neighbours)
+		{
+			Sum += (VertexOrder[Neighbour] + 0.5) / Layers[VertexLayer[Neighbour]].Num();
+		}
+
+		// Vertices without neighbours keep their place
+		const double Barycenter = Neighbours.Num() > 0 ? Sum / Neighbours.Num() : (Index + 0.5) / LayerNum;
+		Barycenters.Emplace(Barycenter, Vertex);
+	}
+
+	Barycenters.StableSort([](const TPair<double, int32>& A, const TPair<double, int32>& B)
+	{
+		return A.Key < B.Key;
+	});
+	for (int32 Index = 0; Index < LayerNum; Index++)
+	{
+		Layer[Index] = Barycenters[Index].Value;
+	}
+	UpdateVertexOrder(LayerIndex);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgGraphLayout::UpdateVertexOrder(int32 LayerIndex)
+{
+	const TArray<int32>& Layer = Layers[LayerIndex];
+	for (int32 Index = 0, Num = Layer.Num(); Index < Num; Index++)
+	{
+		VertexOrder[Layer[Index]] = Index;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FDlgGraphLayout::CountCrossings() const
+{
+	// For each pair of consecutive layers sort the edges by the order of the parent then count the inversions
+	// of the children order with a Fenwick tree, O(E log V)
+	int32 Crossings = 0;
+	TArray<TPair<int32, int32>> Edges;
+	TArray<int32> Tree;
+	for (int32 LayerIndex = 0; LayerIndex + 1 < Layers.Num(); LayerIndex++)
+	{
+		Edges.Reset();
+		for (const int32 Vertex : Layers[LayerIndex])
+		{
+			for (const int32 ChildVertex : Children[Vertex])
+			{
+				if (VertexLayer[ChildVertex] == LayerIndex + 1)
+				{
+					Edges.Emplace(VertexOrder[Vertex], VertexOrder[ChildVertex]);
+				}
+			}
+		}
+		Edges.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+		{
+			return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+		});
+
+		const int32 TreeSize = Layers[LayerIndex + 1].Num();
+		Tree.Reset();
+		Tree.SetNumZeroed(TreeSize + 1);
+		for (int32 Inserted = 0; Inserted < Edges.Num(); Inserted++)
+		{
+			// Number of already inserted edges that end at or before this child
+			const int32 ChildOrder = Edges[Inserted].Value;
+			int32 NotCrossing = 0;
+			for (int32 Index = ChildOrder + 1; Index > 0; Index -= Index & -Index)
+			{
+				NotCrossing += Tree[Index];
+			}
+			Crossings += Inserted - NotCrossing;
+
+			for (int32 Index = ChildOrder + 1; Index <= TreeSize; Index += Index & -Index)
+			{
+				Tree[Index]++;
+			}
+		}
+	}
+
+	return Crossings;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgGraphLayout::AssignCoordinates(const FDlgGraphLayoutSettings& Settings)
+{
+	const bool bIsDirectionVertical = Settings.bIsDirectionVertical;
+	const int32 NumVertices = Sizes.Num();
+
+	// Center of each vertex along its layer
+	TArray<double> Centers;
+	Centers.Init(0.0, NumVertices);
+	TArray<int32> LayerOffsets;
+	LayerOffsets.Init(0, Layers.Num());
+
+	int32 LayerOffset = 0;
+	double MinCoordinate = TNumericLimits<double>::Max();
+	for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); LayerIndex++)
+	{
+		const TArray<int32>& Layer = Layers[LayerIndex];
+
+		// Place each vertex at the barycenter of its parents (already placed) but never overlapping the previous one
+		double PreviousEnd = 0.0;
+		double ShiftSum = 0.0;
+		int32 ShiftNum = 0;
+		for (int32 Index = 0; Index < Layer.Num(); Index++)
+		{
+			const int32 Vertex = Layer[Index];
+			const double HalfSize = GetSizeInsideLayer(Vertex, bIsDirectionVertical) / 2.0;
+			const double MinCenter = Index == 0 ? -TNumericLimits<double>::Max() : PreviousEnd + Settings.GapInsideLayer + HalfSize;
+
+			double Center = Index == 0 ? HalfSize : MinCenter;
+			if (Parents[Vertex].Num() > 0)
+			{
+				double Desired = 0.0;
+				for (const int32 ParentVertex : Parents[Vertex])
+				{
+					Desired += Centers[ParentVertex];
+				}
+				Desired /= Parents[Vertex].Num();
+
+				Center = FMath::Max(Desired, MinCenter);
+				ShiftSum += Desired - Center;
+				ShiftNum++;
+			}
+
+			Centers[Vertex] = Center;
+			PreviousEnd = Center + HalfSize;
+		}
+
+		// Pushing apart only goes one way, shift the whole layer back so that on average the vertices sit under their parents
+		const double Shift = ShiftNum > 0 ? ShiftSum / ShiftNum : 0.0;
+		int32 LayerThickness = 0;
+		for (const int32 Vertex : Layer)
+		{
+			Centers[Vertex] += Shift;
+			MinCoordinate = FMath::Min(MinCoordinate, Centers[Vertex] - GetSizeInsideLayer(Vertex, bIsDirectionVertical) / 2.0);
+			LayerThickness = FMath::Max(LayerThickness, GetSizeAcrossLayer(Vertex, bIsDirectionVertical));
+		}
+
+		LayerOffsets[LayerIndex] = LayerOffset;
+		LayerOffset += LayerThickness + Settings.GapBetweenLayers;
+	}
+
+	// Move everything so that the layout starts at 0
+	Positions.SetNumUninitialized(NumVertices);
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		const int32 Along = FMath::RoundToInt(Centers[Vertex] - GetSizeInsideLayer(Vertex, bIsDirectionVertical) / 2.0 - MinCoordinate);
+		const int32 Across = LayerOffsets[VertexLayer[Vertex]];
+		Positions[Vertex] = bIsDirectionVertical ? FIntPoint(Along, Across) : FIntPoint(Across, Along);
+	}
+}
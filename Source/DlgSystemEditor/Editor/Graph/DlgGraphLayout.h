@@ -0,0 +1,116 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FDlgGraphLayoutSettings
+{
+	// The minimum gap between two nodes on the same layer, in the direction of the layer
+	int32 GapInsideLayer = 0;
+
+	// The gap between two consecutive layers
+	int32 GapBetweenLayers = 0;
+
+	// If true the layers are rows (the graph flows down), otherwise the layers are columns (the graph flows right)
+	bool bIsDirectionVertical = true;
+
+	// How many down + up barycenter sweeps we try, the order with the fewest crossings is kept
+	int32 CrossingMinimizationSweeps = 4;
+};
+
+struct FDlgGraphLayoutStats
+{
+	int32 NumVertices = 0;
+	int32 NumEdges = 0;
+	int32 NumLayers = 0;
+
+	// Edges that were reversed to make the graph acyclic
+	int32 NumReversedEdges = 0;
+
+	// Crossings between the edges of consecutive layers, before and after the crossing minimization
+	int32 NumCrossingsInitial = 0;
+	int32 NumCrossings = 0;
+
+	double Milliseconds = 0.0;
+
+	FString ToString() const
+	{
+		return FString::Printf(
+			TEXT("Vertices = %d, Edges = %d (Reversed = %d), Layers = %d, Crossings = %d -> %d, Time = %.2f ms"),
+			NumVertices, NumEdges, NumReversedEdges, NumLayers, NumCrossingsInitial, NumCrossings, Milliseconds
+		);
+	}
+};
+
+/**
+ * Layered (Sugiyama style) layout of a directed graph, knows nothing about the dialogue graph nodes.
+ *
+ * Steps:
+ * 1. Cycle removal, the back edges of a DFS from the vertices (in the order they were added) are reversed.
+ * 2. Layer assignment, longest path from the sources so that every edge points to a later layer.
+ * 3. Crossing minimization, barycenter sweeps down and up over the layers, keeps the best order found.
+ * 4. Coordinate assignment, each vertex is placed at the barycenter of its parents then the overlaps are pushed apart.
+ *
+ * Every step is O(V + E) besides the sorting inside the layers, so thousands of vertices are laid out interactively.
+ * Edges that span more than one layer do not get dummy vertices, they only pull on the barycenters.
+ */
+class DLGSYSTEMEDITOR_API FDlgGraphLayout
+{
+public:
+	/**
+	 * Adds a vertex, the vertices added first are preferred as sources (add the roots first).
+	 * @param Size	Size of the vertex, X is the width and Y the height
+	 * @return the index of the vertex
+	 */
+	int32 AddVertex(const FIntPoint& Size);
+
+	/** Adds an edge between two vertices. Self loops and duplicate edges are ignored. */
+	void AddEdge(int32 FromVertex, int32 ToVertex);
+
+	/** Computes the positions of all the vertices. */
+	FDlgGraphLayoutStats Compute(const FDlgGraphLayoutSettings& Settings);
+
+	/** The top left position of the vertex, relative to the top left of the layout. Only valid after Compute. */
+	FIntPoint GetVertexPosition(int32 Vertex) const { return Positions[Vertex]; }
+
+	int32 NumVertices() const { return Sizes.Num(); }
+
+private:
+	void RemoveCycles(FDlgGraphLayoutStats& Stats);
+	void AssignLayers();
+	void MinimizeCrossings(const FDlgGraphLayoutSettings& Settings, FDlgGraphLayoutStats& Stats);
+	void AssignCoordinates(const FDlgGraphLayoutSettings& Settings);
+
+	// Reorders the layer by the barycenter of the neighbours from the Parents (down sweep) or Children (up sweep)
+	void SortLayerByBarycenter(int32 LayerIndex, bool bUseParents);
+
+	// Sets VertexOrder from the Layers
+	void UpdateVertexOrder(int32 LayerIndex);
+
+	// Number of crossings between the edges of consecutive layers
+	int32 CountCrossings() const;
+
+	// Size of the vertex along the layer (width for vertical layouts) and across it
+	int32 GetSizeInsideLayer(int32 Vertex, bool bIsDirectionVertical) const { return bIsDirectionVertical ? Sizes[Vertex].X : Sizes[Vertex].Y; }
+	int32 GetSizeAcrossLayer(int32 Vertex, bool bIsDirectionVertical) const { return bIsDirectionVertical ? Sizes[Vertex].Y : Sizes[Vertex].X; }
+
+private:
+	TArray<FIntPoint> Sizes;
+
+	// The edges as added
+	TArray<TArray<int32>> OutEdges;
+
+	// The acyclic edges, after RemoveCycles
+	TArray<TArray<int32>> Children;
+	TArray<TArray<int32>> Parents;
+
+	// The layer of each vertex and the vertices on each layer, in order
+	TArray<int32> VertexLayer;
+	TArray<TArray<int32>> Layers;
+
+	// The position of each vertex inside its layer
+	TArray<int32> VertexOrder;
+
+	// Result
+	TArray<FIntPoint> Positions;
+};
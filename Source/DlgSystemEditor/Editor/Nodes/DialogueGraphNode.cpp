@@ -5,6 +5,7 @@
 #include "Framework/Commands/GenericCommands.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Engine/Font.h"
+#include "SGraphNode.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "Runtime/Launch/Resources/Version.h"
 
@@ -231,6 +232,7 @@ void UDialogueGraphNode::GetNodeContextMenuActions(UToolMenu* Menu, UGraphNodeCo
 		{
 			Section.AddMenuEntry(FDlgCommands::Get().ConvertSpeechNodesToSpeechSequence);
 		}
+		Section.AddMenuEntry(FDlgCommands::Get().AutoPositionSelectedNodes);
 
 		Section.AddMenuEntry(FGenericCommands::Get().Delete);
 //		Section.AddMenuEntry(FGenericCommands::Get().Cut);
@@ -259,6 +261,7 @@ void UDialogueGraphNode::GetContextMenuActions(const FGraphNodeContextMenuBuilde
 			{
 				Context.MenuBuilder->AddMenuEntry(FDlgCommands::Get().ConvertSpeechNodesToSpeechSequence);
 			}
+			Context.MenuBuilder->AddMenuEntry(FDlgCommands::Get().AutoPositionSelectedNodes);
 
 			Context.MenuBuilder->AddMenuEntry(FGenericCommands::Get().Delete);
 //			Context.MenuBuilder->AddMenuEntry(FGenericCommands::Get().Cut);
@@ -605,6 +608,66 @@ int32 UDialogueGraphNode::EstimateNodeWidth() const
 	return Result;
 }
 
+int32 UDialogueGraphNode::EstimateNodeHeight() const
+{
+	constexpr int32 EstimatedCharWidth = 6;
+	constexpr int32 EstimatedLineHeight = 16;
+	// Title, speaker, pins and the margins around the description
+	constexpr int32 EstimatedFixedHeight = 64;
+
+	const UDlgSystemSettings* Settings = GetDefault<UDlgSystemSettings>();
+	const UFont* Font = GetDefault<UEditorEngine>()->EditorFont;
+	const int32 LineHeight = Font ? FMath::Max(EstimatedLineHeight, FMath::CeilToInt(Font->GetMaxCharHeight())) : EstimatedLineHeight;
+
+	// Each speech sequence entry is drawn with its own speaker and description
+	TArray<FString> Descriptions;
+	int32 Height = EstimatedFixedHeight;
+	if (IsSpeechSequenceNode())
+	{
+		for (const FDlgSpeechSequenceEntry& Entry : GetDialogueNode<UDlgNode_SpeechSequence>().GetNodeSpeechSequence())
+		{
+			Descriptions.Add(Entry.GetNodeUnformattedText().ToString());
+			Height += LineHeight;
+		}
+	}
+	else
+	{
+		Descriptions.Add(DialogueNode->GetNodeUnformattedText().ToString());
+	}
+
+	// The description wraps at DescriptionWrapTextAt
+	for (const FString& Description : Descriptions)
+	{
+		TArray<FString> Lines;
+		Description.ParseIntoArrayLines(Lines, false);
+		for (const FString& Line : Lines)
+		{
+			const int32 LineWidth = Font ? Font->GetStringSize(*Line) : Line.Len() * EstimatedCharWidth;
+			const int32 NumWrappedLines = Settings->DescriptionWrapTextAt > 0.f
+				? FMath::Max(1, FMath::CeilToInt(LineWidth / Settings->DescriptionWrapTextAt))
+				: 1;
+			Height += NumWrappedLines * LineHeight;
+		}
+	}
+
+	return Height;
+}
+
+FIntPoint UDialogueGraphNode::GetNodeSize() const
+{
+	if (const TSharedPtr<SGraphNode> NodeWidget = GetNodeWidget())
+	{
+		const FVector2D DesiredSize = NodeWidget->GetDesiredSize();
+		if (DesiredSize.X > 0.f && DesiredSize.Y > 0.f)
+		{
+			return FIntPoint(FMath::CeilToInt(DesiredSize.X), FMath::CeilToInt(DesiredSize.Y));
+		}
+	}
+
+	// Not drawn yet (e.g. a graph that was never opened)
+	return FIntPoint(EstimateNodeWidth(), EstimateNodeHeight());
+}
+
 void UDialogueGraphNode::CheckDialogueNodeIndexMatchesNode() const
 {
 #if DO_CHECK
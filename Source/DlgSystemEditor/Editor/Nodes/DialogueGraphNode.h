@@ -335,6 +335,12 @@ public:
 	/** Estimate the width of this Node from the length of its content */
 	int32 EstimateNodeWidth() const;
 
+	/** Estimate the height of this Node from the number of lines of its wrapped description */
+	int32 EstimateNodeHeight() const;
+
+	/** The size of the widget of this Node if it was drawn already, otherwise the estimated size */
+	FIntPoint GetNodeSize() const;
+
 	/** Checks Dialogue.Nodes[NodeIndex] == DialogueNode */
 	void CheckDialogueNodeIndexMatchesNode() const;
 
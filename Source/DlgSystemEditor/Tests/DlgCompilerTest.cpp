@@ -0,0 +1,57 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/Nodes/DlgNode_End.h"
+#include "DlgSystem/Nodes/DlgNode_Proxy.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/Tests/DlgRuntimeBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgCompilerProxyTargetMovedTest,
+	"DlgSystemEditor.Compiler.ProxyTargetMoved",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgCompilerProxyTargetMovedTest::RunTest(const FString& Parameters)
+{
+	// Start -> 0 -> 3 -> (1, 2), the proxy 2 jumps to the end node 1.
+	// The compile walks the graph breadth first so the end node moves after node 3 and the proxy target is remapped.
+	// With an isolated node the graph has an orphan and the full compile runs, otherwise the incremental one does.
+	for (const bool bWithIsolatedNode : {false, true})
+	{
+		FDlgTestDialogueBuilder Builder;
+		Builder.AddNode(UDlgNode_Speech::StaticClass(), {3});
+		const int32 OldEndIndex = Builder.AddNode(UDlgNode_End::StaticClass());
+		const int32 ProxyIndex = Builder.AddNode(UDlgNode_Proxy::StaticClass(), {OldEndIndex});
+		Builder.AddNode(UDlgNode_Speech::StaticClass(), {ProxyIndex, OldEndIndex});
+		if (bWithIsolatedNode)
+		{
+			Builder.AddNode(UDlgNode_End::StaticClass());
+		}
+		UDlgNode_Proxy* Proxy = CastChecked<UDlgNode_Proxy>(Builder.GetNode(ProxyIndex));
+		UDlgNode* EndNode = Builder.GetNode(OldEndIndex);
+		UDlgDialogue* Dialogue = Builder.Finish();
+
+		// Recreate the graph from the dialogue nodes, then go back from the graph to the dialogue
+		Dialogue->ClearGraph();
+		Dialogue->CompileDialogueNodesFromGraphNodes();
+
+		const FString Prefix = bWithIsolatedNode ? TEXT("Full compile: ") : TEXT("Incremental compile: ");
+		const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
+		const int32 NewEndIndex = Nodes.IndexOfByKey(EndNode);
+		const int32 NewProxyIndex = Nodes.IndexOfByKey(Proxy);
+		TestNotEqual(Prefix + TEXT("The end node moved"), NewEndIndex, OldEndIndex);
+		TestEqual(Prefix + TEXT("The proxy target is remapped"), Proxy->GetTargetNodeIndex(), NewEndIndex);
+		TestEqual(Prefix + TEXT("The resolved index follows the remapped target"), Dialogue->GetResolvedNodeIndex(NewProxyIndex), NewEndIndex);
+		TestTrue(Prefix + TEXT("The proxy leads to the end node"), Dialogue->LeadsToEndNode(NewProxyIndex));
+		TestEqual(Prefix + TEXT("The proxy chain is collapsed again"), Proxy->GetJumpNodeIndex(), NewEndIndex);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,135 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgSystemEditor/Editor/Graph/DlgGraphLayout.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgGraphLayoutLayersTest,
+	"DlgSystemEditor.GraphLayout.Layers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgGraphLayoutLayersTest::RunTest(const FString& Parameters)
+{
+	// 0 -> 1 -> 2 and 0 -> 2, the longest path puts 2 on the third layer
+	FDlgGraphLayout Layout;
+	const int32 Tall = Layout.AddVertex(FIntPoint(200, 300));
+	const int32 Middle = Layout.AddVertex(FIntPoint(200, 50));
+	const int32 Last = Layout.AddVertex(FIntPoint(100, 40));
+	Layout.AddEdge(Tall, Middle);
+	Layout.AddEdge(Middle, Last);
+	Layout.AddEdge(Tall, Last);
+
+	FDlgGraphLayoutSettings Settings;
+	Settings.GapInsideLayer = 20;
+	Settings.GapBetweenLayers = 50;
+
+	Settings.bIsDirectionVertical = true;
+	FDlgGraphLayoutStats Stats = Layout.Compute(Settings);
+	TestEqual(TEXT("Layers"), Stats.NumLayers, 3);
+	TestEqual(TEXT("Nothing reversed"), Stats.NumReversedEdges, 0);
+	TestEqual(TEXT("First layer starts at the top"), Layout.GetVertexPosition(Tall).Y, 0);
+	TestEqual(TEXT("Second layer is below the height of the tall vertex"), Layout.GetVertexPosition(Middle).Y, 300 + 50);
+	TestEqual(TEXT("Third layer is below the second"), Layout.GetVertexPosition(Last).Y, 300 + 50 + 50 + 50);
+
+	Settings.bIsDirectionVertical = false;
+	Stats = Layout.Compute(Settings);
+	TestEqual(TEXT("Horizontal layers"), Stats.NumLayers, 3);
+	TestEqual(TEXT("Second column is right of the width of the first"), Layout.GetVertexPosition(Middle).X, 200 + 50);
+	TestEqual(TEXT("Third column is right of the second"), Layout.GetVertexPosition(Last).X, 200 + 50 + 200 + 50);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgGraphLayoutCyclesTest,
+	"DlgSystemEditor.GraphLayout.Cycles",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgGraphLayoutCyclesTest::RunTest(const FString& Parameters)
+{
+	// 0 -> 1 -> 2 -> 0, the edge back to the first vertex is reversed
+	FDlgGraphLayout Layout;
+	const FIntPoint Size(100, 100);
+	for (int32 Vertex = 0; Vertex < 3; Vertex++)
+	{
+		Layout.AddVertex(Size);
+	}
+	Layout.AddEdge(0, 1);
+	Layout.AddEdge(1, 2);
+	Layout.AddEdge(2, 0);
+
+	// Self loops are ignored
+	Layout.AddEdge(1, 1);
+
+	FDlgGraphLayoutSettings Settings;
+	Settings.GapBetweenLayers = 10;
+	const FDlgGraphLayoutStats Stats = Layout.Compute(Settings);
+	TestEqual(TEXT("Edges"), Stats.NumEdges, 3);
+	TestEqual(TEXT("Reversed edges"), Stats.NumReversedEdges, 1);
+	TestEqual(TEXT("Layers"), Stats.NumLayers, 3);
+	TestTrue(
+		TEXT("The cycle is laid out in order"),
+		Layout.GetVertexPosition(0).Y < Layout.GetVertexPosition(1).Y && Layout.GetVertexPosition(1).Y < Layout.GetVertexPosition(2).Y
+	);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgGraphLayoutCrossingsTest,
+	"DlgSystemEditor.GraphLayout.Crossings",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+bool FDlgGraphLayoutCrossingsTest::RunTest(const FString& Parameters)
+{
+	// A -> X, B -> Y, B -> X. X is only ready after B in the topological order so it starts right of Y, crossing A -> X
+	FDlgGraphLayout Layout;
+	const FIntPoint Size(100, 60);
+	const int32 A = Layout.AddVertex(Size);
+	const int32 B = Layout.AddVertex(Size);
+	const int32 X = Layout.AddVertex(Size);
+	const int32 Y = Layout.AddVertex(Size);
+	Layout.AddEdge(A, X);
+	Layout.AddEdge(B, Y);
+	Layout.AddEdge(B, X);
+
+	FDlgGraphLayoutSettings Settings;
+	Settings.GapInsideLayer = 20;
+	Settings.GapBetweenLayers = 50;
+	const FDlgGraphLayoutStats Stats = Layout.Compute(Settings);
+	TestEqual(TEXT("Initial crossings"), Stats.NumCrossingsInitial, 1);
+	TestEqual(TEXT("Crossings after the minimization"), Stats.NumCrossings, 0);
+	TestTrue(TEXT("X is left of Y"), Layout.GetVertexPosition(X).X < Layout.GetVertexPosition(Y).X);
+	TestTrue(
+		TEXT("Vertices of a layer do not overlap"),
+		Layout.GetVertexPosition(Y).X - Layout.GetVertexPosition(X).X >= Size.X + Settings.GapInsideLayer
+		&& Layout.GetVertexPosition(B).X - Layout.GetVertexPosition(A).X >= Size.X + Settings.GapInsideLayer
+	);
+
+	// The minimization never keeps a worse order
+	FRandomStream Random(7);
+	FDlgGraphLayout RandomLayout;
+	static constexpr int32 NumVertices = 200;
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		RandomLayout.AddVertex(FIntPoint(Random.RandRange(50, 300), Random.RandRange(40, 200)));
+	}
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		for (int32 Edge = 0; Edge < 3; Edge++)
+		{
+			RandomLayout.AddEdge(Vertex, Random.RandHelper(NumVertices));
+		}
+	}
+	const FDlgGraphLayoutStats RandomStats = RandomLayout.Compute(Settings);
+	TestTrue(TEXT("Random graph crossings do not increase"), RandomStats.NumCrossings <= RandomStats.NumCrossingsInitial);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS